@@ -47,6 +47,7 @@
 #include "demo_temperature.h"
 #include "demo_ping.h"
 #include "peripherals.h"
+#include "flash_writer.h"
 #include "demo_iperf.h"
 #include "main.h"
 
@@ -149,6 +150,40 @@ static void rest_ep_get_configs(struct restfs_file* fil)
     restfs_write(fil, (const uint8_t *)cgi_buffer, strlen(cgi_buffer));
 }
 
+/**
+ * Stream source for the live JPEG image. The response holds a reference to the frame, so the
+ * camera captures into another buffer while it is being sent and no locking is needed here.
+ *
+ * @param arg    Frame being sent.
+ * @param offset Offset into the image.
+ * @param buffer Buffer to copy the image data into.
+ * @param count  Maximum number of bytes to copy.
+ * @returns Number of bytes copied.
+ */
+static int rest_stream_live_jpeg(void *arg, uint32_t offset, char *buffer, int count)
+{
+    const struct periphs_jpeg_frame *frame = (const struct periphs_jpeg_frame *)arg;
+    uint32_t len;
+
+    len = frame->size - offset;
+    if (len > (uint32_t)count)
+    {
+        len = count;
+    }
+    memcpy(buffer, frame->data + offset, len);
+    return len;
+}
+
+/**
+ * Release the frame once the live JPEG image response has been closed.
+ *
+ * @param arg    Frame that was being sent.
+ */
+static void rest_stream_live_jpeg_close(void *arg)
+{
+    periphs_jpeg_frame_put((const struct periphs_jpeg_frame *)arg);
+}
+
 /**
  * Get the content of JPEG image
  *
@@ -156,17 +191,73 @@ static void rest_ep_get_configs(struct restfs_file* fil)
  */
 static void rest_ep_get_image(struct restfs_file* fil)
 {
-    if(!periphs_jpeg_buffer_lock())
+    const struct periphs_jpeg_frame *frame = periphs_jpeg_frame_get();
+
+    if (frame == NULL)
     {
         rest_ep_failed(fil);
         return;
     }
-    if(!periphs_get_live_jpeg_size())
+    if (!frame->size)
     {
-        periphs_jpeg_buffer_unlock();
+        periphs_jpeg_frame_put(frame);
+        rest_ep_failed(fil);
         return;
     }
-    restfs_write_const(fil, (const char*)periphs_get_jpeg_buffer(), (uint16_t)periphs_get_live_jpeg_size());
+    if (restfs_stream(fil, rest_stream_live_jpeg, rest_stream_live_jpeg_close,
+                      (void *)frame, frame->size) != ERR_OK)
+    {
+        periphs_jpeg_frame_put(frame);
+        rest_ep_failed(fil);
+    }
+}
+
+/**
+ * Get the camera capture pipeline statistics in a json string.
+ *
+ * @param fil   File to write to.
+ */
+static void rest_ep_get_camera_stats(struct restfs_file* fil)
+{
+    struct periphs_camera_stats stats;
+    uint32_t avg_latency_ms = 0;
+
+    periphs_get_camera_stats(&stats);
+    if (stats.frames_sent)
+    {
+        avg_latency_ms = (uint32_t)(stats.total_latency_ms / stats.frames_sent);
+    }
+
+    restfs_alloc_buffer(fil, sizeof(cgi_buffer));
+    snprintf(cgi_buffer, sizeof(cgi_buffer),
+             "{"
+             "\"frames_captured\":%lu,"
+             "\"frames_dropped\":%lu,"
+             "\"captures_skipped\":%lu,"
+             "\"frames_sent\":%lu,"
+             "\"last_latency_ms\":%lu,"
+             "\"avg_latency_ms\":%lu,"
+             "\"max_latency_ms\":%lu"
+             "}",
+             stats.frames_captured, stats.frames_dropped, stats.captures_skipped,
+             stats.frames_sent, stats.last_latency_ms, avg_latency_ms, stats.max_latency_ms);
+    restfs_write(fil, (const uint8_t *)cgi_buffer, strlen(cgi_buffer));
+}
+
+/**
+ * Stream source for the JPEG image saved in the QSPI flash. The flash is only locked while each
+ * block is copied; if the image is erased or its slot is reused for a newer image part way
+ * through a response, the response is aborted.
+ *
+ * @param arg    Identifier of the saved image being sent.
+ * @param offset Offset into the image.
+ * @param buffer Buffer to copy the image data into.
+ * @param count  Maximum number of bytes to copy.
+ * @returns Number of bytes copied, or -1 if the image is no longer available.
+ */
+static int rest_stream_saved_image(void *arg, uint32_t offset, char *buffer, int count)
+{
+    return flash_writer_read_image((uint32_t)(uintptr_t)arg, offset, buffer, count);
 }
 
 /**
@@ -176,22 +267,18 @@ static void rest_ep_get_image(struct restfs_file* fil)
  */
 static void rest_ep_get_saved_image(struct restfs_file *fil)
 {
+    struct flash_writer_image image;
 
-    if (!periphs_qspi_flash_lock())
+    if (!flash_writer_get_image(&image))
     {
         rest_ep_failed(fil);
         return;
     }
-    /* If we can acquire the lock, it means that the QSPI flash is not being written and it's in
-     * memory mapped mode. So, no need to check memory mapped before accessing it.*/
-    if (!SAVED_IMAGE_DATA_SIZE || !(SAVED_IMAGE_DATA_SIZE < (64 * 1024 - 4)))
+    if (restfs_stream(fil, rest_stream_saved_image, NULL, (void *)(uintptr_t)image.id,
+                      image.size) != ERR_OK)
     {
-        periphs_qspi_flash_unlock();
         rest_ep_failed(fil);
-        return;
     }
-    restfs_write_const(fil, (const char *)(OCTOSPI1_BASE + sizeof(uint32_t)),
-                       (uint16_t)SAVED_IMAGE_DATA_SIZE);
 }
 
 /**
@@ -413,6 +500,7 @@ static const struct rest_endpoint rest_endpoints[] = {
     {"failed.html", rest_ep_failed},
     {"/api/get_image", rest_ep_get_image},
     {"/api/get_saved_image", rest_ep_get_saved_image},
+    {"/api/get_camera_stats", rest_ep_get_camera_stats},
     {"/api/get_status", rest_ep_get_status},
     {"/api/get_configs", rest_ep_get_configs},
     {"/api/toggle_leds", rest_ep_toggle_leds},
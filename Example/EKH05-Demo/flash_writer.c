@@ -0,0 +1,540 @@
+/*
+ * Copyright 2025 Morse Micro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Background writer for the QSPI flash.
+ *
+ * The flash can only be read through the memory-mapped window while it is not being erased or
+ * programmed. Rather than holding the flash for a whole image, the writer task works in short
+ * batches (one sector erase, or up to FLASH_WRITER_PAGES_PER_BATCH page programs) and re-enters
+ * memory-mapped mode and releases the flash lock between batches, so readers are only ever held
+ * off for a single batch.
+ *
+ * Images are stored in two slots. A new image is written into the slot that does not hold the
+ * latest image and its header is programmed last, so the latest complete image stays readable
+ * until the new one has been committed. When there are no requests pending, the writer erases
+ * the inactive slot a sector at a time so that the next save only has to program pages.
+ */
+
+#include "flash_writer.h"
+#include "mmosal.h"
+#include "mmutils.h"
+#include <stdio.h>
+#include <string.h>
+#include "main.h"
+#include "w25q16jv.h"
+
+#define FLASH_WRITER_NUM_SLOTS          (2)
+#define FLASH_WRITER_SECTOR_SIZE        (4 * 1024)
+#define FLASH_WRITER_PAGE_SIZE          (256)
+#define FLASH_WRITER_SECTORS_PER_SLOT   (FLASH_WRITER_SLOT_SIZE / FLASH_WRITER_SECTOR_SIZE)
+#define FLASH_WRITER_SLOT_ADDR(_slot)   ((uint32_t)(_slot) * FLASH_WRITER_SLOT_SIZE)
+
+/* Maximum number of pages to program before giving readers access to the flash again */
+#ifndef FLASH_WRITER_PAGES_PER_BATCH
+#define FLASH_WRITER_PAGES_PER_BATCH    (8)
+#endif
+
+/* Maximum number of queued requests */
+#ifndef FLASH_WRITER_QUEUE_LENGTH
+#define FLASH_WRITER_QUEUE_LENGTH       (4)
+#endif
+
+/* Delay between erase-ahead operations, so that readers are not starved */
+#define FLASH_WRITER_ERASE_AHEAD_INTERVAL_MS    (20)
+#define FLASH_WRITER_LOCK_TIMEOUT_MS            (500)
+
+#define FLASH_IMAGE_MAGIC               (0x3147504a) /* "JPG1" */
+
+/** Header stored at the start of each image slot */
+struct flash_image_header
+{
+    uint32_t magic;
+    /** Identifier of the image, incremented for each image saved */
+    uint32_t id;
+    /** Size of the image data that follows the header */
+    uint32_t size;
+    /** Bitwise inverse of @c size */
+    uint32_t size_check;
+};
+
+MM_STATIC_ASSERT(sizeof(struct flash_image_header) == FLASH_WRITER_HEADER_SIZE,
+                 "FLASH_WRITER_HEADER_SIZE does not match the header");
+MM_STATIC_ASSERT(FLASH_WRITER_SECTORS_PER_SLOT <= 32, "Too many sectors per slot");
+
+enum flash_writer_request_type
+{
+    FLASH_WRITER_REQ_SAVE_IMAGE,
+    FLASH_WRITER_REQ_ERASE_IMAGE,
+};
+
+struct flash_writer_request
+{
+    enum flash_writer_request_type type;
+    const uint8_t *data;
+    uint32_t size;
+    flash_writer_cb_t cb;
+    void *arg;
+};
+
+/** Cached state of an image slot. Only modified by the writer task, with the flash locked. */
+struct flash_writer_slot
+{
+    /** Whether the slot holds a complete image */
+    bool valid;
+    uint32_t id;
+    uint32_t size;
+    /** Bitmap of the sectors of the slot that are known to be erased */
+    uint32_t erased_sectors;
+};
+
+static struct
+{
+    /* Held while the flash is out of memory-mapped mode, and while accessing the slots */
+    struct mmosal_semb *lock;
+    struct mmosal_queue *queue;
+    struct mmosal_task *task;
+    struct flash_writer_slot slots[FLASH_WRITER_NUM_SLOTS];
+    /* Slot holding the latest image, or -1 if there is none */
+    int active_slot;
+    uint32_t next_id;
+} flash_writer;
+
+extern OSPI_HandleTypeDef hospi1;
+
+static bool flash_writer_lock(void)
+{
+    return mmosal_semb_wait(flash_writer.lock, FLASH_WRITER_LOCK_TIMEOUT_MS);
+}
+
+static void flash_writer_unlock(void)
+{
+    mmosal_semb_give(flash_writer.lock);
+}
+
+static bool flash_writer_enable_memory_mapped(void)
+{
+    if (QSPI_EnableMemoryMappedMode(&hospi1) == HAL_OK)
+    {
+        return true;
+    }
+    /* Reset the flash and try again */
+    if (QSPI_Init(&hospi1) != HAL_OK)
+    {
+        printf("QSPI init failed\n");
+        return false;
+    }
+    if (QSPI_EnableMemoryMappedMode(&hospi1) != HAL_OK)
+    {
+        printf("QSPI map failed\n");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Lock the flash and leave memory-mapped mode so that it can be erased or programmed.
+ * Must be followed by @c flash_writer_end() if successful.
+ */
+static bool flash_writer_begin(void)
+{
+    if (!flash_writer_lock())
+    {
+        printf("Unable to lock QSPI flash.\n");
+        return false;
+    }
+    if (HAL_OSPI_Abort(&hospi1) != HAL_OK)
+    {
+        printf("unable to disable QSPI memory-mapping.\n");
+        flash_writer_unlock();
+        return false;
+    }
+    return true;
+}
+
+static void flash_writer_end(void)
+{
+    flash_writer_enable_memory_mapped();
+    flash_writer_unlock();
+}
+
+static bool flash_writer_program(uint32_t address, const void *data, uint32_t length)
+{
+    return (QSPI_WriteEnable(&hospi1) == HAL_OK) &&
+           (QSPI_ProgramPage(&hospi1, address, (uint8_t *)data, length) == HAL_OK);
+}
+
+/* Must only be called from the writer task while the flash is in memory-mapped mode */
+static bool flash_writer_sector_is_blank(int slot, uint32_t sector)
+{
+    const uint32_t *p = (const uint32_t *)(OCTOSPI1_BASE + FLASH_WRITER_SLOT_ADDR(slot) +
+                                           sector * FLASH_WRITER_SECTOR_SIZE);
+
+    for (uint32_t i = 0; i < FLASH_WRITER_SECTOR_SIZE / sizeof(*p); i++)
+    {
+        if (p[i] != UINT32_MAX)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool flash_writer_erase_sector(int slot, uint32_t sector)
+{
+    struct flash_writer_slot *s = &flash_writer.slots[slot];
+    bool ok;
+
+    if (!flash_writer_begin())
+    {
+        return false;
+    }
+    /* Any image in the slot is lost as soon as the erase starts */
+    s->valid = false;
+    if (flash_writer.active_slot == slot)
+    {
+        flash_writer.active_slot = -1;
+    }
+    ok = (QSPI_WriteEnable(&hospi1) == HAL_OK) &&
+         (QSPI_EraseSector(&hospi1, FLASH_WRITER_SLOT_ADDR(slot) +
+                                    sector * FLASH_WRITER_SECTOR_SIZE) == HAL_OK);
+    if (ok)
+    {
+        s->erased_sectors |= (1ul << sector);
+    }
+    flash_writer_end();
+
+    if (!ok)
+    {
+        printf("QSPI_EraseSector failed.\n");
+    }
+    return ok;
+}
+
+/** Make sure that a sector is erased, erasing it only if it is not already blank. */
+static bool flash_writer_prepare_sector(int slot, uint32_t sector)
+{
+    struct flash_writer_slot *s = &flash_writer.slots[slot];
+
+    if (s->erased_sectors & (1ul << sector))
+    {
+        return true;
+    }
+    if (flash_writer_sector_is_blank(slot, sector))
+    {
+        s->erased_sectors |= (1ul << sector);
+        return true;
+    }
+    return flash_writer_erase_sector(slot, sector);
+}
+
+static bool flash_writer_do_save_image(const struct flash_writer_request *req)
+{
+    int slot = (flash_writer.active_slot + 1) % FLASH_WRITER_NUM_SLOTS;
+    struct flash_writer_slot *s = &flash_writer.slots[slot];
+    uint32_t base = FLASH_WRITER_SLOT_ADDR(slot);
+    struct flash_image_header header;
+    uint32_t offset = 0;
+    uint32_t prepared_sector = UINT32_MAX;
+    bool ok = true;
+
+    /* The slot may hold the previous image, which is about to be overwritten */
+    if (!flash_writer_lock())
+    {
+        return false;
+    }
+    s->valid = false;
+    flash_writer_unlock();
+
+    while (ok && (offset < req->size))
+    {
+        uint32_t sector = (FLASH_WRITER_HEADER_SIZE + offset) / FLASH_WRITER_SECTOR_SIZE;
+
+        /* Erase each sector before its first page is programmed */
+        if (sector != prepared_sector)
+        {
+            if (!flash_writer_prepare_sector(slot, sector))
+            {
+                return false;
+            }
+            prepared_sector = sector;
+        }
+        if (!flash_writer_begin())
+        {
+            return false;
+        }
+        s->erased_sectors &= ~(1ul << sector);
+
+        /* Program a batch of pages, stopping at the end of the sector so that the next sector
+         * can be erased if necessary. */
+        for (int i = 0; i < FLASH_WRITER_PAGES_PER_BATCH && offset < req->size; i++)
+        {
+            uint32_t slot_offset = FLASH_WRITER_HEADER_SIZE + offset;
+            uint32_t len = FLASH_WRITER_PAGE_SIZE - (slot_offset % FLASH_WRITER_PAGE_SIZE);
+
+            if ((slot_offset / FLASH_WRITER_SECTOR_SIZE) != sector)
+            {
+                break;
+            }
+            len = MM_MIN(len, req->size - offset);
+            if (!flash_writer_program(base + slot_offset, req->data + offset, len))
+            {
+                printf("QSPI_ProgramPage failed.\n");
+                ok = false;
+                break;
+            }
+            offset += len;
+        }
+        flash_writer_end();
+    }
+    if (!ok)
+    {
+        return false;
+    }
+
+    /* Commit the image by programming its header */
+    header.magic = FLASH_IMAGE_MAGIC;
+    header.id = flash_writer.next_id;
+    header.size = req->size;
+    header.size_check = ~req->size;
+    if (!flash_writer_begin())
+    {
+        return false;
+    }
+    ok = flash_writer_program(base, &header, sizeof(header));
+    if (ok)
+    {
+        s->valid = true;
+        s->id = header.id;
+        s->size = header.size;
+        flash_writer.active_slot = slot;
+        flash_writer.next_id++;
+    }
+    flash_writer_end();
+
+    return ok;
+}
+
+static bool flash_writer_do_erase_image(void)
+{
+    bool ok = true;
+
+    /* Erasing the sector holding the header is enough to invalidate an image. The rest of the
+     * slot is erased in the background. */
+    for (int slot = 0; slot < FLASH_WRITER_NUM_SLOTS; slot++)
+    {
+        if (flash_writer.slots[slot].valid && !flash_writer_erase_sector(slot, 0))
+        {
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+/**
+ * Erase the next sector of an inactive slot that is not known to be erased.
+ *
+ * @returns @c true if there may be more sectors to erase, else @c false.
+ */
+static bool flash_writer_erase_ahead(void)
+{
+    for (int slot = 0; slot < FLASH_WRITER_NUM_SLOTS; slot++)
+    {
+        uint32_t erased = flash_writer.slots[slot].erased_sectors;
+
+        if (slot == flash_writer.active_slot)
+        {
+            continue;
+        }
+        for (uint32_t sector = 0; sector < FLASH_WRITER_SECTORS_PER_SLOT; sector++)
+        {
+            if (!(erased & (1ul << sector)))
+            {
+                return flash_writer_prepare_sector(slot, sector);
+            }
+        }
+    }
+    return false;
+}
+
+static void flash_writer_task(void *arg)
+{
+    struct flash_writer_request req;
+    uint32_t timeout_ms = 0;
+
+    MM_UNUSED(arg);
+
+    while (1)
+    {
+        if (!mmosal_queue_pop(flash_writer.queue, &req, timeout_ms))
+        {
+            timeout_ms = flash_writer_erase_ahead() ?
+                FLASH_WRITER_ERASE_AHEAD_INTERVAL_MS : UINT32_MAX;
+            continue;
+        }
+
+        bool ok = false;
+        switch (req.type)
+        {
+        case FLASH_WRITER_REQ_SAVE_IMAGE:
+            ok = flash_writer_do_save_image(&req);
+            break;
+
+        case FLASH_WRITER_REQ_ERASE_IMAGE:
+            ok = flash_writer_do_erase_image();
+            break;
+        }
+        if (req.cb != NULL)
+        {
+            req.cb(ok, req.arg);
+        }
+        timeout_ms = FLASH_WRITER_ERASE_AHEAD_INTERVAL_MS;
+    }
+}
+
+/** Find the saved images, if any, from the slot headers. */
+static void flash_writer_scan_slots(void)
+{
+    flash_writer.active_slot = -1;
+    flash_writer.next_id = 0;
+
+    for (int slot = 0; slot < FLASH_WRITER_NUM_SLOTS; slot++)
+    {
+        const struct flash_image_header *header =
+            (const struct flash_image_header *)(OCTOSPI1_BASE + FLASH_WRITER_SLOT_ADDR(slot));
+        struct flash_writer_slot *s = &flash_writer.slots[slot];
+
+        if ((header->magic != FLASH_IMAGE_MAGIC) || (header->size_check != ~header->size) ||
+            (header->size == 0) || (header->size > FLASH_WRITER_MAX_IMAGE_SIZE))
+        {
+            continue;
+        }
+        s->valid = true;
+        s->id = header->id;
+        s->size = header->size;
+        if ((flash_writer.active_slot < 0) ||
+            ((int32_t)(s->id - flash_writer.slots[flash_writer.active_slot].id) > 0))
+        {
+            flash_writer.active_slot = slot;
+            flash_writer.next_id = s->id + 1;
+        }
+    }
+}
+
+void flash_writer_init(void)
+{
+    MMOSAL_ASSERT(flash_writer.lock == NULL);
+    flash_writer.lock = mmosal_semb_create("QSPI_flash_lock");
+    flash_writer.queue = mmosal_queue_create(FLASH_WRITER_QUEUE_LENGTH,
+                                             sizeof(struct flash_writer_request),
+                                             "flash_writer");
+    MMOSAL_ASSERT(flash_writer.lock != NULL && flash_writer.queue != NULL);
+
+    if (QSPI_Init(&hospi1) != HAL_OK)
+    {
+        printf("QSPI init failed\n");
+        return;
+    }
+    if (QSPI_EnableMemoryMappedMode(&hospi1) != HAL_OK)
+    {
+        printf("QSPI map failed\n");
+        return;
+    }
+    flash_writer_scan_slots();
+    /* Give the semaphore, so it can be taken */
+    flash_writer_unlock();
+
+    flash_writer.task = mmosal_task_create(flash_writer_task, NULL, MMOSAL_TASK_PRI_LOW, 512,
+                                           "flash_writer");
+    if (flash_writer.task == NULL)
+    {
+        printf("Unable to start flash writer task\n");
+    }
+}
+
+static bool flash_writer_queue_request(const struct flash_writer_request *req)
+{
+    if (flash_writer.task == NULL)
+    {
+        return false;
+    }
+    return mmosal_queue_push(flash_writer.queue, req, 0);
+}
+
+bool flash_writer_save_image(const uint8_t *data, uint32_t size, flash_writer_cb_t cb, void *arg)
+{
+    struct flash_writer_request req = {
+        .type = FLASH_WRITER_REQ_SAVE_IMAGE,
+        .data = data,
+        .size = size,
+        .cb = cb,
+        .arg = arg,
+    };
+
+    if ((size == 0) || (size > FLASH_WRITER_MAX_IMAGE_SIZE))
+    {
+        return false;
+    }
+    return flash_writer_queue_request(&req);
+}
+
+bool flash_writer_erase_image(flash_writer_cb_t cb, void *arg)
+{
+    struct flash_writer_request req = {
+        .type = FLASH_WRITER_REQ_ERASE_IMAGE,
+        .cb = cb,
+        .arg = arg,
+    };
+
+    return flash_writer_queue_request(&req);
+}
+
+bool flash_writer_get_image(struct flash_writer_image *image)
+{
+    bool found = false;
+
+    if ((flash_writer.lock == NULL) || !flash_writer_lock())
+    {
+        return false;
+    }
+    if (flash_writer.active_slot >= 0)
+    {
+        image->id = flash_writer.slots[flash_writer.active_slot].id;
+        image->size = flash_writer.slots[flash_writer.active_slot].size;
+        found = true;
+    }
+    flash_writer_unlock();
+
+    return found;
+}
+
+int flash_writer_read_image(uint32_t id, uint32_t offset, void *buffer, uint32_t length)
+{
+    int ret = -1;
+
+    if ((flash_writer.lock == NULL) || !flash_writer_lock())
+    {
+        return -1;
+    }
+    /* The previous image can still be read until its slot is reused */
+    for (int slot = 0; slot < FLASH_WRITER_NUM_SLOTS; slot++)
+    {
+        const struct flash_writer_slot *s = &flash_writer.slots[slot];
+
+        if (s->valid && (s->id == id) && (offset <= s->size))
+        {
+            uint32_t len = MM_MIN(length, s->size - offset);
+
+            memcpy(buffer, (const uint8_t *)(OCTOSPI1_BASE + FLASH_WRITER_SLOT_ADDR(slot) +
+                                             FLASH_WRITER_HEADER_SIZE + offset), len);
+            ret = len;
+            break;
+        }
+    }
+    flash_writer_unlock();
+
+    return ret;
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2025 Morse Micro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef FLASH_WRITER_H
+#define FLASH_WRITER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Size of each image slot in the QSPI flash */
+#define FLASH_WRITER_SLOT_SIZE       (64 * 1024)
+/** Size of the header at the start of each image slot */
+#define FLASH_WRITER_HEADER_SIZE     (16)
+/** Maximum size of an image that can be saved */
+#define FLASH_WRITER_MAX_IMAGE_SIZE  (FLASH_WRITER_SLOT_SIZE - FLASH_WRITER_HEADER_SIZE)
+
+/**
+ * Function type for request completion callbacks. Called from the flash writer task.
+ *
+ * @param success   @c true if the request completed successfully, else @c false.
+ * @param arg       Opaque argument, as passed in with the request.
+ */
+typedef void (*flash_writer_cb_t)(bool success, void *arg);
+
+/** A saved image */
+struct flash_writer_image
+{
+    /** Identifier of the image, used to read it with @c flash_writer_read_image() */
+    uint32_t id;
+    /** Size of the image */
+    uint32_t size;
+};
+
+/**
+ * Initialize the QSPI flash, enable memory-mapped mode and start the flash writer task.
+ * The OCTOSPI peripheral must have been initialized.
+ */
+void flash_writer_init(void);
+
+/**
+ * Queue an image to be saved to the flash. The image replaces the current saved image once it
+ * has been completely written; until then the current image remains readable.
+ *
+ * @param data  Image data. Must remain valid until @p cb has been called.
+ * @param size  Size of the image, at most @c FLASH_WRITER_MAX_IMAGE_SIZE.
+ * @param cb    Callback to invoke when the image has been written (may be @c NULL).
+ * @param arg   Opaque argument for @p cb.
+ *
+ * @returns @c true if the request was queued (in which case @p cb will be called), else @c false.
+ */
+bool flash_writer_save_image(const uint8_t *data, uint32_t size, flash_writer_cb_t cb, void *arg);
+
+/**
+ * Queue the erasure of the saved images.
+ *
+ * @param cb    Callback to invoke when the images have been erased (may be @c NULL).
+ * @param arg   Opaque argument for @p cb.
+ *
+ * @returns @c true if the request was queued (in which case @p cb will be called), else @c false.
+ */
+bool flash_writer_erase_image(flash_writer_cb_t cb, void *arg);
+
+/**
+ * Get the most recently saved image.
+ *
+ * @param image Structure to receive the image details.
+ *
+ * @returns @c true if there is a saved image, else @c false.
+ */
+bool flash_writer_get_image(struct flash_writer_image *image);
+
+/**
+ * Read part of a saved image. The flash is only locked for the duration of the copy.
+ *
+ * @param id        Identifier of the image, from @c flash_writer_get_image().
+ * @param offset    Offset into the image.
+ * @param buffer    Buffer to copy the image data into.
+ * @param length    Maximum number of bytes to copy.
+ *
+ * @returns Number of bytes copied, or -1 if the image has been erased or overwritten.
+ */
+int flash_writer_read_image(uint32_t id, uint32_t offset, void *buffer, uint32_t length);
+
+#endif /* FLASH_WRITER_H */
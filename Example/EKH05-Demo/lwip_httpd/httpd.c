@@ -107,6 +107,9 @@
 #if LWIP_HTTPD_TIMING
 #include "lwip/sys.h"
 #endif /* LWIP_HTTPD_TIMING */
+#if LWIP_HTTPD_CUSTOM_FILES
+#include "restfs.h" /* FS_FILE_FLAGS_CHUNKED */
+#endif /* LWIP_HTTPD_CUSTOM_FILES */
 
 #include <string.h> /* memset */
 #include <stdlib.h> /* atoi */
@@ -129,7 +132,6 @@
 #define HTTP_IS_DYNAMIC_FILE(hs) 0
 #endif
 
-void http_file_sent(const void *end_address);
 
 /* This defines checks whether tcp_write has to copy data or not */
 
@@ -953,6 +955,23 @@ get_http_content_length(struct http_state *hs)
 
   LWIP_ASSERT("already been here?", hs->hdrs[HDR_STRINGS_IDX_CONTENT_LEN_KEEPALIVE] == NULL);
 
+#ifdef FS_FILE_FLAGS_CHUNKED
+  if ((hs->handle != NULL) && (hs->handle->flags & FS_FILE_FLAGS_CHUNKED)) {
+    /* length not known in advance: the chunked transfer coding requires a HTTP/1.1 response */
+    if (hs->hdrs[HDR_STRINGS_IDX_HTTP_STATUS] == g_psHTTPHeaderStrings[HTTP_HDR_OK]) {
+      hs->hdrs[HDR_STRINGS_IDX_HTTP_STATUS] = g_psHTTPHeaderStrings[HTTP_HDR_OK_11];
+    }
+#if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
+    if (hs->keepalive) {
+      hs->hdrs[HDR_STRINGS_IDX_CONTENT_LEN_KEEPALIVE] = g_psHTTPHeaderStrings[HTTP_HDR_KEEPALIVE_CHUNKED];
+      return;
+    }
+#endif /* LWIP_HTTPD_SUPPORT_11_KEEPALIVE */
+    hs->hdrs[HDR_STRINGS_IDX_CONTENT_LEN_KEEPALIVE] = g_psHTTPHeaderStrings[HTTP_HDR_CLOSE_CHUNKED];
+    return;
+  }
+#endif /* FS_FILE_FLAGS_CHUNKED */
+
   add_content_len = 0;
 #if LWIP_HTTPD_SSI
   if (hs->ssi == NULL) /* @todo: get maximum file length from SSI */
@@ -1641,7 +1660,6 @@ http_send(struct altcp_pcb *pcb, struct http_state *hs)
     /* We reached the end of the file so this request is done.
      * This adds the FIN flag right into the last data segment. */
     LWIP_DEBUGF(HTTPD_DEBUG, ("End of file.\n"));
-    http_file_sent((const void *)hs->file);
     http_eof(pcb, hs);
     return 0;
   }
@@ -27,7 +27,9 @@ static const char *const g_psHTTPHeaderStrings[] = {
   "Connection: keep-alive\r\n",
   "Connection: keep-alive\r\nContent-Length: ",
   "Server: "HTTPD_SERVER_AGENT"\r\n",
-  "\r\n<html><body><h2>404: The requested file cannot be found.</h2></body></html>\r\n"
+  "\r\n<html><body><h2>404: The requested file cannot be found.</h2></body></html>\r\n",
+  "Connection: Close\r\nTransfer-Encoding: chunked\r\n",
+  "Connection: keep-alive\r\nTransfer-Encoding: chunked\r\n"
 #if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
   , "Connection: keep-alive\r\nContent-Length: 77\r\n\r\n<html><body><h2>404: The requested file cannot be found.</h2></body></html>\r\n"
 #endif
@@ -48,8 +50,10 @@ static const char *const g_psHTTPHeaderStrings[] = {
 #define HTTP_HDR_KEEPALIVE_LEN  11 /* Connection: keep-alive + Content-Length: (HTTP 1.1)*/
 #define HTTP_HDR_SERVER         12 /* Server: HTTPD_SERVER_AGENT */
 #define DEFAULT_404_HTML        13 /* default 404 body */
+#define HTTP_HDR_CLOSE_CHUNKED  14 /* Connection: Close + Transfer-Encoding: chunked (HTTP 1.1) */
+#define HTTP_HDR_KEEPALIVE_CHUNKED 15 /* Connection: keep-alive + Transfer-Encoding: chunked (HTTP 1.1) */
 #if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
-#define DEFAULT_404_HTML_PERSISTENT 14 /* default 404 body, but including Connection: keep-alive */
+#define DEFAULT_404_HTML_PERSISTENT 16 /* default 404 body, but including Connection: keep-alive */
 #endif
 
 #define HTTP_CONTENT_TYPE(contenttype) "Content-Type: "contenttype"\r\n\r\n"
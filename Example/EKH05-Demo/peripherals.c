@@ -17,21 +17,46 @@
 #include "ekh05_camera.h"
 #include "gatt_db.h"
 #include "bluenrg1_gap_aci.h"
-#include "w25q16jv.h"
+#include "flash_writer.h"
+
+/* Number of JPEG capture buffers. The camera captures into a buffer that is neither the latest
+ * frame nor being sent, so with 3 buffers capture continues while up to one older frame is
+ * still being sent. */
+#ifndef JPEG_NUM_CAPTURE_BUFFERS
+#define JPEG_NUM_CAPTURE_BUFFERS (3)
+#endif
+
+/** A JPEG capture buffer */
+struct jpeg_capture_buffer
+{
+    /** Public description of the frame held in this buffer. Must be the first member. */
+    struct periphs_jpeg_frame frame;
+    /** Number of references obtained with periphs_jpeg_frame_get() */
+    uint8_t refs;
+    /** Set once the frame has been handed out for sending */
+    bool sent;
+    /** Frame data, written by DCMI DMA */
+    uint8_t data[JPEG_BUFFER_SIZE] __attribute__((aligned(4)));
+};
+
+static struct jpeg_capture_buffer jpeg_buffers[JPEG_NUM_CAPTURE_BUFFERS];
+/* Protects the buffer references against capture buffer selection. The capture complete interrupt
+ * only writes to the buffer being captured and then publishes it as the latest frame. */
+static struct mmosal_mutex *jpeg_buffers_lock = NULL;
+/* Index of the buffer being filled by DMA, or -1 if no capture is in progress */
+static volatile int jpeg_capture_idx = -1;
+/* Index of the most recently captured frame, or -1 if no frame has been captured */
+static volatile int jpeg_latest_idx = -1;
+static uint32_t jpeg_next_seq = 1;
+static struct periphs_camera_stats camera_stats;
 
-static struct mmosal_semb *JPEG_buffer_lock = NULL;
-static struct mmosal_semb *QSPI_flash_lock = NULL;
 struct mmosal_task *periphs_task_p;
 static uint8_t got_sof = 0; /*got Start Of Frame*/
-uint32_t image_data_size = 0;
-uint8_t *image_data_ptr = NULL;
-uint8_t JPEG_buffer[JPEG_BUFFER_SIZE];
 
 extern TIM_HandleTypeDef htim4;
 extern OSPI_HandleTypeDef hospi1;
 extern __IO uint16_t connection_handle;
 
-#define SAVED_IMAGE_DATA_SIZE *(uint32_t*)OCTOSPI1_BASE
 #define ERASE_IMAGE_BOTTUN_WAIT_SECONDS(x) (x * 2)
 
 enum mmhal_deep_sleep_veto_id
@@ -39,264 +64,196 @@ enum mmhal_deep_sleep_veto_id
     MMHAL_VETO_ID_APP_CAMERA = MMHAL_VETO_ID_APP_MIN,
 };
 
-const uint8_t *periphs_get_jpeg_buffer(void) { return JPEG_buffer; }
-uint32_t periphs_get_live_jpeg_size(void) { return image_data_size; }
-
 bool periphs_qspi_is_memmap_running (void){
     return HAL_OSPI_GetState(&hospi1) == HAL_OSPI_STATE_BUSY_MEM_MAPPED;
 }
 
-bool periphs_jpeg_buffer_lock(void)
+const struct periphs_jpeg_frame *periphs_jpeg_frame_get(void)
 {
-    if (JPEG_buffer_lock != NULL)
+    struct jpeg_capture_buffer *buf = NULL;
+    int idx;
+
+    if (jpeg_buffers_lock == NULL)
     {
-        return mmosal_semb_wait(JPEG_buffer_lock, JPEG_BUFFER_TIMEOUT_MS);
+        return NULL;
     }
-    return false;
-}
 
-void periphs_jpeg_buffer_unlock(void)
-{
-    if (JPEG_buffer_lock != NULL)
+    mmosal_mutex_get(jpeg_buffers_lock, UINT32_MAX);
+    idx = jpeg_latest_idx;
+    if (idx >= 0)
     {
-        mmosal_semb_give(JPEG_buffer_lock);
+        buf = &jpeg_buffers[idx];
+        buf->refs++;
+        if (!buf->sent)
+        {
+            uint32_t latency_ms = HAL_GetTick() - buf->frame.capture_time_ms;
+
+            buf->sent = true;
+            camera_stats.frames_sent++;
+            camera_stats.last_latency_ms = latency_ms;
+            camera_stats.total_latency_ms += latency_ms;
+            if (latency_ms > camera_stats.max_latency_ms)
+            {
+                camera_stats.max_latency_ms = latency_ms;
+            }
+        }
     }
+    mmosal_mutex_release(jpeg_buffers_lock);
+
+    return (buf != NULL) ? &buf->frame : NULL;
 }
 
-bool periphs_qspi_flash_lock(void)
+void periphs_jpeg_frame_put(const struct periphs_jpeg_frame *frame)
 {
-    if (QSPI_flash_lock != NULL)
-    {
-        return mmosal_semb_wait(QSPI_flash_lock, JPEG_BUFFER_TIMEOUT_MS);
-    }
-    return false;
+    struct jpeg_capture_buffer *buf = (struct jpeg_capture_buffer *)frame;
+
+    MMOSAL_ASSERT(buf >= jpeg_buffers && buf < jpeg_buffers + JPEG_NUM_CAPTURE_BUFFERS);
+
+    mmosal_mutex_get(jpeg_buffers_lock, UINT32_MAX);
+    MMOSAL_ASSERT(buf->refs > 0);
+    buf->refs--;
+    mmosal_mutex_release(jpeg_buffers_lock);
 }
 
-void periphs_qspi_flash_unlock(void)
+void periphs_get_camera_stats(struct periphs_camera_stats *stats)
 {
-    if (QSPI_flash_lock != NULL)
-    {
-        mmosal_semb_give(QSPI_flash_lock);
-    }
+    mmosal_mutex_get(jpeg_buffers_lock, UINT32_MAX);
+    *stats = camera_stats;
+    mmosal_mutex_release(jpeg_buffers_lock);
 }
 
-void http_file_sent(const void *end_address)
+/**
+ * Start capturing a frame, unless a capture is already in progress. The frame is captured into
+ * the least recently captured buffer that is not the latest frame and is not being sent, so the
+ * oldest frame is dropped if it was never sent.
+ */
+static void jpeg_capture_start(void)
 {
-    /*if the end_address is the jpeg image end, then unlock the jpeg buffer.*/
-    if ((uint8_t *)end_address == (JPEG_buffer + image_data_size))
+    struct jpeg_capture_buffer *target = NULL;
+    int target_idx = -1;
+
+    if (jpeg_capture_idx >= 0)
     {
-        periphs_jpeg_buffer_unlock();
         return;
     }
-    /* don't check the address if the memory mapped isn't on-going.*/
-    if (periphs_qspi_is_memmap_running())
+
+    mmosal_mutex_get(jpeg_buffers_lock, UINT32_MAX);
+    for (int i = 0; i < JPEG_NUM_CAPTURE_BUFFERS; i++)
     {
-        if ((uint8_t *)end_address == ((uint8_t *)OCTOSPI1_BASE + sizeof(uint32_t) + SAVED_IMAGE_DATA_SIZE))
+        struct jpeg_capture_buffer *buf = &jpeg_buffers[i];
+
+        if ((i == jpeg_latest_idx) || (buf->refs > 0))
+        {
+            continue;
+        }
+        if ((target == NULL) || (buf->frame.seq < target->frame.seq))
         {
-            periphs_qspi_flash_unlock();
-            return;
+            target = buf;
+            target_idx = i;
         }
     }
-}
 
-static void flash_image_cleanup(bool lock_jpeg_buff)
-{
-    if (QSPI_Init(&hospi1) != HAL_OK)
+    if (target == NULL)
     {
-        printf("QSPI init failed\n");
+        camera_stats.captures_skipped++;
+        mmosal_mutex_release(jpeg_buffers_lock);
+        return;
     }
-    else
+
+    if ((target->frame.size != 0) && !target->sent)
     {
-        if (QSPI_EnableMemoryMappedMode(&hospi1) != HAL_OK)
-        {
-            printf("QSPI map failed\n");
-        }
+        camera_stats.frames_dropped++;
     }
+    target->frame.size = 0;
+    jpeg_capture_idx = target_idx;
+    mmosal_mutex_release(jpeg_buffers_lock);
+
+    BSP_CAMERA_Start(0, target->data, DCMI_MODE_SNAPSHOT);
+}
+
+static void erase_image_done(bool success, void *arg)
+{
+    MM_UNUSED(arg);
+    printf("%s\n", success ? "Saved image erased." : "Failed to erase saved image.");
     htim4.Instance->CCR1 = 0;
     htim4.Instance->CCR2 = 0;
     htim4.Instance->CCR3 = 0;
-    if(lock_jpeg_buff)
-    {
-        periphs_jpeg_buffer_unlock();
-    }
-    periphs_qspi_flash_unlock();
 }
 
 static void erase_image(void)
 {
-    /*lock the image semaphores*/
-    if (!periphs_qspi_flash_lock())
-    {
-        printf("periphs_qspi_flash_lock failed.\n");
-        return;
-    }
-    /*Turn the RGB LED blue*/
+    /*Turn the RGB LED blue until the flash writer has erased the image*/
     htim4.Instance->CCR1 = 0;
     htim4.Instance->CCR2 = 0;
     htim4.Instance->CCR3 = 1000;
 
-    /*disable the memory-mapped mode of the QSPI flash*/
-    if(HAL_OSPI_Abort(&hospi1) != HAL_OK)
+    if (!flash_writer_erase_image(erase_image_done, NULL))
     {
-        printf("unable to disable QSPI memory-mapping.\n");
-        periphs_qspi_flash_unlock();
-        return;
-    }
-    /*erase the part of flash that the image is going to sit*/
-    if (QSPI_WriteEnable(&hospi1) != HAL_OK)
-    {
-        /*Since we have the same fail message multiple places, we're using the number in the bracket
-         * to know which one has failed.*/
-        printf("[0] QSPI_WriteEnable failed.\n");
-        flash_image_cleanup(false);
-        return;
+        erase_image_done(false, NULL);
     }
+}
 
-    if (QSPI_BlockSectorErase(&hospi1, 0) != HAL_OK)
-    {
-        printf("QSPI_EraseSector failed.\n");
-        flash_image_cleanup(false);
-        return;
-    }
-    mmosal_task_sleep(800);
+static void save_image_done(bool success, void *arg)
+{
+    /*the image has been written (or has failed to be), so the frame can be released*/
+    periphs_jpeg_frame_put((const struct periphs_jpeg_frame *)arg);
+    printf("%s\n", success ? "Image saved." : "Failed to save image.");
     htim4.Instance->CCR1 = 0;
     htim4.Instance->CCR2 = 0;
     htim4.Instance->CCR3 = 0;
-    flash_image_cleanup(false);
 }
 
 static void save_image(void)
 {
-    uint8_t *data_to_write;
-    uint32_t remaining_bytes;
-    /*check if there's an image and not too big or small*/
-    if ((image_data_size < 256) || (image_data_size > 65532) || image_data_ptr == NULL)
+    /*take a reference to the latest frame, so it is not overwritten while it is being saved*/
+    const struct periphs_jpeg_frame *frame = periphs_jpeg_frame_get();
+    if (frame == NULL)
     {
         printf("No image!\n");
         return;
     }
-    /*lock the image semaphores*/
-    if (!periphs_jpeg_buffer_lock())
+    /*check if the image is not too big or small*/
+    if ((frame->size < 256) || (frame->size > FLASH_WRITER_MAX_IMAGE_SIZE))
     {
-        printf("periphs_jpeg_buffer_lock failed.\n");
-        return;
-    }
-    if (!periphs_qspi_flash_lock())
-    {
-        printf("periphs_qspi_flash_lock failed.\n");
-        periphs_jpeg_buffer_unlock();
+        printf("No image!\n");
+        periphs_jpeg_frame_put(frame);
         return;
     }
-    /*Turn the RGB LED white*/
+    /*Turn the RGB LED white until the flash writer has saved the image*/
     htim4.Instance->CCR1 = 1000;
     htim4.Instance->CCR2 = 1000;
     htim4.Instance->CCR3 = 1000;
 
-    /*disable the memory-mapped mode of the QSPI flash*/
-    if(HAL_OSPI_Abort(&hospi1) != HAL_OK)
-    {
-        printf("unable to disable QSPI memory-mapping.\n");
-        periphs_jpeg_buffer_unlock();
-        periphs_qspi_flash_unlock();
-        return;
-    }
-    /*erase the part of flash that the image is going to sit*/
-    if (QSPI_WriteEnable(&hospi1) != HAL_OK)
-    {
-        /*Since we have the same fail message multiple places, we're using the number in the bracket
-         * to know which one has failed.*/
-        printf("[0] QSPI_WriteEnable failed.\n");
-        flash_image_cleanup(true);
-        return;
-    }
-
-    if (QSPI_BlockSectorErase(&hospi1, 0) != HAL_OK)
-    {
-        printf("QSPI_EraseSector failed.\n");
-        flash_image_cleanup(true);
-        return;
-    }
-    /*Write the image size to the flash. We are going to save the image size in the very begining of
-     * flash, then will add the image data after.*/
-    if (QSPI_WriteEnable(&hospi1) != HAL_OK)
-    {
-        printf("[1] QSPI_WriteEnable failed.\n");
-    }
-    if (QSPI_ProgramPage(&hospi1, 0, (uint8_t *)&image_data_size, 4) != HAL_OK)
-    {
-        printf("[1] QSPI_ProgramPage failed.\n");
-    }
-    /*write the image buffer to the flash.*/
-    printf("Write %ld bytes from 0x%lx to external flash:", image_data_size,
-           (uint32_t)image_data_ptr);
-
-    data_to_write   = image_data_ptr;
-    remaining_bytes = (image_data_ptr + image_data_size) - data_to_write;
-
-    /* Write the first 256-4 bytes to first flash page. (we have to write data page by page. since
-     * we are using the first 4 bytes of the first page to store the size, we can cony write 256-4
-     * bytes to the first page.)*/
-    if (QSPI_WriteEnable(&hospi1) != HAL_OK)
-    {
-        printf("[2] QSPI_WriteEnable failed.\n");
-    }
-    if (QSPI_ProgramPage(&hospi1, sizeof(uint32_t), data_to_write, 256 - 4) != HAL_OK)
-    {
-        printf("[2] QSPI_ProgramPage failed.\n");
-    }
-    data_to_write += (256 - 4);
-    remaining_bytes = (image_data_ptr + image_data_size) - data_to_write;
-
-    while (remaining_bytes)
+    printf("Saving %ld bytes from 0x%lx to external flash.\n", frame->size,
+           (uint32_t)frame->data);
+    if (!flash_writer_save_image(frame->data, frame->size, save_image_done, (void *)frame))
     {
-        if (QSPI_WriteEnable(&hospi1) != HAL_OK)
-        {
-            printf("[3] QSPI_WriteEnable failed.\n");
-        }
-        if ((remaining_bytes) >= 256)
-        {
-            if (QSPI_ProgramPage(&hospi1,
-                                 sizeof(uint32_t) + (uint32_t)(data_to_write - image_data_ptr),
-                                 data_to_write, 256) != HAL_OK)
-            {
-                printf("[3] QSPI_ProgramPage failed.\n");
-                flash_image_cleanup(true);
-                return;
-            }
-            data_to_write += 256;
-            remaining_bytes -= 256;
-        }
-        else
-        {
-            if (QSPI_ProgramPage(&hospi1,
-                                 sizeof(uint32_t) + (uint32_t)(data_to_write - image_data_ptr),
-                                 data_to_write, remaining_bytes) != HAL_OK)
-            {
-                printf("[4] QSPI_ProgramPage failed.\n");
-                flash_image_cleanup(true);
-                return;
-            }
-            break;
-        }
-        printf(".");
+        printf("Flash writer busy.\n");
+        save_image_done(false, (void *)frame);
     }
-    printf("Finished successfully.\n");
-
-    /*enable memore-mapped mode*/
-    /*unlock the image semaphore.*/
-    flash_image_cleanup(true);
-
 }
 
 void BSP_CAMERA_VsyncEventCallback(uint32_t Instance)
 {
     if (got_sof)
     {
+        int idx = jpeg_capture_idx;
+
         BSP_CAMERA_Stop(Instance);
-        image_data_size = hdcmi.DMA_Handle->Instance->CDAR - (uint32_t)JPEG_buffer;
-        image_data_ptr = JPEG_buffer;
+        if (idx >= 0)
+        {
+            struct jpeg_capture_buffer *buf = &jpeg_buffers[idx];
+
+            buf->frame.size = hdcmi.DMA_Handle->Instance->CDAR - (uint32_t)buf->data;
+            buf->frame.seq = jpeg_next_seq++;
+            buf->frame.capture_time_ms = HAL_GetTick();
+            buf->sent = false;
+            camera_stats.frames_captured++;
+            /* Publish the frame only once it is complete */
+            jpeg_latest_idx = idx;
+            jpeg_capture_idx = -1;
+        }
         got_sof = 0;
-        mmosal_semb_give_from_isr(JPEG_buffer_lock);
     }
     else
     {
@@ -316,10 +273,7 @@ static void periphs_task(void *arg)
         if (counter++ == 40)
         {
             counter = 0;
-            if (mmosal_semb_wait(JPEG_buffer_lock, JPEG_BUFFER_TIMEOUT_MS))
-            {
-                BSP_CAMERA_Start(0, JPEG_buffer, DCMI_MODE_SNAPSHOT);
-            }
+            jpeg_capture_start();
             temperature_process();
         }
 
@@ -445,29 +399,19 @@ void periphs_start(void)
 {
     /* We don't want the host to sleep. If it does the RGB will flicker*/
     mmhal_set_deep_sleep_veto(MMHAL_VETO_ID_APP_CAMERA);
-    MMOSAL_ASSERT(JPEG_buffer_lock == NULL);
-    JPEG_buffer_lock = mmosal_semb_create("JPEG_buffer_lock");
-    MMOSAL_ASSERT(QSPI_flash_lock == NULL);
-    QSPI_flash_lock = mmosal_semb_create("QSPI_flash_lock");
-    /*give a free semaphore, so it can be taken.*/
-    periphs_qspi_flash_unlock();
+    MMOSAL_ASSERT(jpeg_buffers_lock == NULL);
+    jpeg_buffers_lock = mmosal_mutex_create("jpeg_buffers_lock");
+    MMOSAL_ASSERT(jpeg_buffers_lock != NULL);
+    for (int i = 0; i < JPEG_NUM_CAPTURE_BUFFERS; i++)
+    {
+        jpeg_buffers[i].frame.data = jpeg_buffers[i].data;
+    }
     /*Initialize the host peripherals for Demo example.*/
     MX_TIM4_Init();
     MX_I2C1_Init();
     MX_DCMI_Init();
     MX_OCTOSPI1_Init();
-
-    if (QSPI_Init(&hospi1) != HAL_OK)
-    {
-        printf("QSPI init failed\n");
-    }
-    else
-    {
-        if (QSPI_EnableMemoryMappedMode(&hospi1) != HAL_OK)
-        {
-            printf("QSPI map failed\n");
-        }
-    }
+    flash_writer_init();
     accelerometer_init();
     temperature_init();
     MX_BlueNRG_2_Init();
@@ -479,7 +423,7 @@ void periphs_start(void)
         printf("\n\nFailed to init camera.\n\n");
     }
     BSP_CAMERA_SetLightMode(0, CAMERA_LIGHT_HOME);
-    BSP_CAMERA_Start(0, JPEG_buffer, DCMI_MODE_SNAPSHOT);
+    jpeg_capture_start();
     printf("\n\nStarting Sensor Task\n\n");
     /* Read samples in polling mode (no int) */
 
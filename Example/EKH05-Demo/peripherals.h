@@ -10,17 +10,64 @@
 #include <stdint.h>
 #include <stdbool.h>
 
-#define SAVED_IMAGE_DATA_SIZE *(uint32_t *)OCTOSPI1_BASE
-
 void periphs_start(void);
 bool periphs_qspi_is_memmap_running(void);
-bool periphs_qspi_flash_lock(void);
-void periphs_qspi_flash_unlock(void);
-bool periphs_jpeg_buffer_lock(void);
-void periphs_jpeg_buffer_unlock(void);
 uint8_t periphs_toggle_leds(void);
-uint32_t periphs_get_live_jpeg_size(void);
-const uint8_t *periphs_get_jpeg_buffer(void);
+
+/** A captured JPEG frame */
+struct periphs_jpeg_frame
+{
+    /** JPEG data */
+    const uint8_t *data;
+    /** Length of the JPEG data */
+    uint32_t size;
+    /** Capture sequence number, incremented for every captured frame */
+    uint32_t seq;
+    /** Time at which the capture completed (HAL tick, in milliseconds) */
+    uint32_t capture_time_ms;
+};
+
+/** Camera capture pipeline statistics */
+struct periphs_camera_stats
+{
+    /** Number of frames captured */
+    uint32_t frames_captured;
+    /** Number of frames overwritten without having been sent */
+    uint32_t frames_dropped;
+    /** Number of captures skipped because every buffer was in use */
+    uint32_t captures_skipped;
+    /** Number of frames sent (a frame sent to several clients is counted once) */
+    uint32_t frames_sent;
+    /** Capture to send latency of the last frame sent, in milliseconds */
+    uint32_t last_latency_ms;
+    /** Maximum capture to send latency, in milliseconds */
+    uint32_t max_latency_ms;
+    /** Sum of the capture to send latencies of all frames sent, in milliseconds */
+    uint64_t total_latency_ms;
+};
+
+/**
+ * Get a reference to the most recently captured frame. The frame will not be overwritten by the
+ * camera until the reference is released with @c periphs_jpeg_frame_put().
+ *
+ * @returns The frame, or @c NULL if no frame has been captured yet.
+ */
+const struct periphs_jpeg_frame *periphs_jpeg_frame_get(void);
+
+/**
+ * Release a reference obtained with @c periphs_jpeg_frame_get().
+ *
+ * @param frame The frame to release.
+ */
+void periphs_jpeg_frame_put(const struct periphs_jpeg_frame *frame);
+
+/**
+ * Get a snapshot of the camera capture pipeline statistics.
+ *
+ * @param stats Structure to receive the statistics.
+ */
+void periphs_get_camera_stats(struct periphs_camera_stats *stats);
+
 void periphs_set_country_code(const char *country_code);
 
 #endif /* PERIPHERALS_H */
\ No newline at end of file
@@ -6,6 +6,7 @@
 
 #include "restfs.h"
 
+#include <limits.h>
 #include <stdarg.h>
 #include <string.h>
 
@@ -13,6 +14,18 @@
 #include "lwip/mem.h"
 
 #include "mmosal.h"
+#include "mmutils.h"
+
+#if !LWIP_HTTPD_DYNAMIC_FILE_READ
+#error "restfs requires LWIP_HTTPD_DYNAMIC_FILE_READ"
+#endif
+
+/** Length of a chunk header, "XXXX\r\n" */
+#define RESTFS_CHUNK_HEADER_LEN  6
+/** Length of the CRLF that terminates a chunk */
+#define RESTFS_CHUNK_TRAILER_LEN 2
+/** The last chunk, with an empty trailer */
+#define RESTFS_LAST_CHUNK        "0\r\n\r\n"
 
 /**
  * Opaque object used for writing REST output data.
@@ -22,6 +35,21 @@ struct restfs_file {
     struct fs_file *fs_file;
 };
 
+/**
+ * State of a streaming REST response, held in @c fs_file::pextension with @c fs_file::data
+ * left as @c NULL so that @c httpd reads the response through @c fs_read_custom().
+ */
+struct restfs_stream {
+    /** Callback to read the response data */
+    restfs_stream_read_t read_cb;
+    /** Callback invoked when the response is closed */
+    restfs_stream_close_t close_cb;
+    /** Opaque argument for the callbacks */
+    void *arg;
+    /** Offset of the next byte of response data */
+    uint32_t offset;
+};
+
 static const struct rest_endpoint *rest_endpoints;
 static uint16_t num_rest_endpoints = 0;
 
@@ -91,6 +119,50 @@ void restfs_write_const(struct restfs_file* rest_file, const char* str, uint16_t
     file->index = length;
 }
 
+int restfs_stream(struct restfs_file *rest_file, restfs_stream_read_t read_cb,
+                  restfs_stream_close_t close_cb, void *arg, uint32_t length)
+{
+    struct fs_file *file = rest_file->fs_file;
+    struct restfs_stream *stream;
+
+    MMOSAL_ASSERT((file->pextension == NULL) && (file->data == NULL) && (read_cb != NULL));
+
+    stream = (struct restfs_stream *)mem_malloc(sizeof(*stream));
+    if (stream == NULL)
+    {
+        return ERR_MEM;
+    }
+
+    stream->read_cb = read_cb;
+    stream->close_cb = close_cb;
+    stream->arg = arg;
+    stream->offset = 0;
+
+    if (length == RESTFS_STREAM_LENGTH_UNKNOWN)
+    {
+        /* The end of the response is marked by the last chunk instead. */
+        file->flags |= FS_FILE_FLAGS_CHUNKED;
+        file->len = INT_MAX;
+    }
+    else
+    {
+        MMOSAL_ASSERT(length <= INT_MAX);
+        file->len = (int)length;
+    }
+    file->index = 0;
+    file->pextension = stream;
+
+    return ERR_OK;
+}
+
+/**
+ * Check whether a file is a streaming REST response.
+ */
+static bool restfs_is_stream(struct fs_file *file)
+{
+    return (file->data == NULL) && (file->pextension != NULL);
+}
+
 char* restfs_claim_raw_buffer(struct restfs_file *rest_file)
 {
     struct fs_file *file = rest_file->fs_file;
@@ -128,7 +200,10 @@ int fs_open_custom(struct fs_file *file, const char *name)
 
             rest_endpoints[i].user_function(&rest_file);
 
-            file->len = file->index;
+            if (!restfs_is_stream(file))
+            {
+                file->len = file->index;
+            }
 
             /* Persistent header flag will force lwIP to add a content-length header */
             file->flags |= FS_FILE_FLAGS_HEADER_PERSISTENT;
@@ -143,16 +218,88 @@ void fs_close_custom(struct fs_file *file)
 {
     if (file && file->pextension)
     {
+        if (restfs_is_stream(file))
+        {
+            struct restfs_stream *stream = (struct restfs_stream *)file->pextension;
+
+            if (stream->close_cb != NULL)
+            {
+                stream->close_cb(stream->arg);
+            }
+        }
         mem_free(file->pextension);
         file->pextension = NULL;
     }
 }
 
+/**
+ * Write a fixed width chunk header for a chunk of @p len bytes.
+ */
+static void restfs_put_chunk_header(char *buffer, int len)
+{
+    static const char hex_digits[] = "0123456789abcdef";
+
+    buffer[0] = hex_digits[(len >> 12) & 0xf];
+    buffer[1] = hex_digits[(len >> 8) & 0xf];
+    buffer[2] = hex_digits[(len >> 4) & 0xf];
+    buffer[3] = hex_digits[len & 0xf];
+    buffer[4] = '\r';
+    buffer[5] = '\n';
+}
+
 int fs_read_custom(struct fs_file *file, char *buffer, int count)
 {
-    (void) (file);
-    (void) (buffer);
-    (void) (count);
-    /* Empty for now. */
-    return FS_READ_EOF;
+    struct restfs_stream *stream;
+    int ret;
+
+    if (!restfs_is_stream(file))
+    {
+        return FS_READ_EOF;
+    }
+    stream = (struct restfs_stream *)file->pextension;
+
+    if (!(file->flags & FS_FILE_FLAGS_CHUNKED))
+    {
+        ret = stream->read_cb(stream->arg, stream->offset, buffer,
+                              MM_MIN(count, fs_bytes_left(file)));
+        if (ret <= 0)
+        {
+            /* Source ended early; closing the connection short of Content-Length tells the
+             * client that the response is incomplete. */
+            return FS_READ_EOF;
+        }
+        stream->offset += ret;
+        file->index += ret;
+        return ret;
+    }
+
+    /* Read the data in place after the chunk header, leaving room for the trailing CRLF (and
+     * for the last chunk, should this read reach the end of the data). */
+    count = MM_MIN(count, 0xffff + RESTFS_CHUNK_HEADER_LEN + RESTFS_CHUNK_TRAILER_LEN);
+    if (count < RESTFS_CHUNK_HEADER_LEN + RESTFS_CHUNK_TRAILER_LEN + (int)strlen(RESTFS_LAST_CHUNK))
+    {
+        return FS_READ_EOF;
+    }
+
+    ret = stream->read_cb(stream->arg, stream->offset, buffer + RESTFS_CHUNK_HEADER_LEN,
+                          count - RESTFS_CHUNK_HEADER_LEN - RESTFS_CHUNK_TRAILER_LEN);
+    if (ret < 0)
+    {
+        /* Omitting the last chunk tells the client that the response is incomplete. */
+        return FS_READ_EOF;
+    }
+
+    if (ret == 0)
+    {
+        memcpy(buffer, RESTFS_LAST_CHUNK, strlen(RESTFS_LAST_CHUNK));
+        file->index = file->len;
+        return strlen(RESTFS_LAST_CHUNK);
+    }
+
+    restfs_put_chunk_header(buffer, ret);
+    buffer[RESTFS_CHUNK_HEADER_LEN + ret] = '\r';
+    buffer[RESTFS_CHUNK_HEADER_LEN + ret + 1] = '\n';
+    stream->offset += ret;
+
+    return RESTFS_CHUNK_HEADER_LEN + ret + RESTFS_CHUNK_TRAILER_LEN;
 }
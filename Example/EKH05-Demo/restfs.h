@@ -32,6 +32,41 @@ struct rest_endpoint {
     rest_endpoint_handler_t user_function;
 };
 
+/**
+ * Flag set in @c fs_file::flags for responses sent with the chunked transfer coding. This extends
+ * the lwIP @c FS_FILE_FLAGS_* and is handled by the local copy of @c httpd.
+ */
+#define FS_FILE_FLAGS_CHUNKED 0x20
+
+/**
+ * Length to pass to @c restfs_stream() when the length of the response is not known in advance.
+ * The response is then sent using the HTTP/1.1 chunked transfer coding.
+ */
+#define RESTFS_STREAM_LENGTH_UNKNOWN UINT32_MAX
+
+/**
+ * Function prototype of a streaming REST response source.
+ *
+ * Invoked from the lwIP @c httpd context each time the connection can accept more data, so any
+ * lock protecting the source only needs to be held for the duration of one call.
+ *
+ * @param arg    Opaque argument passed to @c restfs_stream()
+ * @param offset Offset of the requested data from the start of the response
+ * @param buffer Buffer to copy the data into
+ * @param count  Maximum number of bytes to copy
+ * @return Number of bytes copied, 0 at the end of the response, or a negative value to abort the
+ *         response
+ */
+typedef int (*restfs_stream_read_t)(void *arg, uint32_t offset, char *buffer, int count);
+
+/**
+ * Function prototype invoked when a streaming REST response is closed, whether or not it was
+ * sent completely.
+ *
+ * @param arg Opaque argument passed to @c restfs_stream()
+ */
+typedef void (*restfs_stream_close_t)(void *arg);
+
 /**
  * Allocate bytes for REST response
  * Must call this function BEFORE writing any data out.
@@ -57,6 +92,22 @@ int restfs_alloc_buffer(struct restfs_file *rest_file, uint16_t size);
  */
 void restfs_write_const(struct restfs_file *rest_file, const char* str, uint16_t length);
 
+/**
+ * Stream the REST response from a callback instead of a buffer. The data is read in blocks of
+ * the size that the connection can currently accept, so large responses are sent without being
+ * held in memory.
+ * This can NOT be used with any other @c restfs functions.
+ *
+ * @param rest_file - Opaque file object
+ * @param read_cb - Callback to read the response data
+ * @param close_cb - Callback invoked when the response is closed (may be @c NULL)
+ * @param arg - Opaque argument passed to @p read_cb and @p close_cb
+ * @param length - Length of the response, or @c RESTFS_STREAM_LENGTH_UNKNOWN
+ * @return @c ERR_OK if succeeded, @c ERR_MEM if failed
+ */
+int restfs_stream(struct restfs_file *rest_file, restfs_stream_read_t read_cb,
+                  restfs_stream_close_t close_cb, void *arg, uint32_t length);
+
 /**
  * Write data into REST response
  *
@@ -282,6 +282,7 @@ MQTTStatus_t CreateMQTTConnectionToBroker(MQTTContext_t *pxMQTTContext,
     memset(&xTransport, 0, sizeof(xTransport));
     xTransport.pNetworkContext = pxNetworkContext;
     xTransport.send = transport_send;
+    xTransport.writev = transport_writev;
     xTransport.recv = transport_recv;
 
     /* Initialize MQTT library. */
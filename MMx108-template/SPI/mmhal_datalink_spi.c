@@ -0,0 +1,43 @@
+/**
+ * Copyright 2025 Morse Micro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @file
+ * This File implements platform specific shims for accessing the SPI data-link transport.
+ */
+
+#include "mmhal_datalink_spi.h"
+#include "mmutils.h"
+
+__attribute__((weak)) void mmhal_datalink_spi_init(mmhal_datalink_spi_xfer_cb_t xfer_cb,
+                                                   void *xfer_cb_arg)
+{
+    MM_UNUSED(xfer_cb);
+    MM_UNUSED(xfer_cb_arg);
+}
+
+__attribute__((weak)) void mmhal_datalink_spi_deinit(void)
+{
+}
+
+__attribute__((weak)) bool mmhal_datalink_spi_arm(const uint8_t *tx_data,
+                                                  uint8_t *rx_data,
+                                                  size_t length)
+{
+    MM_UNUSED(tx_data);
+    MM_UNUSED(rx_data);
+    MM_UNUSED(length);
+    return false;
+}
+
+__attribute__((weak)) void mmhal_datalink_spi_set_ready(bool ready)
+{
+    MM_UNUSED(ready);
+}
+
+__attribute__((weak)) bool mmhal_datalink_spi_set_deep_sleep_mode(
+    enum mmhal_datalink_spi_deep_sleep_mode mode)
+{
+    MM_UNUSED(mode);
+    return false;
+}
@@ -53,6 +53,28 @@
 #define TRANSPORT_EXTERNAL_CTR_DRBG_ENABLED (0)
 #endif
 
+/**
+ * Number of TLS sessions kept in the RAM session cache for resumption. Each entry is keyed by
+ * server host name, port and credentials. Set to 0 to disable session resumption.
+ */
+#if !defined(TRANSPORT_SESSION_CACHE_SIZE)
+#if defined(MBEDTLS_SSL_CLI_C)
+#define TRANSPORT_SESSION_CACHE_SIZE (2)
+#else
+#define TRANSPORT_SESSION_CACHE_SIZE (0)
+#endif
+#endif
+
+/**
+ * Size of the buffer used by @ref transport_writev() to gather small vectors (e.g., an MQTT
+ * fixed header) together with the start of the following vector, so that they are sent in a
+ * single TLS record rather than one record each. Vectors at least this large are passed to
+ * mbedTLS directly from the caller's buffer.
+ */
+#if !defined(TRANSPORT_WRITEV_COALESCE_LEN)
+#define TRANSPORT_WRITEV_COALESCE_LEN (256)
+#endif
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     extern "C" {
@@ -277,6 +299,10 @@ typedef struct SSLContext
     mbedtls_entropy_context entropyContext;  /**< Entropy context for random number generation. */
     mbedtls_ctr_drbg_context ctrDrgbContext; /**< CTR DRBG context for random number generation. */
 #endif
+#if TRANSPORT_SESSION_CACHE_SIZE > 0
+    uint32_t sessionKey;                     /**< Session cache key for this connection. */
+    int peerCertVerified;                    /**< Set if the peer certificate was verified (i.e., full handshake). */
+#endif
 } SSLContext_t;
 
 typedef void (*TransportRecvCallback_t)(NetworkContext_t *ctx, void *arg);
@@ -424,6 +450,27 @@ int32_t transport_send( NetworkContext_t * pNetworkContext,
                            const void * pBuffer,
                            size_t bytesToSend );
 
+/**
+ * Sends a list of buffers over an established TLS connection.
+ *
+ * This is the TLS version of the transport interface's
+ * #TransportWritev_t function. Large buffers are encrypted directly from
+ * @p pIoVec, split into records of at most the maximum record payload
+ * length, while small buffers are coalesced with the data that follows.
+ *
+ * @param[in] pNetworkContext The network context.
+ * @param[in] pIoVec Array of buffers to send, in order.
+ * @param[in] ioVecCount Number of entries in @p pIoVec.
+ *
+ * @return Number of bytes (> 0) sent on success, which may be less than
+ * the total length of @p pIoVec;
+ * 0 if the socket times out without sending any bytes;
+ * else a negative value to represent error.
+ */
+int32_t transport_writev( NetworkContext_t * pNetworkContext,
+                          TransportOutVector_t * pIoVec,
+                          size_t ioVecCount );
+
 /**
  * Register a callback that is invoked when data is received on the socket.
  *
@@ -437,6 +484,76 @@ int32_t transport_register_recv_callback( NetworkContext_t * pNetworkContext,
                                           TransportRecvCallback_t recvCallback,
                                           void *arg );
 
+#if TRANSPORT_SESSION_CACHE_SIZE > 0
+/**
+ * TLS session resumption statistics.
+ */
+typedef struct TransportSessionStats
+{
+    uint32_t fullHandshakes;    /**< Number of successful handshakes that did not resume a session. */
+    uint32_t resumedHandshakes; /**< Number of successful handshakes that resumed a cached session. */
+    uint32_t resumeAttempts;    /**< Number of handshakes where a cached session was offered. */
+} TransportSessionStats_t;
+
+/**
+ * Prototype for callback invoked when the contents of the session cache change, for example to
+ * persist the cache using @ref transport_session_cache_save().
+ *
+ * @note This is invoked from the context of the task that is connecting or disconnecting, and
+ *       must not call @ref transport_connect() or @ref transport_disconnect().
+ *
+ * @param arg Opaque argument as given to @ref transport_session_cache_register_update_callback().
+ */
+typedef void (*TransportSessionUpdateCallback_t)(void *arg);
+
+/**
+ * Get TLS session resumption statistics.
+ *
+ * @param[out] pStats Structure to receive the statistics.
+ */
+void transport_session_get_stats( TransportSessionStats_t * pStats );
+
+/**
+ * Remove all entries from the TLS session cache.
+ */
+void transport_session_cache_clear( void );
+
+/**
+ * Serialize the contents of the TLS session cache, e.g. for storing in non-volatile memory.
+ *
+ * @param[out] pBuffer Buffer to receive the serialized cache. May be @c NULL if @p bufferLen is 0.
+ * @param[in]  bufferLen Length of @p pBuffer.
+ * @param[out] pOutLen Set to the length of the serialized cache, even if @p pBuffer was too small.
+ *
+ * @return 0 on success, or a negative mbedTLS error code (e.g.,
+ *         @c MBEDTLS_ERR_SSL_BUFFER_TOO_SMALL).
+ */
+int32_t transport_session_cache_save( uint8_t * pBuffer,
+                                      size_t bufferLen,
+                                      size_t * pOutLen );
+
+/**
+ * Restore the TLS session cache from data previously produced by
+ * @ref transport_session_cache_save(). Existing entries are replaced.
+ *
+ * @param[in] pBuffer The serialized cache.
+ * @param[in] bufferLen Length of @p pBuffer.
+ *
+ * @return 0 on success, or a negative mbedTLS error code if the data is invalid.
+ */
+int32_t transport_session_cache_load( const uint8_t * pBuffer,
+                                      size_t bufferLen );
+
+/**
+ * Register a callback to be invoked whenever the TLS session cache is updated.
+ *
+ * @param[in] updateCallback The callback to register, or @c NULL to unregister.
+ * @param[in] arg Opaque argument to be passed to the callback.
+ */
+void transport_session_cache_register_update_callback( TransportSessionUpdateCallback_t updateCallback,
+                                                       void * arg );
+#endif /* TRANSPORT_SESSION_CACHE_SIZE > 0 */
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     }
@@ -39,6 +39,8 @@
 /* TLS transport header. */
 #include "transport_interface.h"
 #include "mmosal.h"
+#include "mmutils.h"
+#include "mbedtls/platform_util.h"
 
 /* Default timeout for transport layer reads */
 #ifndef TRANSPORT_TIMEOUT_MS
@@ -156,9 +158,464 @@ static TransportStatus_t tlsSetup( NetworkContext_t * pNetworkContext,
 static TransportStatus_t tlsHandshake( NetworkContext_t * pNetworkContext,
                                           const NetworkCredentials_t * pNetworkCredentials );
 
+#if TRANSPORT_SESSION_CACHE_SIZE > 0
+
+/** Maximum number of bytes hashed from each credential when computing a session key. */
+#define SESSION_KEY_MAX_CRED_BYTES  ( 256 )
+
+/** Whether TLS 1.3 NewSessionTicket messages are signalled to us so they can be cached. */
+#if defined( MBEDTLS_SSL_PROTO_TLS1_3 ) && defined( MBEDTLS_SSL_SESSION_TICKETS ) && \
+    defined( MBEDTLS_SSL_CLI_C )
+#define SESSION_CACHE_TLS13_TICKETS  ( 1 )
+#else
+#define SESSION_CACHE_TLS13_TICKETS  ( 0 )
+#endif
+
+/**
+ * @brief An entry in the TLS session cache. Sessions are held in serialized form so that entries
+ * can be handed between connections (and to/from persistent storage) without sharing mbedTLS
+ * structures.
+ */
+typedef struct SessionCacheEntry
+{
+    uint32_t key;         /**< Session key as computed by sessionCacheKey(). 0 if unused. */
+    uint32_t lastUsed;    /**< Value of sessionCache.useCounter when the entry was last used. */
+    uint8_t * pData;      /**< Serialized session (allocated with mmosal_malloc). */
+    size_t dataLen;       /**< Length of pData. */
+} SessionCacheEntry_t;
+
+/**
+ * @brief Global TLS session cache state.
+ */
+static struct
+{
+    struct mmosal_mutex * mutex;
+    uint32_t useCounter;
+    SessionCacheEntry_t entries[ TRANSPORT_SESSION_CACHE_SIZE ];
+    TransportSessionStats_t stats;
+    TransportSessionUpdateCallback_t updateCallback;
+    void * updateCallbackArg;
+} sessionCache;
+
+/**
+ * @brief Compute the session cache key for a connection.
+ *
+ * The key covers the server identity and the credentials in use so that a session established
+ * with one set of credentials is never resumed with another.
+ */
+static uint32_t sessionCacheKey( const char * pHostName,
+                                 uint16_t port,
+                                 const NetworkCredentials_t * pNetworkCredentials );
+
+/**
+ * @brief Offer a cached session (if any) for resumption on the given connection.
+ */
+static void sessionCacheApply( SSLContext_t * pSslContext );
+
+/**
+ * @brief Export the current session of the given connection into the cache.
+ */
+static void sessionCacheStore( SSLContext_t * pSslContext );
+
+#endif /* TRANSPORT_SESSION_CACHE_SIZE > 0 */
+
 
 /*-----------------------------------------------------------*/
 
+#if TRANSPORT_SESSION_CACHE_SIZE > 0
+
+static void sessionCacheLock( void )
+{
+    if( sessionCache.mutex == NULL )
+    {
+        struct mmosal_mutex * mutex = mmosal_mutex_create( "tls_sess" );
+
+        mmosal_task_enter_critical();
+        if( sessionCache.mutex == NULL )
+        {
+            sessionCache.mutex = mutex;
+            mutex = NULL;
+        }
+        mmosal_task_exit_critical();
+
+        if( mutex != NULL )
+        {
+            mmosal_mutex_delete( mutex );
+        }
+    }
+
+    configASSERT( sessionCache.mutex != NULL );
+    mmosal_mutex_get( sessionCache.mutex, UINT32_MAX );
+}
+
+static void sessionCacheUnlock( void )
+{
+    mmosal_mutex_release( sessionCache.mutex );
+}
+
+static uint32_t fnv1a( uint32_t hash,
+                       const void * pData,
+                       size_t len )
+{
+    const uint8_t * pBytes = pData;
+
+    while( len-- > 0 )
+    {
+        hash ^= *pBytes++;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+static uint32_t sessionCacheKey( const char * pHostName,
+                                 uint16_t port,
+                                 const NetworkCredentials_t * pNetworkCredentials )
+{
+    uint32_t hash = 2166136261u;
+
+    hash = fnv1a( hash, pHostName, strlen( pHostName ) );
+    hash = fnv1a( hash, &port, sizeof( port ) );
+
+    /* The tail of a PEM or DER certificate contains the signature, so hashing the last bytes
+     * is sufficient to distinguish certificates without hashing the whole thing. */
+    if( pNetworkCredentials->pRootCa != NULL )
+    {
+        size_t len = MM_MIN( pNetworkCredentials->rootCaSize, SESSION_KEY_MAX_CRED_BYTES );
+        hash = fnv1a( hash,
+                      pNetworkCredentials->pRootCa + pNetworkCredentials->rootCaSize - len,
+                      len );
+    }
+
+    if( pNetworkCredentials->pClientCert != NULL )
+    {
+        size_t len = MM_MIN( pNetworkCredentials->clientCertSize, SESSION_KEY_MAX_CRED_BYTES );
+        hash = fnv1a( hash,
+                      pNetworkCredentials->pClientCert + pNetworkCredentials->clientCertSize - len,
+                      len );
+    }
+
+    /* Zero is reserved to mark unused entries. */
+    return ( hash == 0 ) ? 1 : hash;
+}
+
+static SessionCacheEntry_t * sessionCacheFind( uint32_t key )
+{
+    size_t ii;
+
+    for( ii = 0; ii < TRANSPORT_SESSION_CACHE_SIZE; ii++ )
+    {
+        if( sessionCache.entries[ ii ].key == key )
+        {
+            return &sessionCache.entries[ ii ];
+        }
+    }
+
+    return NULL;
+}
+
+static void sessionCacheEntryFree( SessionCacheEntry_t * pEntry )
+{
+    if( pEntry->pData != NULL )
+    {
+        mbedtls_platform_zeroize( pEntry->pData, pEntry->dataLen );
+        mmosal_free( pEntry->pData );
+    }
+
+    memset( pEntry, 0, sizeof( *pEntry ) );
+}
+
+/**
+ * @brief Insert a serialized session into the cache, evicting the least recently used entry if
+ * necessary. Takes ownership of pData. Must be called with the cache locked.
+ */
+static void sessionCacheInsert( uint32_t key,
+                                uint8_t * pData,
+                                size_t dataLen )
+{
+    SessionCacheEntry_t * pEntry = sessionCacheFind( key );
+    size_t ii;
+
+    if( pEntry == NULL )
+    {
+        pEntry = &sessionCache.entries[ 0 ];
+        for( ii = 1; ii < TRANSPORT_SESSION_CACHE_SIZE; ii++ )
+        {
+            if( sessionCache.entries[ ii ].key == 0 )
+            {
+                pEntry = &sessionCache.entries[ ii ];
+                break;
+            }
+
+            if( sessionCache.entries[ ii ].lastUsed < pEntry->lastUsed )
+            {
+                pEntry = &sessionCache.entries[ ii ];
+            }
+        }
+    }
+
+    sessionCacheEntryFree( pEntry );
+    pEntry->key = key;
+    pEntry->lastUsed = ++sessionCache.useCounter;
+    pEntry->pData = pData;
+    pEntry->dataLen = dataLen;
+}
+
+/**
+ * @brief Invoke the update callback. Must be called with the cache unlocked, since the callback
+ * is likely to call transport_session_cache_save().
+ */
+static void sessionCacheNotify( void )
+{
+    TransportSessionUpdateCallback_t updateCallback;
+    void * updateCallbackArg;
+
+    sessionCacheLock();
+    updateCallback = sessionCache.updateCallback;
+    updateCallbackArg = sessionCache.updateCallbackArg;
+    sessionCacheUnlock();
+
+    if( updateCallback != NULL )
+    {
+        updateCallback( updateCallbackArg );
+    }
+}
+
+static void sessionCacheApply( SSLContext_t * pSslContext )
+{
+    SessionCacheEntry_t * pEntry;
+    mbedtls_ssl_session session;
+    int32_t mbedtlsError = -1;
+
+    mbedtls_ssl_session_init( &session );
+
+    sessionCacheLock();
+    pEntry = sessionCacheFind( pSslContext->sessionKey );
+    if( pEntry != NULL )
+    {
+        pEntry->lastUsed = ++sessionCache.useCounter;
+        mbedtlsError = mbedtls_ssl_session_load( &session, pEntry->pData, pEntry->dataLen );
+        if( mbedtlsError != 0 )
+        {
+            /* Stale entry, e.g. from a different mbedTLS configuration. */
+            sessionCacheEntryFree( pEntry );
+        }
+    }
+    sessionCacheUnlock();
+
+    if( mbedtlsError == 0 )
+    {
+        mbedtlsError = mbedtls_ssl_set_session( &( pSslContext->context ), &session );
+    }
+
+    mbedtls_ssl_session_free( &session );
+
+    if( mbedtlsError == 0 )
+    {
+        sessionCacheLock();
+        sessionCache.stats.resumeAttempts++;
+        sessionCacheUnlock();
+    }
+}
+
+static void sessionCacheStore( SSLContext_t * pSslContext )
+{
+    mbedtls_ssl_session session;
+    uint8_t * pData = NULL;
+    size_t dataLen = 0;
+    int32_t mbedtlsError;
+
+    mbedtls_ssl_session_init( &session );
+
+    /* This fails if the current session has already been exported, i.e. nothing has changed
+     * since the last call (for TLS 1.3 each new ticket yields a new session). */
+    mbedtlsError = mbedtls_ssl_get_session( &( pSslContext->context ), &session );
+
+#if defined( MBEDTLS_SSL_PROTO_TLS1_3 )
+    /* A TLS 1.3 session can only be resumed with a ticket, so there is nothing worth caching
+     * until the server has sent one. */
+    if( ( mbedtlsError == 0 ) &&
+        ( mbedtls_ssl_get_version_number( &( pSslContext->context ) ) ==
+          MBEDTLS_SSL_VERSION_TLS1_3 ) )
+    {
+#if SESSION_CACHE_TLS13_TICKETS
+        if( session.MBEDTLS_PRIVATE( ticket ) == NULL )
+#endif
+        {
+            mbedtlsError = MBEDTLS_ERR_SSL_FEATURE_UNAVAILABLE;
+        }
+    }
+#endif
+
+    if( mbedtlsError == 0 )
+    {
+        ( void ) mbedtls_ssl_session_save( &session, NULL, 0, &dataLen );
+        pData = mmosal_malloc( dataLen );
+        if( pData == NULL )
+        {
+            mbedtlsError = MBEDTLS_ERR_SSL_ALLOC_FAILED;
+        }
+        else
+        {
+            mbedtlsError = mbedtls_ssl_session_save( &session, pData, dataLen, &dataLen );
+        }
+    }
+
+    mbedtls_ssl_session_free( &session );
+
+    if( mbedtlsError != 0 )
+    {
+        mmosal_free( pData );
+        return;
+    }
+
+    sessionCacheLock();
+    sessionCacheInsert( pSslContext->sessionKey, pData, dataLen );
+    sessionCacheUnlock();
+
+    sessionCacheNotify();
+}
+
+/**
+ * @brief Certificate verification callback. This is only invoked when the server presents a
+ * certificate chain, which does not happen when a session is resumed. It does not alter the
+ * verification result.
+ */
+static int sessionVerifyCallback( void * pArg,
+                                  mbedtls_x509_crt * pCrt,
+                                  int depth,
+                                  uint32_t * pFlags )
+{
+    SSLContext_t * pSslContext = pArg;
+
+    ( void ) pCrt;
+    ( void ) depth;
+    ( void ) pFlags;
+
+    pSslContext->peerCertVerified = 1;
+    return 0;
+}
+
+void transport_session_get_stats( TransportSessionStats_t * pStats )
+{
+    sessionCacheLock();
+    *pStats = sessionCache.stats;
+    sessionCacheUnlock();
+}
+
+void transport_session_cache_clear( void )
+{
+    size_t ii;
+
+    sessionCacheLock();
+    for( ii = 0; ii < TRANSPORT_SESSION_CACHE_SIZE; ii++ )
+    {
+        sessionCacheEntryFree( &sessionCache.entries[ ii ] );
+    }
+    sessionCacheUnlock();
+
+    sessionCacheNotify();
+}
+
+/*
+ * Serialized cache format: a sequence of entries, each consisting of a 4 byte key and
+ * a 2 byte length (both little endian) followed by the serialized session.
+ */
+#define SESSION_CACHE_ENTRY_HDR_LEN ( 6 )
+
+int32_t transport_session_cache_save( uint8_t * pBuffer,
+                                      size_t bufferLen,
+                                      size_t * pOutLen )
+{
+    size_t offset = 0;
+    size_t ii;
+
+    sessionCacheLock();
+    for( ii = 0; ii < TRANSPORT_SESSION_CACHE_SIZE; ii++ )
+    {
+        const SessionCacheEntry_t * pEntry = &sessionCache.entries[ ii ];
+
+        if( ( pEntry->key == 0 ) || ( pEntry->dataLen > UINT16_MAX ) )
+        {
+            continue;
+        }
+
+        if( offset + SESSION_CACHE_ENTRY_HDR_LEN + pEntry->dataLen <= bufferLen )
+        {
+            uint8_t * pHdr = pBuffer + offset;
+            pHdr[ 0 ] = pEntry->key & 0xff;
+            pHdr[ 1 ] = ( pEntry->key >> 8 ) & 0xff;
+            pHdr[ 2 ] = ( pEntry->key >> 16 ) & 0xff;
+            pHdr[ 3 ] = ( pEntry->key >> 24 ) & 0xff;
+            pHdr[ 4 ] = pEntry->dataLen & 0xff;
+            pHdr[ 5 ] = ( pEntry->dataLen >> 8 ) & 0xff;
+            memcpy( pHdr + SESSION_CACHE_ENTRY_HDR_LEN, pEntry->pData, pEntry->dataLen );
+        }
+
+        offset += SESSION_CACHE_ENTRY_HDR_LEN + pEntry->dataLen;
+    }
+    sessionCacheUnlock();
+
+    *pOutLen = offset;
+    return ( offset <= bufferLen ) ? 0 : MBEDTLS_ERR_SSL_BUFFER_TOO_SMALL;
+}
+
+int32_t transport_session_cache_load( const uint8_t * pBuffer,
+                                      size_t bufferLen )
+{
+    size_t offset = 0;
+    size_t ii;
+    int32_t ret = 0;
+
+    sessionCacheLock();
+    for( ii = 0; ii < TRANSPORT_SESSION_CACHE_SIZE; ii++ )
+    {
+        sessionCacheEntryFree( &sessionCache.entries[ ii ] );
+    }
+
+    while( offset + SESSION_CACHE_ENTRY_HDR_LEN <= bufferLen )
+    {
+        const uint8_t * pHdr = pBuffer + offset;
+        uint32_t key = pHdr[ 0 ] | ( pHdr[ 1 ] << 8 ) | ( pHdr[ 2 ] << 16 ) |
+                       ( ( uint32_t ) pHdr[ 3 ] << 24 );
+        size_t dataLen = pHdr[ 4 ] | ( pHdr[ 5 ] << 8 );
+        uint8_t * pData;
+
+        offset += SESSION_CACHE_ENTRY_HDR_LEN;
+        if( ( key == 0 ) || ( offset + dataLen > bufferLen ) )
+        {
+            ret = MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+            break;
+        }
+
+        pData = mmosal_malloc( dataLen );
+        if( pData == NULL )
+        {
+            ret = MBEDTLS_ERR_SSL_ALLOC_FAILED;
+            break;
+        }
+
+        memcpy( pData, pBuffer + offset, dataLen );
+        sessionCacheInsert( key, pData, dataLen );
+        offset += dataLen;
+    }
+    sessionCacheUnlock();
+
+    return ret;
+}
+
+void transport_session_cache_register_update_callback( TransportSessionUpdateCallback_t updateCallback,
+                                                       void * arg )
+{
+    sessionCacheLock();
+    sessionCache.updateCallback = updateCallback;
+    sessionCache.updateCallbackArg = arg;
+    sessionCacheUnlock();
+}
+
+#endif /* TRANSPORT_SESSION_CACHE_SIZE > 0 */
+/*-----------------------------------------------------------*/
+
 static void sslContextInit( SSLContext_t * pSslContext )
 {
     configASSERT( pSslContext != NULL );
@@ -307,6 +764,17 @@ static int32_t setCredentials( SSLContext_t * pSslContext,
     mbedtls_ssl_conf_cert_profile( &( pSslContext->config ),
                                    &( pSslContext->certProfile ) );
 
+#if TRANSPORT_SESSION_CACHE_SIZE > 0
+    mbedtls_ssl_conf_verify( &( pSslContext->config ),
+                             sessionVerifyCallback,
+                             pSslContext );
+#if SESSION_CACHE_TLS13_TICKETS
+    /* TLS 1.3 clients drop NewSessionTicket messages unless asked to report them. */
+    mbedtls_ssl_conf_tls13_enable_signal_new_session_tickets(
+        &( pSslContext->config ), MBEDTLS_SSL_TLS1_3_SIGNAL_NEW_SESSION_TICKETS_ENABLED );
+#endif
+#endif
+
     mbedtlsError = setRootCa( pSslContext,
                               pNetworkCredentials->pRootCa,
                               pNetworkCredentials->rootCaSize );
@@ -504,6 +972,12 @@ static TransportStatus_t tlsHandshake( NetworkContext_t * pNetworkContext,
                             mbedtls_net_send,
                             NULL,
                             mbedtls_net_recv_timeout);
+
+#if TRANSPORT_SESSION_CACHE_SIZE > 0
+        /* Offer a cached session so the server can skip the full key exchange and
+         * certificate verification. */
+        sessionCacheApply( &( pNetworkContext->sslContext ) );
+#endif
     }
 
     if( returnStatus == TRANSPORT_SUCCESS )
@@ -536,6 +1010,27 @@ static TransportStatus_t tlsHandshake( NetworkContext_t * pNetworkContext,
                  */
                 return TRANSPORT_AUTHENTICATION_FAILED;
             }
+
+#if TRANSPORT_SESSION_CACHE_SIZE > 0
+            sessionCacheLock();
+            if( pNetworkContext->sslContext.peerCertVerified )
+            {
+                sessionCache.stats.fullHandshakes++;
+            }
+            else
+            {
+                sessionCache.stats.resumedHandshakes++;
+            }
+            sessionCacheUnlock();
+
+            /* TLS 1.3 tickets arrive after the handshake, so those sessions are stored as
+             * each ticket is received instead. */
+            if( mbedtls_ssl_get_version_number( &( pNetworkContext->sslContext.context ) ) ==
+                MBEDTLS_SSL_VERSION_TLS1_2 )
+            {
+                sessionCacheStore( &( pNetworkContext->sslContext ) );
+            }
+#endif
         }
     }
 
@@ -590,6 +1085,15 @@ TransportStatus_t transport_connect( NetworkContext_t * pNetworkContext,
             returnStatus = tlsSetup( pNetworkContext, pHostName, pNetworkCredentials );
         }
 
+#if TRANSPORT_SESSION_CACHE_SIZE > 0
+        if( returnStatus == TRANSPORT_SUCCESS )
+        {
+            pNetworkContext->sslContext.sessionKey = sessionCacheKey( pHostName, port,
+                                                                      pNetworkCredentials );
+            pNetworkContext->sslContext.peerCertVerified = 0;
+        }
+#endif
+
         /* Perform TLS handshake. */
         if( returnStatus == TRANSPORT_SUCCESS )
         {
@@ -634,6 +1138,10 @@ void transport_disconnect( NetworkContext_t * pNetworkContext )
     {
         if(pNetworkContext->sslContext.useTLS)
         {
+#if TRANSPORT_SESSION_CACHE_SIZE > 0
+            /* Pick up any session that has not been stored yet. */
+            sessionCacheStore( &( pNetworkContext->sslContext ) );
+#endif
             /* Attempting to terminate TLS connection. */
             mbedtls_ssl_close_notify( &( pNetworkContext->sslContext.context ) );
             /* Free mbed TLS contexts. */
@@ -663,6 +1171,13 @@ int32_t transport_recv_with_timeout(NetworkContext_t * pNetworkContext,
             readStatus = ( int32_t ) mbedtls_ssl_read(&( pNetworkContext->sslContext.context ),
                                                       pBuffer,
                                                       bytesToRecv );
+#if TRANSPORT_SESSION_CACHE_SIZE > 0 && SESSION_CACHE_TLS13_TICKETS
+            if (readStatus == MBEDTLS_ERR_SSL_RECEIVED_NEW_SESSION_TICKET)
+            {
+                /* The ticket has to be exported before the next read replaces it. */
+                sessionCacheStore( &( pNetworkContext->sslContext ) );
+            }
+#endif
         }
 #if defined(MBEDTLS_SSL_PROTO_TLS1_3) && !defined(MBEDTLS_SSL_SESSION_TICKETS)
         /* In TLS 1.3, a new session ticket is issued by the server after the handshake is successfully completed.
@@ -670,6 +1185,8 @@ int32_t transport_recv_with_timeout(NetworkContext_t * pNetworkContext,
         * when a new session ticket message is received from the server.
         */
         while (readStatus == MBEDTLS_ERR_SSL_UNEXPECTED_MESSAGE);
+#elif TRANSPORT_SESSION_CACHE_SIZE > 0 && SESSION_CACHE_TLS13_TICKETS
+        while (readStatus == MBEDTLS_ERR_SSL_RECEIVED_NEW_SESSION_TICKET);
 #else
         while (0);
 #endif
@@ -703,9 +1220,9 @@ int32_t transport_recv( NetworkContext_t * pNetworkContext,
 }
 /*-----------------------------------------------------------*/
 
-int32_t transport_send( NetworkContext_t * pNetworkContext,
-                           const void * pBuffer,
-                           size_t bytesToSend )
+static int32_t transportWrite( NetworkContext_t * pNetworkContext,
+                               const void * pBuffer,
+                               size_t bytesToSend )
 {
     int32_t sendStatus = 0;
 
@@ -726,6 +1243,112 @@ int32_t transport_send( NetworkContext_t * pNetworkContext,
 
     return sendStatus;
 }
+
+int32_t transport_send( NetworkContext_t * pNetworkContext,
+                           const void * pBuffer,
+                           size_t bytesToSend )
+{
+    return transportWrite( pNetworkContext, pBuffer, bytesToSend );
+}
+/*-----------------------------------------------------------*/
+
+int32_t transport_writev( NetworkContext_t * pNetworkContext,
+                          TransportOutVector_t * pIoVec,
+                          size_t ioVecCount )
+{
+    uint8_t coalesceBuf[ TRANSPORT_WRITEV_COALESCE_LEN ];
+    size_t maxChunkLen = SIZE_MAX;
+    size_t vecIdx = 0;
+    size_t vecOffset = 0;
+    int32_t totalSent = 0;
+
+    configASSERT( pIoVec != NULL );
+
+    if (pNetworkContext->sslContext.useTLS)
+    {
+        int maxPayload = mbedtls_ssl_get_max_out_record_payload( &( pNetworkContext->sslContext.context ) );
+
+        if (maxPayload > 0)
+        {
+            maxChunkLen = ( size_t ) maxPayload;
+        }
+    }
+
+    while (vecIdx < ioVecCount)
+    {
+        const uint8_t * pData = ( const uint8_t * ) pIoVec[ vecIdx ].iov_base + vecOffset;
+        size_t remaining = pIoVec[ vecIdx ].iov_len - vecOffset;
+        int32_t sendStatus;
+
+        if (remaining == 0)
+        {
+            vecIdx++;
+            vecOffset = 0;
+            continue;
+        }
+
+        if ((remaining < sizeof( coalesceBuf )) && (vecIdx + 1 < ioVecCount))
+        {
+            /* Gather this vector and the start of the following ones into a single record. */
+            size_t fillLen = 0;
+            size_t gatherIdx = vecIdx;
+            size_t gatherOffset = vecOffset;
+
+            while ((gatherIdx < ioVecCount) && (fillLen < sizeof( coalesceBuf )))
+            {
+                size_t copyLen = MM_MIN( pIoVec[ gatherIdx ].iov_len - gatherOffset,
+                                         sizeof( coalesceBuf ) - fillLen );
+
+                memcpy( &( coalesceBuf[ fillLen ] ),
+                        ( const uint8_t * ) pIoVec[ gatherIdx ].iov_base + gatherOffset,
+                        copyLen );
+                fillLen += copyLen;
+                gatherOffset += copyLen;
+
+                if (gatherOffset == pIoVec[ gatherIdx ].iov_len)
+                {
+                    gatherIdx++;
+                    gatherOffset = 0;
+                }
+            }
+
+            sendStatus = transportWrite( pNetworkContext, coalesceBuf, MM_MIN( fillLen, maxChunkLen ) );
+        }
+        else
+        {
+            /* Encrypt directly from the caller's buffer, one record at a time. */
+            sendStatus = transportWrite( pNetworkContext, pData, MM_MIN( remaining, maxChunkLen ) );
+        }
+
+        if (sendStatus <= 0)
+        {
+            /* Report what was sent so far; the error will be seen again on the next call. */
+            return (totalSent > 0) ? totalSent : sendStatus;
+        }
+
+        totalSent += sendStatus;
+
+        /* Advance past the bytes that were sent, which may span several vectors. */
+        while ((sendStatus > 0) && (vecIdx < ioVecCount))
+        {
+            size_t vecRemaining = pIoVec[ vecIdx ].iov_len - vecOffset;
+
+            if (( size_t ) sendStatus < vecRemaining)
+            {
+                vecOffset += ( size_t ) sendStatus;
+                sendStatus = 0;
+            }
+            else
+            {
+                sendStatus -= ( int32_t ) vecRemaining;
+                vecIdx++;
+                vecOffset = 0;
+            }
+        }
+    }
+
+    return totalSent;
+}
 /*-----------------------------------------------------------*/
 
 static void transport_recv_callback( struct mbedtls_net_context * mbedtlsCtx, void *arg )
@@ -30,6 +30,24 @@
 #define DNS_MAX_SERVERS 2
 #endif
 
+/** mmconfig key under which the WLAN BSS cache is persisted. */
+#define BSS_CACHE_CONFIG_KEY "wlan.bss_cache"
+
+/**
+ * mmconfig key under which SAE PMKSA cache entries are persisted. Note that this contains the PMK
+ * in plaintext; only set @c APP_PERSIST_PMKSA to 1 if the config store is adequately protected.
+ */
+#define PMKSA_CONFIG_KEY "wlan.pmksa"
+
+#ifndef APP_PERSIST_PMKSA
+/**
+ * Persist SAE PMKSA cache entries so that SAE can be skipped on reconnect after boot. Disabled by
+ * default because the entries contain key material. Restored entries do not account for time
+ * spent powered off; see @ref mmwlan_sta_pmksa_save().
+ */
+#define APP_PERSIST_PMKSA (0)
+#endif
+
 /** Binary semaphore used to start user_main() once the link comes up. */
 static struct mmosal_semb *attempting_link = NULL;
 static bool link_success = false;
@@ -158,6 +176,71 @@ static void fatal_error_handler(struct mmwlan_fatal_error_args *args)
     mmosal_semb_give(attempting_link);
 }
 
+/** Function type for loading WLAN state previously saved with a @ref wlan_state_save_fn_t. */
+typedef enum mmwlan_status (*wlan_state_load_fn_t)(const uint8_t *buf, size_t len);
+
+/** Function type for serializing WLAN state so that it can be saved to the config store. */
+typedef enum mmwlan_status (*wlan_state_save_fn_t)(uint8_t *buf, size_t *len);
+
+/**
+ * Restore WLAN state (e.g., the BSS cache) from the config store.
+ *
+ * @param key     mmconfig key the state is stored under.
+ * @param load_fn Function to load the state into mmwlan.
+ */
+static void restore_wlan_state(const char *key, wlan_state_load_fn_t load_fn)
+{
+    void *buf = NULL;
+    int len = mmconfig_alloc_and_load(key, &buf);
+
+    if (len > 0 && load_fn((const uint8_t *)buf, len) != MMWLAN_SUCCESS)
+    {
+        /* Stale or corrupt entry; remove it so we do not try again on next boot. */
+        mmconfig_delete_key(key);
+    }
+
+    mmosal_free(buf);
+}
+
+/**
+ * Save WLAN state to the config store. The config store is only written if the serialized
+ * state differs from what is already stored, to avoid unnecessary flash wear.
+ *
+ * @param key     mmconfig key to store the state under.
+ * @param save_fn Function to serialize the state from mmwlan.
+ */
+static void save_wlan_state(const char *key, wlan_state_save_fn_t save_fn)
+{
+    size_t len = 0;
+    uint8_t *buf;
+    void *stored = NULL;
+    int stored_len;
+
+    (void)save_fn(NULL, &len);
+    if (len == 0)
+    {
+        return;
+    }
+
+    buf = (uint8_t *)mmosal_malloc(len);
+    if (buf == NULL)
+    {
+        return;
+    }
+
+    if (save_fn(buf, &len) == MMWLAN_SUCCESS)
+    {
+        stored_len = mmconfig_alloc_and_load(key, &stored);
+        if (stored_len != (int)len || memcmp(stored, buf, len) != 0)
+        {
+            (void)mmconfig_write_data(key, buf, len);
+        }
+        mmosal_free(stored);
+    }
+
+    mmosal_free(buf);
+}
+
 void app_print_version_info(void)
 {
     enum mmwlan_status status;
@@ -263,6 +346,11 @@ void app_wlan_start(void)
     printf("\n");
     printf("This may take some time (~10 seconds)\n");
 
+    restore_wlan_state(BSS_CACHE_CONFIG_KEY, mmwlan_bss_cache_load);
+#if APP_PERSIST_PMKSA
+    restore_wlan_state(PMKSA_CONFIG_KEY, mmwlan_sta_pmksa_load);
+#endif
+
     status = mmwlan_sta_enable(&sta_args, sta_status_callback);
     MMOSAL_ASSERT(status == MMWLAN_SUCCESS);
 
@@ -270,6 +358,14 @@ void app_wlan_start(void)
      * Use a binary semaphore to block us until Link is up.
      */
     mmosal_semb_wait(attempting_link, UINT32_MAX);
+
+    if (link_success)
+    {
+        save_wlan_state(BSS_CACHE_CONFIG_KEY, mmwlan_bss_cache_save);
+#if APP_PERSIST_PMKSA
+        save_wlan_state(PMKSA_CONFIG_KEY, mmwlan_sta_pmksa_save);
+#endif
+    }
     /* Wi-Fi link is now established, return to caller */
 }
 
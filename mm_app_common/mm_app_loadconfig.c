@@ -87,19 +87,57 @@
 
 void load_mmipal_init_args(struct mmipal_init_args *args)
 {
-    bool boolval;
+    bool dhcp_enabled;
+#if defined(MMIPAL_IPV6_ENABLED) && MMIPAL_IPV6_ENABLED
+    bool ip6_autoconfig;
+#endif
 
-    /* Load default static IP in case we don't find the key */
-    (void)mmosal_safer_strcpy(args->ip_addr, STATIC_LOCAL_IP, sizeof(args->ip_addr));
-    (void)mmconfig_read_string("ip.ip_addr", args->ip_addr, sizeof(args->ip_addr));
+    enum
+    {
+        ITEM_IP_ADDR,
+        ITEM_NETMASK,
+        ITEM_GATEWAY,
+        ITEM_DHCP_ENABLED,
+#if defined(MMIPAL_IPV6_ENABLED) && MMIPAL_IPV6_ENABLED
+        ITEM_IP6_ADDR,
+        ITEM_IP6_AUTOCONFIG,
+#endif
+        NUM_ITEMS
+    };
 
-    /* Load default netmask in case we don't find the key */
-    (void)mmosal_safer_strcpy(args->netmask, STATIC_NETMASK, sizeof(args->netmask));
-    (void)mmconfig_read_string("ip.netmask", args->netmask, sizeof(args->netmask));
+    /* All keys are read from the config store in one go.
+     * @note The value of any key that is not found is left untouched, so defaults are loaded
+     * before reading.
+     */
+    struct mmconfig_read_item items[NUM_ITEMS] = {
+        [ITEM_IP_ADDR] = MMCONFIG_READ_ITEM_STRING("ip.ip_addr",
+                                                   args->ip_addr,
+                                                   sizeof(args->ip_addr)),
+        [ITEM_NETMASK] = MMCONFIG_READ_ITEM_STRING("ip.netmask",
+                                                   args->netmask,
+                                                   sizeof(args->netmask)),
+        [ITEM_GATEWAY] = MMCONFIG_READ_ITEM_STRING("ip.gateway",
+                                                   args->gateway_addr,
+                                                   sizeof(args->gateway_addr)),
+        [ITEM_DHCP_ENABLED] = MMCONFIG_READ_ITEM_BOOL("ip.dhcp_enabled", &dhcp_enabled),
+#if defined(MMIPAL_IPV6_ENABLED) && MMIPAL_IPV6_ENABLED
+        [ITEM_IP6_ADDR] = MMCONFIG_READ_ITEM_STRING("ip6.ip_addr",
+                                                    args->ip6_addr,
+                                                    sizeof(args->ip6_addr)),
+        [ITEM_IP6_AUTOCONFIG] = MMCONFIG_READ_ITEM_BOOL("ip6.autoconfig", &ip6_autoconfig),
+#endif
+    };
 
-    /* Load default gateway in case we don't find the key */
+    /* Load default static IP, netmask and gateway in case we don't find the keys */
+    (void)mmosal_safer_strcpy(args->ip_addr, STATIC_LOCAL_IP, sizeof(args->ip_addr));
+    (void)mmosal_safer_strcpy(args->netmask, STATIC_NETMASK, sizeof(args->netmask));
     (void)mmosal_safer_strcpy(args->gateway_addr, STATIC_GATEWAY, sizeof(args->gateway_addr));
-    (void)mmconfig_read_string("ip.gateway", args->gateway_addr, sizeof(args->gateway_addr));
+#if defined(MMIPAL_IPV6_ENABLED) && MMIPAL_IPV6_ENABLED
+    /* Load default static IPv6 in case we don't find the key */
+    (void)mmosal_safer_strcpy(args->ip6_addr, STATIC_LOCAL_IP6, sizeof(args->ip6_addr));
+#endif
+
+    (void)mmconfig_read_items(items, NUM_ITEMS);
 
 #if ENABLE_DHCP
     args->mode = MMIPAL_DHCP;
@@ -107,13 +145,10 @@ void load_mmipal_init_args(struct mmipal_init_args *args)
     args->mode = MMIPAL_STATIC;
 #endif
 
-    /* If the following setting is not found, we leave as is.
-     * @note All mmconfig_read_xxx() functions leave the value untouched
-     * if the key is not found.
-     */
-    if (mmconfig_read_bool("ip.dhcp_enabled", &boolval) == MMCONFIG_OK)
+    /* If the following setting is not found, we leave as is. */
+    if (items[ITEM_DHCP_ENABLED].result == MMCONFIG_OK)
     {
-        if (boolval)
+        if (dhcp_enabled)
         {
             /* DHCP mode */
             args->mode = MMIPAL_DHCP;
@@ -134,17 +169,13 @@ void load_mmipal_init_args(struct mmipal_init_args *args)
     }
 
 #if defined(MMIPAL_IPV6_ENABLED) && MMIPAL_IPV6_ENABLED
-    /* Load default static IPv6 in case we don't find the key */
-    (void)mmosal_safer_strcpy(args->ip6_addr, STATIC_LOCAL_IP6, sizeof(args->ip6_addr));
-    (void)mmconfig_read_string("ip6.ip_addr", args->ip6_addr, sizeof(args->ip6_addr));
-
     /* We set this as the by default IPv6 is set to disabled in @ref MMIPAL_INIT_ARGS_DEFAULT */
     args->ip6_mode = MMIPAL_IP6_AUTOCONFIG;
 
     /* If the following setting is not found, we default to autoconfig mode */
-    if (mmconfig_read_bool("ip6.autoconfig", &boolval) == MMCONFIG_OK)
+    if (items[ITEM_IP6_AUTOCONFIG].result == MMCONFIG_OK)
     {
-        if (boolval)
+        if (ip6_autoconfig)
         {
             /* Autoconfig mode */
             args->ip6_mode = MMIPAL_IP6_AUTOCONFIG;
@@ -187,37 +218,79 @@ const struct mmwlan_s1g_channel_list *load_channel_list(void)
 
 void load_mmwlan_sta_args(struct mmwlan_sta_args *sta_config)
 {
-    char strval[32];
-    int intval;
-    bool boolval;
-
-    /* Load SSID */
+    char security[16];
+    char pmf_mode[16];
+    char bssid[32];
+    char station_type[16];
+    bool cac_enabled;
+    int raw_priority;
+    int scan_interval_base_s;
+    int scan_interval_limit_s;
+
+    enum
+    {
+        ITEM_SSID,
+        ITEM_PASSWORD,
+        ITEM_SECURITY,
+        ITEM_PMF_MODE,
+        ITEM_BSSID,
+        ITEM_STATION_TYPE,
+        ITEM_CAC_ENABLED,
+        ITEM_RAW_PRIORITY,
+        ITEM_SCAN_INTERVAL_BASE_S,
+        ITEM_SCAN_INTERVAL_LIMIT_S,
+        NUM_ITEMS
+    };
+
+    struct mmconfig_read_item items[NUM_ITEMS] = {
+        [ITEM_SSID] = MMCONFIG_READ_ITEM_STRING("wlan.ssid",
+                                                (char *)sta_config->ssid,
+                                                sizeof(sta_config->ssid)),
+        [ITEM_PASSWORD] = MMCONFIG_READ_ITEM_STRING("wlan.password",
+                                                    sta_config->passphrase,
+                                                    sizeof(sta_config->passphrase)),
+        [ITEM_SECURITY] = MMCONFIG_READ_ITEM_STRING("wlan.security",
+                                                    security,
+                                                    sizeof(security)),
+        [ITEM_PMF_MODE] = MMCONFIG_READ_ITEM_STRING("wlan.pmf_mode",
+                                                    pmf_mode,
+                                                    sizeof(pmf_mode)),
+        [ITEM_BSSID] = MMCONFIG_READ_ITEM_STRING("wlan.bssid", bssid, sizeof(bssid)),
+        [ITEM_STATION_TYPE] = MMCONFIG_READ_ITEM_STRING("wlan.station_type",
+                                                        station_type,
+                                                        sizeof(station_type)),
+        [ITEM_CAC_ENABLED] = MMCONFIG_READ_ITEM_BOOL("wlan.cac_enabled", &cac_enabled),
+        [ITEM_RAW_PRIORITY] = MMCONFIG_READ_ITEM_INT("wlan.raw_priority", &raw_priority),
+        [ITEM_SCAN_INTERVAL_BASE_S] = MMCONFIG_READ_ITEM_INT("wlan.sta_scan_interval_base_s",
+                                                             &scan_interval_base_s),
+        [ITEM_SCAN_INTERVAL_LIMIT_S] = MMCONFIG_READ_ITEM_INT("wlan.sta_scan_interval_limit_s",
+                                                              &scan_interval_limit_s),
+    };
+
+    /* Load default SSID and password in case we don't find the keys */
     (void)mmosal_safer_strcpy((char *)sta_config->ssid, STRINGIFY(SSID), sizeof(sta_config->ssid));
-    (void)mmconfig_read_string("wlan.ssid", (char *)sta_config->ssid, sizeof(sta_config->ssid));
-    sta_config->ssid_len = strlen((char *)sta_config->ssid);
-
-    /* Load password */
     (void)mmosal_safer_strcpy(sta_config->passphrase,
                               STRINGIFY(SAE_PASSPHRASE),
                               sizeof(sta_config->passphrase));
-    (void)mmconfig_read_string("wlan.password",
-                               sta_config->passphrase,
-                               sizeof(sta_config->passphrase));
+
+    (void)mmconfig_read_items(items, NUM_ITEMS);
+
+    sta_config->ssid_len = strlen((char *)sta_config->ssid);
     sta_config->passphrase_len = strlen(sta_config->passphrase);
 
     /* Load security type */
     sta_config->security_type = SECURITY_TYPE;
-    if (mmconfig_read_string("wlan.security", strval, sizeof(strval)) > 0)
+    if (items[ITEM_SECURITY].result > 0)
     {
-        if (strncmp("sae", strval, sizeof(strval)) == 0)
+        if (strncmp("sae", security, sizeof(security)) == 0)
         {
             sta_config->security_type = MMWLAN_SAE;
         }
-        else if (strncmp("owe", strval, sizeof(strval)) == 0)
+        else if (strncmp("owe", security, sizeof(security)) == 0)
         {
             sta_config->security_type = MMWLAN_OWE;
         }
-        else if (strncmp("open", strval, sizeof(strval)) == 0)
+        else if (strncmp("open", security, sizeof(security)) == 0)
         {
             sta_config->security_type = MMWLAN_OPEN;
         }
@@ -225,26 +298,25 @@ void load_mmwlan_sta_args(struct mmwlan_sta_args *sta_config)
 
     /* Load PMF mode */
     sta_config->pmf_mode = PMF_MODE;
-    if (mmconfig_read_string("wlan.pmf_mode", strval, sizeof(strval)) > 0)
+    if (items[ITEM_PMF_MODE].result > 0)
     {
-        if (strncmp("disabled", strval, sizeof(strval)) == 0)
+        if (strncmp("disabled", pmf_mode, sizeof(pmf_mode)) == 0)
         {
             sta_config->pmf_mode = MMWLAN_PMF_DISABLED;
         }
-        else if (strncmp("required", strval, sizeof(strval)) == 0)
+        else if (strncmp("required", pmf_mode, sizeof(pmf_mode)) == 0)
         {
             sta_config->pmf_mode = MMWLAN_PMF_REQUIRED;
         }
     }
 
-    /* Load BSSID */
-    if (mmconfig_read_string("wlan.bssid", strval, sizeof(strval)) > 0)
+    if (items[ITEM_BSSID].result > 0)
     {
         /* Need to provide an array of ints to sscanf otherwise it will overflow */
         int temp[6];
         int i;
 
-        int ret = sscanf(strval,
+        int ret = sscanf(bssid,
                          "%x:%x:%x:%x:%x:%x",
                          &temp[0],
                          &temp[1],
@@ -269,137 +341,189 @@ void load_mmwlan_sta_args(struct mmwlan_sta_args *sta_config)
     }
 
     /* Load STA type */
-    if (mmconfig_read_string("wlan.station_type", strval, sizeof(strval)) > 0)
+    if (items[ITEM_STATION_TYPE].result > 0)
     {
-        if (strncmp("non_sensor", strval, sizeof(strval)) == 0)
+        if (strncmp("non_sensor", station_type, sizeof(station_type)) == 0)
         {
             sta_config->sta_type = MMWLAN_STA_TYPE_NON_SENSOR;
         }
-        else if (strncmp("sensor", strval, sizeof(strval)) == 0)
+        else if (strncmp("sensor", station_type, sizeof(station_type)) == 0)
         {
             sta_config->sta_type = MMWLAN_STA_TYPE_SENSOR;
         }
     }
 
     /* Load CAC if specified */
-    if (mmconfig_read_bool("wlan.cac_enabled", &boolval) == MMCONFIG_OK)
+    if (items[ITEM_CAC_ENABLED].result == MMCONFIG_OK)
     {
-        sta_config->cac_mode = boolval ? MMWLAN_CAC_ENABLED : MMWLAN_CAC_DISABLED;
+        sta_config->cac_mode = cac_enabled ? MMWLAN_CAC_ENABLED : MMWLAN_CAC_DISABLED;
     }
 
     /* Load raw priority if specified */
-    if (mmconfig_read_int("wlan.raw_priority", &intval) == MMCONFIG_OK)
+    if (items[ITEM_RAW_PRIORITY].result == MMCONFIG_OK)
     {
-        sta_config->raw_sta_priority = (int16_t)intval;
+        sta_config->raw_sta_priority = (int16_t)raw_priority;
     }
 
     /* Load scan interval parameters, if specified */
-    if (mmconfig_read_int("wlan.sta_scan_interval_base_s", &intval) == MMCONFIG_OK)
+    if (items[ITEM_SCAN_INTERVAL_BASE_S].result == MMCONFIG_OK)
     {
-        sta_config->scan_interval_base_s = (int16_t)intval;
+        sta_config->scan_interval_base_s = (int16_t)scan_interval_base_s;
     }
-    if (mmconfig_read_int("wlan.sta_scan_interval_limit_s", &intval) == MMCONFIG_OK)
+    if (items[ITEM_SCAN_INTERVAL_LIMIT_S].result == MMCONFIG_OK)
     {
-        sta_config->scan_interval_limit_s = (int16_t)intval;
+        sta_config->scan_interval_limit_s = (int16_t)scan_interval_limit_s;
     }
 }
 
 void load_mmwlan_settings(void)
 {
-    int intval;
-    uint32_t uintval;
-    bool boolval;
-    char strval[32];
+    char power_save_mode[16];
+    bool subbands_enabled;
+    bool sgi_enabled;
+    bool ampdu_enabled;
+    int fragment_threshold;
+    int rts_threshold;
+    uint32_t max_health_check_intvl_ms;
+    uint32_t min_health_check_intvl_ms = 0;
+    char mcs10_mode[16];
+    char duty_cycle_mode[16];
+    struct mmwlan_scan_config scan_config = MMWLAN_SCAN_CONFIG_INIT;
+
+    enum
+    {
+        ITEM_POWER_SAVE_MODE,
+        ITEM_SUBBANDS_ENABLED,
+        ITEM_SGI_ENABLED,
+        ITEM_AMPDU_ENABLED,
+        ITEM_FRAGMENT_THRESHOLD,
+        ITEM_RTS_THRESHOLD,
+        ITEM_MAX_HEALTH_CHECK_INTVL_MS,
+        ITEM_MIN_HEALTH_CHECK_INTVL_MS,
+        ITEM_STA_SCAN_DWELL_TIME_MS,
+        ITEM_NDP_PROBE_ENABLED,
+        ITEM_HOME_CHAN_DWELL_TIME_MS,
+        ITEM_MCS10_MODE,
+        ITEM_DUTY_CYCLE_MODE,
+        NUM_ITEMS
+    };
+
+    struct mmconfig_read_item items[NUM_ITEMS] = {
+        [ITEM_POWER_SAVE_MODE] = MMCONFIG_READ_ITEM_STRING("wlan.power_save_mode",
+                                                           power_save_mode,
+                                                           sizeof(power_save_mode)),
+        [ITEM_SUBBANDS_ENABLED] = MMCONFIG_READ_ITEM_BOOL("wlan.subbands_enabled",
+                                                          &subbands_enabled),
+        [ITEM_SGI_ENABLED] = MMCONFIG_READ_ITEM_BOOL("wlan.sgi_enabled", &sgi_enabled),
+        [ITEM_AMPDU_ENABLED] = MMCONFIG_READ_ITEM_BOOL("wlan.ampdu_enabled", &ampdu_enabled),
+        [ITEM_FRAGMENT_THRESHOLD] = MMCONFIG_READ_ITEM_INT("wlan.fragment_threshold",
+                                                           &fragment_threshold),
+        [ITEM_RTS_THRESHOLD] = MMCONFIG_READ_ITEM_INT("wlan.rts_threshold", &rts_threshold),
+        [ITEM_MAX_HEALTH_CHECK_INTVL_MS] = MMCONFIG_READ_ITEM_UINT32(
+            "wlan.max_health_check_intvl_ms",
+            &max_health_check_intvl_ms),
+        [ITEM_MIN_HEALTH_CHECK_INTVL_MS] = MMCONFIG_READ_ITEM_UINT32(
+            "wlan.min_health_check_intvl_ms",
+            &min_health_check_intvl_ms),
+        [ITEM_STA_SCAN_DWELL_TIME_MS] = MMCONFIG_READ_ITEM_UINT32("wlan.sta_scan_dwell_time_ms",
+                                                                  &scan_config.dwell_time_ms),
+        [ITEM_NDP_PROBE_ENABLED] = MMCONFIG_READ_ITEM_BOOL("wlan.ndp_probe_enabled",
+                                                           &scan_config.ndp_probe_enabled),
+        [ITEM_HOME_CHAN_DWELL_TIME_MS] = MMCONFIG_READ_ITEM_UINT32(
+            "wlan.home_chan_dwell_time_ms",
+            &scan_config.home_channel_dwell_time_ms),
+        [ITEM_MCS10_MODE] = MMCONFIG_READ_ITEM_STRING("wlan.mcs10_mode",
+                                                      mcs10_mode,
+                                                      sizeof(mcs10_mode)),
+        [ITEM_DUTY_CYCLE_MODE] = MMCONFIG_READ_ITEM_STRING("wlan.duty_cycle_mode",
+                                                           duty_cycle_mode,
+                                                           sizeof(duty_cycle_mode)),
+    };
+
+    (void)mmconfig_read_items(items, NUM_ITEMS);
 
     /* Load power save mode */
-    if (mmconfig_read_string("wlan.power_save_mode", strval, sizeof(strval)) > 0)
+    if (items[ITEM_POWER_SAVE_MODE].result > 0)
     {
-        if (strncmp("enabled", strval, sizeof(strval)) == 0)
+        if (strncmp("enabled", power_save_mode, sizeof(power_save_mode)) == 0)
         {
             mmwlan_set_power_save_mode(MMWLAN_PS_ENABLED);
         }
-        else if (strncmp("disabled", strval, sizeof(strval)) == 0)
+        else if (strncmp("disabled", power_save_mode, sizeof(power_save_mode)) == 0)
         {
             mmwlan_set_power_save_mode(MMWLAN_PS_DISABLED);
         }
     }
 
     /* Apply subbands enabled if specified */
-    if (mmconfig_read_bool("wlan.subbands_enabled", &boolval) == MMCONFIG_OK)
+    if (items[ITEM_SUBBANDS_ENABLED].result == MMCONFIG_OK)
     {
-        mmwlan_set_subbands_enabled(boolval);
+        mmwlan_set_subbands_enabled(subbands_enabled);
     }
 
     /* Apply sgi enabled if specified */
-    if (mmconfig_read_bool("wlan.sgi_enabled", &boolval) == MMCONFIG_OK)
+    if (items[ITEM_SGI_ENABLED].result == MMCONFIG_OK)
     {
-        mmwlan_set_sgi_enabled(boolval);
+        mmwlan_set_sgi_enabled(sgi_enabled);
     }
 
     /* Apply ampdu enabled if specified */
-    if (mmconfig_read_bool("wlan.ampdu_enabled", &boolval) == MMCONFIG_OK)
+    if (items[ITEM_AMPDU_ENABLED].result == MMCONFIG_OK)
     {
-        mmwlan_set_ampdu_enabled(boolval);
+        mmwlan_set_ampdu_enabled(ampdu_enabled);
     }
 
     /* Apply fragment threshold if specified */
-    if (mmconfig_read_int("wlan.fragment_threshold", &intval) == MMCONFIG_OK)
+    if (items[ITEM_FRAGMENT_THRESHOLD].result == MMCONFIG_OK)
     {
-        mmwlan_set_fragment_threshold(intval);
+        mmwlan_set_fragment_threshold(fragment_threshold);
     }
 
     /* Apply rts threshold if specified */
-    if (mmconfig_read_int("wlan.rts_threshold", &intval) == MMCONFIG_OK)
+    if (items[ITEM_RTS_THRESHOLD].result == MMCONFIG_OK)
     {
-        mmwlan_set_rts_threshold(intval);
+        mmwlan_set_rts_threshold(rts_threshold);
     }
 
     /* Apply Health check intervals if specified */
-    if (mmconfig_read_uint32("wlan.max_health_check_intvl_ms", &uintval) == MMCONFIG_OK)
+    if (items[ITEM_MAX_HEALTH_CHECK_INTVL_MS].result == MMCONFIG_OK)
     {
         /* If not specified, the minimum is 0 */
-        uint32_t health_check_min = 0;
-        mmconfig_read_uint32("wlan.min_health_check_intvl_ms", &health_check_min);
-        mmwlan_set_health_check_interval(health_check_min, uintval);
+        mmwlan_set_health_check_interval(min_health_check_intvl_ms, max_health_check_intvl_ms);
     }
-    else if (mmconfig_read_uint32("wlan.min_health_check_intvl_ms", &uintval) == MMCONFIG_OK)
+    else if (items[ITEM_MIN_HEALTH_CHECK_INTVL_MS].result == MMCONFIG_OK)
     {
         /* If only minimum is specified, then treat the maximum as unbounded */
-        mmwlan_set_health_check_interval(uintval, UINT32_MAX);
+        mmwlan_set_health_check_interval(min_health_check_intvl_ms, UINT32_MAX);
     }
 
-    struct mmwlan_scan_config scan_config = MMWLAN_SCAN_CONFIG_INIT;
-    (void)mmconfig_read_uint32("wlan.sta_scan_dwell_time_ms", &scan_config.dwell_time_ms);
-    (void)mmconfig_read_bool("wlan.ndp_probe_enabled", &scan_config.ndp_probe_enabled);
-    (void)mmconfig_read_uint32("wlan.home_chan_dwell_time_ms",
-                               &scan_config.home_channel_dwell_time_ms);
     mmwlan_set_scan_config(&scan_config);
 
     /* Apply MCS10 mode if specified */
-    if (mmconfig_read_string("wlan.mcs10_mode", strval, sizeof(strval)) > 0)
+    if (items[ITEM_MCS10_MODE].result > 0)
     {
-        if (strncmp("disabled", strval, sizeof(strval)) == 0)
+        if (strncmp("disabled", mcs10_mode, sizeof(mcs10_mode)) == 0)
         {
             mmwlan_set_mcs10_mode(MMWLAN_MCS10_MODE_DISABLED);
         }
-        else if (strncmp("forced", strval, sizeof(strval)) == 0)
+        else if (strncmp("forced", mcs10_mode, sizeof(mcs10_mode)) == 0)
         {
             mmwlan_set_mcs10_mode(MMWLAN_MCS10_MODE_FORCED);
         }
-        else if (strncmp("auto", strval, sizeof(strval)) == 0)
+        else if (strncmp("auto", mcs10_mode, sizeof(mcs10_mode)) == 0)
         {
             mmwlan_set_mcs10_mode(MMWLAN_MCS10_MODE_AUTO);
         }
     }
 
     /* Apply duty cycle mode if specified */
-    if (mmconfig_read_string("wlan.duty_cycle_mode", strval, sizeof(strval)) > 0)
+    if (items[ITEM_DUTY_CYCLE_MODE].result > 0)
     {
-        if (strncmp("spread", strval, sizeof(strval)) == 0)
+        if (strncmp("spread", duty_cycle_mode, sizeof(duty_cycle_mode)) == 0)
         {
             mmwlan_set_duty_cycle_mode(MMWLAN_DUTY_CYCLE_MODE_SPREAD);
         }
-        else if (strncmp("burst", strval, sizeof(strval)) == 0)
+        else if (strncmp("burst", duty_cycle_mode, sizeof(duty_cycle_mode)) == 0)
         {
             mmwlan_set_duty_cycle_mode(MMWLAN_DUTY_CYCLE_MODE_BURST);
         }
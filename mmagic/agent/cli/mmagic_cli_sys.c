@@ -188,7 +188,9 @@ void mmagic_cli_sys_get_stats(EmbeddedCli *cli, char *args, void *context)
         mmagic_cli_printf(
             cli,
             "%lu %lu %lu [ %lu %lu %lu %lu %lu %lu %lu %lu %lu %lu ] %d %u %u %u %u %u "
-            "%lu %lu %lu %u %lu %lu %lu %lu %lu %lu %lu %lu",
+            "%lu %lu %lu %u %lu %lu %lu %lu %lu %lu %lu %lu %lu %lu "
+            "[ %u %u %u %u ] [ %lu %lu %lu %lu ] [ %lu %lu %lu %lu ] [ %lu %lu %lu %lu ] "
+            "[ %lu %lu %lu %lu ]",
             data->last_tx_time,
             data->datapath_rxq_frames_dropped,
             data->datapath_txq_frames_dropped,
@@ -219,7 +221,29 @@ void mmagic_cli_sys_get_stats(EmbeddedCli *cli, char *args, void *context)
             data->datapath_rx_reorder_total,
             data->timeouts_fired,
             data->datapath_driver_tx_skbq_timeout,
-            data->datapath_driver_tx_pending_status_timeout);
+            data->datapath_driver_tx_pending_status_timeout,
+            data->ap_probe_rsp_sent,
+            data->ap_probe_rsp_suppressed,
+            data->datapath_txq_ac_high_water_mark[0],
+            data->datapath_txq_ac_high_water_mark[1],
+            data->datapath_txq_ac_high_water_mark[2],
+            data->datapath_txq_ac_high_water_mark[3],
+            data->datapath_txq_ac_dequeued[0],
+            data->datapath_txq_ac_dequeued[1],
+            data->datapath_txq_ac_dequeued[2],
+            data->datapath_txq_ac_dequeued[3],
+            data->datapath_txq_ac_sojourn_total_ms[0],
+            data->datapath_txq_ac_sojourn_total_ms[1],
+            data->datapath_txq_ac_sojourn_total_ms[2],
+            data->datapath_txq_ac_sojourn_total_ms[3],
+            data->datapath_txq_ac_sojourn_max_ms[0],
+            data->datapath_txq_ac_sojourn_max_ms[1],
+            data->datapath_txq_ac_sojourn_max_ms[2],
+            data->datapath_txq_ac_sojourn_max_ms[3],
+            data->datapath_txq_ac_aqm_drops[0],
+            data->datapath_txq_ac_aqm_drops[1],
+            data->datapath_txq_ac_aqm_drops[2],
+            data->datapath_txq_ac_aqm_drops[3]);
     }
     else
     {
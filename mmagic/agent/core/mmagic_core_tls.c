@@ -6,13 +6,89 @@
 
 #include "mmosal.h"
 #include "mmutils.h"
+#include "mmconfig.h"
+#include "mmcrc.h"
+#include "transport_interface.h"
 
 #include "core/autogen/mmagic_core_data.h"
 
+/*
+ * TLS sessions are cached by the transport layer so that reconnects (both from the socket
+ * module and from MQTT) can resume rather than performing a full handshake. When
+ * MMAGIC_TLS_PERSIST_SESSION_CACHE is set, the cache is also saved to mmconfig so that sessions
+ * survive a reboot or deep sleep.
+ */
+#ifndef MMAGIC_TLS_PERSIST_SESSION_CACHE
+#define MMAGIC_TLS_PERSIST_SESSION_CACHE (0)
+#endif
+
+#if MMAGIC_TLS_PERSIST_SESSION_CACHE && (TRANSPORT_SESSION_CACHE_SIZE > 0)
+
+/** mmconfig key under which the session cache is persisted. */
+#define MMAGIC_TLS_SESSION_CACHE_KEY "tls.session_cache"
+
+/** CRC of the last persisted session cache, used to avoid rewriting unchanged data. */
+static uint16_t persisted_session_cache_crc;
+
+static void mmagic_core_tls_session_cache_updated(void *arg)
+{
+    size_t len = 0;
+    uint8_t *buf;
+    uint16_t crc;
+
+    MM_UNUSED(arg);
+
+    (void)transport_session_cache_save(NULL, 0, &len);
+    if (len == 0)
+    {
+        mmconfig_delete_key(MMAGIC_TLS_SESSION_CACHE_KEY);
+        persisted_session_cache_crc = 0;
+        return;
+    }
+
+    buf = (uint8_t *)mmosal_malloc(len);
+    if (buf == NULL)
+    {
+        return;
+    }
+
+    if (transport_session_cache_save(buf, len, &len) == 0)
+    {
+        crc = mmcrc_16_xmodem(0, buf, len);
+        if (crc != persisted_session_cache_crc &&
+            mmconfig_write_data(MMAGIC_TLS_SESSION_CACHE_KEY, buf, len) == MMCONFIG_OK)
+        {
+            persisted_session_cache_crc = crc;
+        }
+    }
+
+    mmosal_free(buf);
+}
+
+static void mmagic_core_tls_session_cache_restore(void)
+{
+    void *buf = NULL;
+    int len = mmconfig_alloc_and_load(MMAGIC_TLS_SESSION_CACHE_KEY, &buf);
+
+    if (len > 0 && transport_session_cache_load((const uint8_t *)buf, len) == 0)
+    {
+        persisted_session_cache_crc = mmcrc_16_xmodem(0, buf, len);
+    }
+
+    mmosal_free(buf);
+    transport_session_cache_register_update_callback(mmagic_core_tls_session_cache_updated, NULL);
+}
+
+#endif
+
 void mmagic_core_tls_init(struct mmagic_data *core)
 {
     struct mmagic_tls_data *data = mmagic_data_get_tls(core);
     memset(&data->config, 0, sizeof(data->config));
+
+#if MMAGIC_TLS_PERSIST_SESSION_CACHE && (TRANSPORT_SESSION_CACHE_SIZE > 0)
+    mmagic_core_tls_session_cache_restore();
+#endif
 }
 
 void mmagic_core_tls_start(struct mmagic_data *core)
@@ -0,0 +1,542 @@
+/*
+ * Copyright 2025 Morse Micro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * SPI data-link for the mmagic agent.
+ *
+ * The agent is the SPI slave. Packets are length-prefixed and moved by DMA directly to/from
+ * mmbufs, so no per-byte processing or escaping is required. Every transaction starts with a
+ * header of @c MMAGIC_DATALINK_PAYLOAD_HEADER_SIZE bytes (type followed by little-endian length)
+ * and every payload is followed by a CRC16 (XMODEM).
+ *
+ * Controller to agent (write):
+ *   1. Controller sends header { WRITE, len }.
+ *   2. Agent arms RX DMA for len + CRC bytes and asserts ready.
+ *   3. Controller clocks the payload and CRC.
+ *   4. Agent arms a header { ACK or NACK, 0 } and asserts ready.
+ *   5. Controller clocks the response header.
+ *
+ * Agent to controller (read):
+ *   1. Agent loads { READ, len } into its idle header and asserts ready.
+ *   2. Controller sends header { READ, 0 } and simultaneously receives the idle header.
+ *   3. Agent arms TX DMA from the mmbuf (payload + CRC) and asserts ready.
+ *   4. Controller clocks the payload and CRC.
+ *   5. Controller sends header { ACK, 0 }, or { REREAD, 0 } to have the agent go back to step 3.
+ */
+
+#if defined(ENABLE_MMAGIC_DATALINK_SPI) && ENABLE_MMAGIC_DATALINK_SPI
+
+#if defined(ENABLE_MMAGIC_DATALINK_UART) && ENABLE_MMAGIC_DATALINK_UART
+#error "Only one of ENABLE_MMAGIC_DATALINK_SPI and ENABLE_MMAGIC_DATALINK_UART may be enabled"
+#endif
+
+#include <endian.h>
+#include <stdint.h>
+
+#include "mmagic_datalink_agent.h"
+
+#include "mmcrc.h"
+#include "mmhal_datalink_spi.h"
+#include "mmosal.h"
+#include "mmutils.h"
+
+/** Stack size of the data-link task in 32 bit words. */
+#define SPI_DATALINK_TASK_STACK_SIZE_WORDS (768)
+/** Priority of the data-link task. */
+#define SPI_DATALINK_TASK_PRIORITY (MMOSAL_TASK_PRI_HIGH)
+/** Time to wait for the controller to read a packet before cancelling it (in milliseconds). */
+#define SPI_DATALINK_TX_TIMEOUT_MS (1000)
+
+/** Enumeration of data-link states. */
+enum spi_datalink_state
+{
+    /** Armed to receive a header from the controller. */
+    SPI_DATALINK_STATE_IDLE,
+    /** Armed to receive a payload from the controller. */
+    SPI_DATALINK_STATE_RX_PAYLOAD,
+    /** Armed to transmit a response header to the controller. */
+    SPI_DATALINK_STATE_RX_RESPONSE,
+    /** Armed to transmit a payload to the controller. */
+    SPI_DATALINK_STATE_TX_PAYLOAD,
+    /** Armed to receive the controller's response to a transmitted payload. */
+    SPI_DATALINK_STATE_TX_RESPONSE,
+};
+
+struct mmagic_datalink_agent
+{
+    /** Current state of the data-link. Only accessed from the data-link task. */
+    enum spi_datalink_state state;
+
+    /** Header that is clocked out while idle. Indicates the length of any pending packet. */
+    uint8_t idle_hdr[MMAGIC_DATALINK_PAYLOAD_HEADER_SIZE];
+    /** Buffer into which headers from the controller are received. */
+    uint8_t rx_hdr[MMAGIC_DATALINK_PAYLOAD_HEADER_SIZE];
+    /** Response header to be sent after receiving a payload. */
+    uint8_t resp_hdr[MMAGIC_DATALINK_PAYLOAD_HEADER_SIZE];
+
+    /** The buffer into which a payload is being received. */
+    struct mmbuf *rxbuf;
+    /** Length of the payload being received (excluding CRC). */
+    size_t rx_len;
+
+    /** Buffer pending transmission to the controller (includes CRC). */
+    struct mmbuf *txbuf;
+    /** Set by the transmitter to request that the pending buffer be cancelled. */
+    volatile bool tx_cancel;
+    /** Result of the last transmit. Number of bytes on success or negative on error. */
+    int tx_status;
+    /** Mutex to serialize calls to @ref mmagic_datalink_agent_tx_buffer(). */
+    struct mmosal_mutex *tx_mutex;
+    /** Binary semaphore given by the data-link task when the pending buffer is done with. */
+    struct mmosal_semb *tx_done_semb;
+
+    /** Binary semaphore used to wake the data-link task. */
+    struct mmosal_semb *event_semb;
+    /** Set from the HAL callback when a transaction has completed. */
+    volatile bool xfer_complete;
+    /** Length of the last completed transaction. */
+    volatile size_t xfer_length;
+    /** Handle of the data-link task. */
+    struct mmosal_task *task;
+    /** Set to false to request that the data-link task terminate. */
+    volatile bool task_run;
+    /** Set by the data-link task just before it terminates. */
+    volatile bool task_complete;
+
+    /** Callback to invoke on receive of a valid packet. */
+    mmagic_datalink_agent_rx_buffer_cb_t rx_buffer_callback;
+    /** Opaque argument for @c rx_buffer_callback. */
+    void *rx_buffer_callback_arg;
+    /** The maximum packet size we expect to receive. */
+    size_t max_rx_packet_size;
+};
+
+static void datalink_spi_set_hdr(uint8_t *hdr, enum mmagic_datalink_payload_type type, size_t len)
+{
+    hdr[0] = type;
+    hdr[1] = len & 0xff;
+    hdr[2] = (len >> 8) & 0xff;
+}
+
+static void datalink_spi_arm_idle(struct mmagic_datalink_agent *interface)
+{
+    if (interface->txbuf != NULL)
+    {
+        /* Have the task announce the pending packet again, since the ready line will have been
+         * deasserted by intervening transactions. */
+        interface->idle_hdr[0] = MMAGIC_DATALINK_NACK;
+    }
+    interface->state = SPI_DATALINK_STATE_IDLE;
+    mmhal_datalink_spi_arm(interface->idle_hdr, interface->rx_hdr, sizeof(interface->rx_hdr));
+}
+
+static void datalink_spi_arm_response(struct mmagic_datalink_agent *interface,
+                                      enum mmagic_datalink_payload_type type)
+{
+    datalink_spi_set_hdr(interface->resp_hdr, type, 0);
+    interface->state = SPI_DATALINK_STATE_RX_RESPONSE;
+    mmhal_datalink_spi_arm(interface->resp_hdr, NULL, sizeof(interface->resp_hdr));
+    mmhal_datalink_spi_set_ready(true);
+}
+
+static void datalink_spi_arm_tx_payload(struct mmagic_datalink_agent *interface)
+{
+    interface->state = SPI_DATALINK_STATE_TX_PAYLOAD;
+    mmhal_datalink_spi_arm(mmbuf_get_data_start(interface->txbuf), NULL,
+                           mmbuf_get_data_length(interface->txbuf));
+    mmhal_datalink_spi_set_ready(true);
+}
+
+static void datalink_spi_complete_tx(struct mmagic_datalink_agent *interface, int status)
+{
+    mmbuf_release(interface->txbuf);
+    interface->txbuf = NULL;
+    interface->tx_cancel = false;
+    interface->tx_status = status;
+    datalink_spi_set_hdr(interface->idle_hdr, MMAGIC_DATALINK_NACK, 0);
+    mmosal_semb_give(interface->tx_done_semb);
+}
+
+/**
+ * Abandon whatever the data-link is doing, return to idle and fail the pending transmit. Used
+ * when the transmitter gives up waiting, which may happen in any state if the controller stops
+ * clocking mid-sequence.
+ */
+static void datalink_spi_cancel(struct mmagic_datalink_agent *interface)
+{
+    mmhal_datalink_spi_set_ready(false);
+
+    /* Re-arm before releasing any buffers: arming replaces a transfer that has not yet started,
+     * so the DMA no longer references them. */
+    interface->state = SPI_DATALINK_STATE_IDLE;
+    mmhal_datalink_spi_arm(interface->idle_hdr, interface->rx_hdr, sizeof(interface->rx_hdr));
+
+    mmbuf_release(interface->rxbuf);
+    interface->rxbuf = NULL;
+    datalink_spi_complete_tx(interface, -1);
+}
+
+/**
+ * Handle a header received from the controller while idle (or while waiting for the response
+ * to a transmitted payload).
+ */
+static void datalink_spi_process_hdr(struct mmagic_datalink_agent *interface, size_t length)
+{
+    uint8_t type = interface->rx_hdr[0];
+    size_t len = interface->rx_hdr[1] | (interface->rx_hdr[2] << 8);
+    bool awaiting_response = (interface->state == SPI_DATALINK_STATE_TX_RESPONSE);
+
+    if (length < sizeof(interface->rx_hdr))
+    {
+        /* Runt transaction (e.g., controller reset). Stay in the current state. */
+        mmhal_datalink_spi_arm(interface->idle_hdr, interface->rx_hdr, sizeof(interface->rx_hdr));
+        return;
+    }
+
+    switch (type)
+    {
+        case MMAGIC_DATALINK_WRITE:
+            MMOSAL_ASSERT(interface->rxbuf == NULL);
+            if (len == 0 || len > interface->max_rx_packet_size)
+            {
+                mmosal_printf("Invalid SPI datalink write length %lu\n", (unsigned long)len);
+            }
+            else
+            {
+                interface->rxbuf = mmbuf_alloc_on_heap(0, len + MMAGIC_DATALINK_PAYLOAD_CRC_SIZE);
+            }
+
+            /* If the packet cannot be accepted the payload is still clocked (and discarded) so
+             * that the controller always sees the same sequence of transactions, and the
+             * response will be a NACK. */
+            interface->rx_len = len;
+            interface->state = SPI_DATALINK_STATE_RX_PAYLOAD;
+            mmhal_datalink_spi_arm(NULL,
+                                   (interface->rxbuf == NULL) ?
+                                       NULL :
+                                       mmbuf_get_data_start(interface->rxbuf),
+                                   len + MMAGIC_DATALINK_PAYLOAD_CRC_SIZE);
+            mmhal_datalink_spi_set_ready(true);
+            return;
+
+        case MMAGIC_DATALINK_READ:
+        case MMAGIC_DATALINK_REREAD:
+            /* For a READ the controller must have seen the length of the pending packet in the
+             * idle header that was clocked out alongside its request. */
+            if (interface->txbuf != NULL &&
+                (awaiting_response || interface->idle_hdr[0] == MMAGIC_DATALINK_READ))
+            {
+                datalink_spi_arm_tx_payload(interface);
+                return;
+            }
+            break;
+
+        case MMAGIC_DATALINK_ACK:
+            if (awaiting_response)
+            {
+                datalink_spi_complete_tx(interface,
+                                         mmbuf_get_data_length(interface->txbuf) -
+                                             MMAGIC_DATALINK_PAYLOAD_CRC_SIZE);
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    if (awaiting_response && interface->txbuf != NULL)
+    {
+        /* Still waiting for the controller to acknowledge the payload. */
+        mmhal_datalink_spi_arm(interface->idle_hdr, interface->rx_hdr, sizeof(interface->rx_hdr));
+    }
+    else
+    {
+        datalink_spi_arm_idle(interface);
+    }
+}
+
+static void datalink_spi_process_rx_payload(struct mmagic_datalink_agent *interface, size_t length)
+{
+    struct mmbuf *rxbuf = interface->rxbuf;
+    uint16_t calc_crc;
+    uint16_t rx_crc;
+    uint8_t *rx_crc_buf;
+
+    interface->rxbuf = NULL;
+
+    if (rxbuf == NULL)
+    {
+        goto nack;
+    }
+
+    if (length != interface->rx_len + MMAGIC_DATALINK_PAYLOAD_CRC_SIZE)
+    {
+        mmosal_printf("SPI datalink payload truncated. Dropping...\n");
+        goto nack;
+    }
+
+    mmbuf_append(rxbuf, length);
+    rx_crc_buf = mmbuf_remove_from_end(rxbuf, MMAGIC_DATALINK_PAYLOAD_CRC_SIZE);
+    rx_crc = rx_crc_buf[0] | rx_crc_buf[1] << 8;
+    calc_crc = mmcrc_16_xmodem(0, mmbuf_get_data_start(rxbuf), mmbuf_get_data_length(rxbuf));
+    if (rx_crc != calc_crc)
+    {
+        mmosal_printf("CRC validation failure. Dropping...\n");
+        goto nack;
+    }
+
+    /* Arm the response before handing the buffer up so the controller is not held off while the
+     * upper layer processes the packet. */
+    datalink_spi_arm_response(interface, MMAGIC_DATALINK_ACK);
+    interface->rx_buffer_callback(interface, interface->rx_buffer_callback_arg, rxbuf);
+    return;
+
+nack:
+    mmbuf_release(rxbuf);
+    datalink_spi_arm_response(interface, MMAGIC_DATALINK_NACK);
+}
+
+static void datalink_spi_process_xfer(struct mmagic_datalink_agent *interface, size_t length)
+{
+    switch (interface->state)
+    {
+        case SPI_DATALINK_STATE_IDLE:
+        case SPI_DATALINK_STATE_TX_RESPONSE:
+            datalink_spi_process_hdr(interface, length);
+            break;
+
+        case SPI_DATALINK_STATE_RX_PAYLOAD:
+            datalink_spi_process_rx_payload(interface, length);
+            break;
+
+        case SPI_DATALINK_STATE_RX_RESPONSE:
+            datalink_spi_arm_idle(interface);
+            break;
+
+        case SPI_DATALINK_STATE_TX_PAYLOAD:
+            interface->state = SPI_DATALINK_STATE_TX_RESPONSE;
+            mmhal_datalink_spi_arm(interface->idle_hdr, interface->rx_hdr,
+                                   sizeof(interface->rx_hdr));
+            break;
+    }
+}
+
+static void datalink_spi_task_main(void *arg)
+{
+    struct mmagic_datalink_agent *interface = (struct mmagic_datalink_agent *)arg;
+
+    datalink_spi_arm_idle(interface);
+
+    while (interface->task_run)
+    {
+        mmosal_semb_wait(interface->event_semb, UINT32_MAX);
+
+        if (interface->xfer_complete)
+        {
+            interface->xfer_complete = false;
+            datalink_spi_process_xfer(interface, interface->xfer_length);
+        }
+
+        if (interface->txbuf == NULL)
+        {
+            continue;
+        }
+
+        if (interface->tx_cancel)
+        {
+            datalink_spi_cancel(interface);
+        }
+        else if (interface->state == SPI_DATALINK_STATE_IDLE &&
+                 interface->idle_hdr[0] != MMAGIC_DATALINK_READ)
+        {
+            /* New packet pending. The DMA reads the idle header from memory when the controller
+             * clocks it, so updating it in place before asserting ready is sufficient. */
+            datalink_spi_set_hdr(interface->idle_hdr, MMAGIC_DATALINK_READ,
+                                 mmbuf_get_data_length(interface->txbuf) -
+                                     MMAGIC_DATALINK_PAYLOAD_CRC_SIZE);
+            mmhal_datalink_spi_set_ready(true);
+        }
+    }
+
+    interface->task_complete = true;
+}
+
+/**
+ * Handler for the SPI HAL transfer complete callback. May be invoked from interrupt context.
+ *
+ * @param length Number of bytes clocked in the transaction.
+ * @param arg    Opaque argument -- the data-link handle in our case.
+ */
+static void datalink_spi_xfer_handler(size_t length, void *arg)
+{
+    struct mmagic_datalink_agent *interface = (struct mmagic_datalink_agent *)arg;
+
+    interface->xfer_length = length;
+    interface->xfer_complete = true;
+    mmosal_semb_give_from_isr(interface->event_semb);
+}
+
+struct mmagic_datalink_agent *mmagic_datalink_agent_init(
+    const struct mmagic_datalink_agent_init_args *args)
+{
+    static struct mmagic_datalink_agent ginterface;
+    struct mmagic_datalink_agent *interface = &ginterface;
+
+    memset(interface, 0, sizeof(*interface));
+
+    interface->rx_buffer_callback = args->rx_callback;
+    interface->rx_buffer_callback_arg = args->rx_arg;
+    interface->max_rx_packet_size = args->max_packet_size;
+    if ((interface->rx_buffer_callback == NULL) || (!interface->max_rx_packet_size))
+    {
+        /* These are required fields, do not proceed if not present. */
+        return NULL;
+    }
+
+    /* The length field in the header is 16 bits. */
+    interface->max_rx_packet_size = MM_MIN(interface->max_rx_packet_size, UINT16_MAX);
+
+    datalink_spi_set_hdr(interface->idle_hdr, MMAGIC_DATALINK_NACK, 0);
+
+    interface->tx_mutex = mmosal_mutex_create("mmagic_dl_spi_tx");
+    interface->tx_done_semb = mmosal_semb_create("mmagic_dl_spi_txd");
+    interface->event_semb = mmosal_semb_create("mmagic_dl_spi_evt");
+    if (interface->tx_mutex == NULL || interface->tx_done_semb == NULL ||
+        interface->event_semb == NULL)
+    {
+        goto error;
+    }
+
+    /* Disable deep sleep on startup to ensure we stay awake to receive data */
+    (void)mmagic_datalink_agent_set_deep_sleep_mode(interface,
+                                                    MMAGIC_DATALINK_AGENT_DEEP_SLEEP_DISABLED);
+
+    mmhal_datalink_spi_init(datalink_spi_xfer_handler, interface);
+
+    interface->task_run = true;
+    interface->task = mmosal_task_create(datalink_spi_task_main, interface,
+                                         SPI_DATALINK_TASK_PRIORITY,
+                                         SPI_DATALINK_TASK_STACK_SIZE_WORDS, "mmagic_dl_spi");
+    if (interface->task == NULL)
+    {
+        mmhal_datalink_spi_deinit();
+        goto error;
+    }
+
+    return interface;
+
+error:
+    mmosal_mutex_delete(interface->tx_mutex);
+    mmosal_semb_delete(interface->tx_done_semb);
+    mmosal_semb_delete(interface->event_semb);
+    return NULL;
+}
+
+void mmagic_datalink_agent_deinit(struct mmagic_datalink_agent *interface)
+{
+    mmhal_datalink_spi_deinit();
+
+    interface->task_run = false;
+    mmosal_semb_give(interface->event_semb);
+    while (!interface->task_complete)
+    {
+        mmosal_task_sleep(3);
+    }
+    interface->task = NULL;
+
+    mmbuf_release(interface->rxbuf);
+    interface->rxbuf = NULL;
+    if (interface->txbuf != NULL)
+    {
+        datalink_spi_complete_tx(interface, -1);
+    }
+
+    mmosal_mutex_delete(interface->tx_mutex);
+    mmosal_semb_delete(interface->tx_done_semb);
+    mmosal_semb_delete(interface->event_semb);
+}
+
+struct mmbuf *mmagic_datalink_agent_alloc_buffer_for_tx(size_t header_size, size_t payload_size)
+{
+    return mmbuf_alloc_on_heap(header_size, payload_size + MMAGIC_DATALINK_PAYLOAD_CRC_SIZE);
+}
+
+int mmagic_datalink_agent_tx_buffer(struct mmagic_datalink_agent *interface, struct mmbuf *buf)
+{
+    int ret;
+    size_t packet_len = mmbuf_get_data_length(buf);
+    uint16_t crc;
+
+    if (packet_len == 0 || packet_len > UINT16_MAX)
+    {
+        mmbuf_release(buf);
+        return -1;
+    }
+
+    crc = htole16(mmcrc_16_xmodem(0, mmbuf_get_data_start(buf), packet_len));
+    mmbuf_append_data(buf, (uint8_t *)&crc, sizeof(crc));
+
+    mmosal_mutex_get(interface->tx_mutex, UINT32_MAX);
+
+#if defined(MMAGIC_DATALINK_TRANSMISSION_HOOK_ENABLED) && MMAGIC_DATALINK_TRANSMISSION_HOOK_ENABLED
+    mmagic_datalink_transmission_hook(true);
+#endif
+
+    /* Ownership of the buffer passes to the data-link task, which releases it once the controller
+     * has acknowledged it or it has been cancelled. */
+    interface->txbuf = buf;
+    mmosal_semb_give(interface->event_semb);
+
+    if (!mmosal_semb_wait(interface->tx_done_semb, SPI_DATALINK_TX_TIMEOUT_MS))
+    {
+        /* The buffer may be in the middle of a DMA transfer so we cannot reclaim it here. Ask the
+         * task to cancel it at the next opportunity and wait for it to do so. */
+        interface->tx_cancel = true;
+        mmosal_semb_give(interface->event_semb);
+        mmosal_semb_wait(interface->tx_done_semb, UINT32_MAX);
+
+        /* The transmit may have completed just before the cancel was requested. */
+        interface->tx_cancel = false;
+    }
+    ret = interface->tx_status;
+
+#if defined(MMAGIC_DATALINK_TRANSMISSION_HOOK_ENABLED) && MMAGIC_DATALINK_TRANSMISSION_HOOK_ENABLED
+    mmagic_datalink_transmission_hook(false);
+#endif
+
+    mmosal_mutex_release(interface->tx_mutex);
+    return ret;
+}
+
+bool mmagic_datalink_agent_set_deep_sleep_mode(struct mmagic_datalink_agent *interface,
+                                               enum mmagic_datalink_agent_deep_sleep_mode mode)
+{
+    enum mmhal_datalink_spi_deep_sleep_mode mode_spi;
+
+    MM_UNUSED(interface);
+
+    switch (mode)
+    {
+        case MMAGIC_DATALINK_AGENT_DEEP_SLEEP_DISABLED:
+            mode_spi = MMHAL_DATALINK_SPI_DEEP_SLEEP_DISABLED;
+            break;
+
+        case MMAGIC_DATALINK_AGENT_DEEP_SLEEP_ONE_SHOT:
+            mode_spi = MMHAL_DATALINK_SPI_DEEP_SLEEP_ONE_SHOT;
+            break;
+
+        case MMAGIC_DATALINK_AGENT_DEEP_SLEEP_HARDWARE:
+            mode_spi = MMHAL_DATALINK_SPI_DEEP_SLEEP_HARDWARE;
+            break;
+
+        default:
+            return false;
+    }
+
+    return mmhal_datalink_spi_set_deep_sleep_mode(mode_spi);
+}
+
+#endif
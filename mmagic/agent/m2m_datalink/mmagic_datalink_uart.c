@@ -116,7 +116,7 @@ exit:
  */
 static void datalink_uart_rx_handler(const uint8_t *data, size_t length, void *arg)
 {
-    size_t ii;
+    size_t consumed;
     enum slip_rx_status status;
     struct mmagic_datalink_agent *interface = (struct mmagic_datalink_agent *)arg;
 
@@ -127,9 +127,11 @@ static void datalink_uart_rx_handler(const uint8_t *data, size_t length, void *a
         datalink_init_slip_rx_state(interface);
     }
 
-    for (ii = 0; ii < length; ii++)
+    while (length > 0)
     {
-        status = slip_rx(&interface->slip_rx_state, data[ii]);
+        status = slip_rx_buf(&interface->slip_rx_state, data, length, &consumed);
+        data += consumed;
+        length -= consumed;
         if (status == SLIP_RX_COMPLETE)
         {
             struct mmbuf *rxbuf = interface->rxbuf;
@@ -188,16 +190,16 @@ struct mmbuf *mmagic_datalink_agent_alloc_buffer_for_tx(size_t header_size, size
 }
 
 /**
- * Handler for the CLI transmit callback.
+ * Handler for the SLIP transmit callback.
  *
  * @param data   Data to transmit.
  * @param length Length of data to transmit.
  * @param arg    Opaque argument (unused).
  */
-int datalink_slip_tx_handler(uint8_t c, void *arg)
+static int datalink_slip_tx_handler(const uint8_t *data, size_t length, void *arg)
 {
     MM_UNUSED(arg);
-    mmhal_uart_tx(&c, 1);
+    mmhal_uart_tx(data, length);
     return 0;
 }
 
@@ -222,7 +224,7 @@ int mmagic_datalink_agent_tx_buffer(struct mmagic_datalink_agent *interface, str
     mmagic_datalink_transmission_hook(true);
 #endif
 
-    ret = slip_tx(datalink_slip_tx_handler, interface, mmbuf_get_data_start(buf), packet_len);
+    ret = slip_tx_buf(datalink_slip_tx_handler, interface, mmbuf_get_data_start(buf), packet_len);
 
 #if defined(MMAGIC_DATALINK_TRANSMISSION_HOOK_ENABLED) && MMAGIC_DATALINK_TRANSMISSION_HOOK_ENABLED
     mmagic_datalink_transmission_hook(false);
@@ -36,6 +36,7 @@ extern "C"
 #define MMAGIC_DATALINK_PAYLOAD_LEN_SIZE  (2)
 #define MMAGIC_DATALINK_PAYLOAD_HEADER_SIZE \
     (MMAGIC_DATALINK_PAYLOAD_TYPE_SIZE + MMAGIC_DATALINK_PAYLOAD_LEN_SIZE)
+#define MMAGIC_DATALINK_PAYLOAD_CRC_SIZE  (2)
 
 #if defined(MMAGIC_DATALINK_TRANSMISSION_HOOK_ENABLED) && MMAGIC_DATALINK_TRANSMISSION_HOOK_ENABLED
 /**
@@ -42,6 +42,8 @@ extern "C"
 /** Total size of the transfer header. */
 #define MMAGIC_DATALINK_PAYLOAD_HEADER_SIZE \
     (MMAGIC_DATALINK_PAYLOAD_TYPE_SIZE + MMAGIC_DATALINK_PAYLOAD_LEN_SIZE)
+/** Size of the CRC16 trailer that follows each payload. */
+#define MMAGIC_DATALINK_PAYLOAD_CRC_SIZE (2)
 
 /** Enumeration of data link payload types. */
 enum mmagic_datalink_payload_type
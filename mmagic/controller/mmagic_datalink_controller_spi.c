@@ -0,0 +1,232 @@
+/*
+ * Copyright 2025 Morse Micro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * SPI implementation of the Controller data link. This is the counterpart of the agent's
+ * mmagic_datalink_spi.c; see that file for a description of the framing.
+ *
+ * The platform must provide the functions declared in mmhal_controller_spi.h.
+ */
+
+#if defined(ENABLE_MMAGIC_DATALINK_SPI) && ENABLE_MMAGIC_DATALINK_SPI
+
+#include "mmosal_controller.h"
+#include "mmbuf.h"
+#include "mmcrc.h"
+#include "mmutils.h"
+#include "mmagic_datalink_controller.h"
+#include "mmhal_controller_spi.h"
+
+/** Maximum time to wait for the agent to assert the ready line (in milliseconds). */
+#define SPI_DATALINK_READY_TIMEOUT_MS (100)
+/** Number of times to retry a transfer that failed CRC validation. */
+#define SPI_DATALINK_MAX_RETRIES (3)
+
+struct mmagic_datalink_controller
+{
+    /** Mutex protecting access to the SPI bus. */
+    struct mmosal_mutex *bus_mutex;
+    /** Callback to invoke on receive of a valid packet. */
+    mmagic_datalink_controller_rx_buffer_cb_t rx_buffer_callback;
+    /** Opaque argument for @c rx_buffer_callback. */
+    void *rx_buffer_callback_arg;
+};
+
+static void datalink_spi_set_hdr(uint8_t *hdr, enum mmagic_datalink_payload_type type, size_t len)
+{
+    hdr[0] = type;
+    hdr[1] = len & 0xff;
+    hdr[2] = (len >> 8) & 0xff;
+}
+
+static bool datalink_spi_xfer_hdr(enum mmagic_datalink_payload_type type,
+                                  size_t len,
+                                  uint8_t *rx_hdr)
+{
+    uint8_t tx_hdr[MMAGIC_DATALINK_PAYLOAD_HEADER_SIZE];
+
+    datalink_spi_set_hdr(tx_hdr, type, len);
+    return mmhal_controller_spi_xfer(tx_hdr, rx_hdr, sizeof(tx_hdr));
+}
+
+/**
+ * Read a pending packet from the agent. Must be called with the bus mutex held.
+ */
+static struct mmbuf *datalink_spi_read(void)
+{
+    uint8_t rx_hdr[MMAGIC_DATALINK_PAYLOAD_HEADER_SIZE];
+    struct mmbuf *rxbuf;
+    size_t len;
+    int retries = 0;
+
+    if (!datalink_spi_xfer_hdr(MMAGIC_DATALINK_READ, 0, rx_hdr))
+    {
+        return NULL;
+    }
+
+    len = rx_hdr[1] | (rx_hdr[2] << 8);
+    if (rx_hdr[0] != MMAGIC_DATALINK_READ || len == 0)
+    {
+        /* Spurious ready; the agent had nothing to send. */
+        return NULL;
+    }
+
+    rxbuf = mmbuf_alloc_on_heap(0, len + MMAGIC_DATALINK_PAYLOAD_CRC_SIZE);
+    if (rxbuf == NULL)
+    {
+        return NULL;
+    }
+
+    while (true)
+    {
+        uint8_t *data = mmbuf_get_data_start(rxbuf);
+        uint16_t rx_crc;
+
+        if (!mmhal_controller_spi_wait_ready(SPI_DATALINK_READY_TIMEOUT_MS) ||
+            !mmhal_controller_spi_xfer(NULL, data, len + MMAGIC_DATALINK_PAYLOAD_CRC_SIZE))
+        {
+            break;
+        }
+
+        rx_crc = data[len] | data[len + 1] << 8;
+        if (rx_crc == mmcrc_16_xmodem(0, data, len))
+        {
+            datalink_spi_xfer_hdr(MMAGIC_DATALINK_ACK, 0, NULL);
+            mmbuf_append(rxbuf, len);
+            return rxbuf;
+        }
+
+        if (++retries > SPI_DATALINK_MAX_RETRIES)
+        {
+            /* Acknowledge anyway so the agent does not stall; the packet is dropped and the
+             * upper layer will recover via its sequence numbers. */
+            datalink_spi_xfer_hdr(MMAGIC_DATALINK_ACK, 0, NULL);
+            break;
+        }
+
+        datalink_spi_xfer_hdr(MMAGIC_DATALINK_REREAD, 0, NULL);
+    }
+
+    mmbuf_release(rxbuf);
+    return NULL;
+}
+
+static void datalink_spi_ready_handler(void *arg)
+{
+    struct mmagic_datalink_controller *controller_dl = (struct mmagic_datalink_controller *)arg;
+    struct mmbuf *rxbuf;
+
+    mmosal_mutex_get(controller_dl->bus_mutex, UINT32_MAX);
+    rxbuf = datalink_spi_read();
+    mmosal_mutex_release(controller_dl->bus_mutex);
+
+    if (rxbuf != NULL)
+    {
+        controller_dl->rx_buffer_callback(controller_dl, controller_dl->rx_buffer_callback_arg,
+                                          rxbuf);
+    }
+}
+
+struct mmagic_datalink_controller *mmagic_datalink_controller_init(
+    const struct mmagic_datalink_controller_init_args *args)
+{
+    static struct mmagic_datalink_controller gcontroller_dl;
+    struct mmagic_datalink_controller *controller_dl = &gcontroller_dl;
+
+    memset(controller_dl, 0, sizeof(*controller_dl));
+
+    controller_dl->rx_buffer_callback = args->rx_callback;
+    controller_dl->rx_buffer_callback_arg = args->rx_arg;
+    if (controller_dl->rx_buffer_callback == NULL)
+    {
+        return NULL;
+    }
+
+    controller_dl->bus_mutex = mmosal_mutex_create("mmagic_dl_spi");
+    if (controller_dl->bus_mutex == NULL)
+    {
+        return NULL;
+    }
+
+    if (!mmhal_controller_spi_init(datalink_spi_ready_handler, controller_dl))
+    {
+        mmosal_mutex_delete(controller_dl->bus_mutex);
+        return NULL;
+    }
+
+    return controller_dl;
+}
+
+void mmagic_datalink_controller_deinit(struct mmagic_datalink_controller *controller_dl)
+{
+    mmhal_controller_spi_deinit();
+    mmosal_mutex_delete(controller_dl->bus_mutex);
+    controller_dl->bus_mutex = NULL;
+}
+
+struct mmbuf *mmagic_datalink_controller_alloc_buffer_for_tx(
+    struct mmagic_datalink_controller *controller_dl,
+    size_t header_size,
+    size_t payload_size)
+{
+    MM_UNUSED(controller_dl);
+    return mmbuf_alloc_on_heap(header_size, payload_size + MMAGIC_DATALINK_PAYLOAD_CRC_SIZE);
+}
+
+int mmagic_datalink_controller_tx_buffer(struct mmagic_datalink_controller *controller_dl,
+                                         struct mmbuf *buf)
+{
+    uint8_t resp_hdr[MMAGIC_DATALINK_PAYLOAD_HEADER_SIZE];
+    size_t packet_len = mmbuf_get_data_length(buf);
+    uint16_t crc;
+    uint8_t crc_buf[MMAGIC_DATALINK_PAYLOAD_CRC_SIZE];
+    int retries;
+    int ret = -1;
+
+    if (packet_len == 0 || packet_len > UINT16_MAX)
+    {
+        mmbuf_release(buf);
+        return -1;
+    }
+
+    crc = mmcrc_16_xmodem(0, mmbuf_get_data_start(buf), packet_len);
+    crc_buf[0] = crc & 0xff;
+    crc_buf[1] = crc >> 8;
+    mmbuf_append_data(buf, crc_buf, sizeof(crc_buf));
+
+    mmosal_mutex_get(controller_dl->bus_mutex, UINT32_MAX);
+
+    for (retries = 0; retries <= SPI_DATALINK_MAX_RETRIES; retries++)
+    {
+        if (!datalink_spi_xfer_hdr(MMAGIC_DATALINK_WRITE, packet_len, NULL) ||
+            !mmhal_controller_spi_wait_ready(SPI_DATALINK_READY_TIMEOUT_MS))
+        {
+            continue;
+        }
+
+        /* The agent always accepts the payload transaction, even if it is going to reject the
+         * packet, and reports the outcome in the response header. */
+        if (!mmhal_controller_spi_xfer(mmbuf_get_data_start(buf), NULL,
+                                       mmbuf_get_data_length(buf)) ||
+            !mmhal_controller_spi_wait_ready(SPI_DATALINK_READY_TIMEOUT_MS) ||
+            !mmhal_controller_spi_xfer(NULL, resp_hdr, sizeof(resp_hdr)))
+        {
+            continue;
+        }
+
+        if (resp_hdr[0] == MMAGIC_DATALINK_ACK)
+        {
+            ret = (int)packet_len;
+            break;
+        }
+    }
+
+    mmosal_mutex_release(controller_dl->bus_mutex);
+    mmbuf_release(buf);
+    return ret;
+}
+
+#endif
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2025 Morse Micro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @ingroup MMAGIC
+ * @defgroup MMHAL_CONTROLLER_SPI Morse Micro Controller SPI Hardware Abstraction Layer API
+ *
+ * This API provides the platform specific functions required by the SPI implementation of the
+ * Controller data link (see @ref MMAGIC_DATALINK_CONTROLLER). The controller is the SPI master.
+ * The agent signals the controller using a "ready" line which the platform must monitor.
+ *
+ * @{
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * Function type for the ready line callback.
+ *
+ * @note This callback must be invoked from thread context, not from interrupt context, since the
+ *       data link will perform SPI transactions from within the callback.
+ *
+ * @param arg Opaque argument (as passed in to @ref mmhal_controller_spi_init()).
+ */
+typedef void (*mmhal_controller_spi_ready_cb_t)(void *arg);
+
+/**
+ * Initialize the SPI master interface and the ready line input.
+ *
+ * @param ready_cb     Callback to invoke when the ready line is asserted while the data link is
+ *                     idle (i.e., the agent has data for the controller).
+ * @param ready_cb_arg Opaque argument to be passed to @p ready_cb.
+ *
+ * @returns @c true on success, else @c false.
+ */
+bool mmhal_controller_spi_init(mmhal_controller_spi_ready_cb_t ready_cb, void *ready_cb_arg);
+
+/** Deinitialize the SPI master interface. */
+void mmhal_controller_spi_deinit(void);
+
+/**
+ * Perform a full duplex SPI transaction. CS is asserted for the duration of the transaction.
+ * This function blocks until the transaction has completed and may use DMA.
+ *
+ * @param tx_data Data to transmit. If @c NULL, zeros are transmitted.
+ * @param rx_data Buffer for received data. If @c NULL, received data is discarded.
+ * @param length  Length of the transaction in bytes.
+ *
+ * @returns @c true on success, else @c false.
+ */
+bool mmhal_controller_spi_xfer(const uint8_t *tx_data, uint8_t *rx_data, size_t length);
+
+/**
+ * Wait for the agent to assert the ready line following the last transaction. The agent
+ * deasserts the ready line at the start of every transaction, so only assertions that occur
+ * after the most recent call to @ref mmhal_controller_spi_xfer() satisfy the wait.
+ *
+ * @param timeout_ms Maximum time to wait in milliseconds.
+ *
+ * @returns @c true if the ready line was asserted, @c false on timeout.
+ */
+bool mmhal_controller_spi_wait_ready(uint32_t timeout_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
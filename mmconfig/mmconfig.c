@@ -49,6 +49,41 @@ struct PACKED mmconfig_data_header
     uint8_t data[]; /**< Data blob */
 };
 
+/**
+ * Header preceding each record in the append-only log. The header is followed by a
+ * @c mmconfig_key_header, key, @c mmconfig_data_header and data, exactly as in the base list.
+ */
+struct PACKED mmconfig_log_header
+{
+    uint16_t magic; /**< Contains @ref MMCONFIG_LOG_MAGIC */
+    uint8_t flags; /**< Record flags, see @ref MMCONFIG_LOG_FLAG_DELETED */
+    uint8_t reserved; /**< Reserved, written as 0 */
+    uint32_t checksum; /**< Checksum of the key header, key, data header and data */
+};
+
+/** @c LR (Log Record) in little endian notation */
+#define MMCONFIG_LOG_MAGIC 0x524C
+
+/** Value read from the magic field of an unwritten log slot */
+#define MMCONFIG_LOG_ERASED ((MMHAL_FLASH_ERASE_VALUE << 8) | MMHAL_FLASH_ERASE_VALUE)
+
+/** Log record flag indicating that the key has been deleted */
+#define MMCONFIG_LOG_FLAG_DELETED 0x01
+
+/**
+ * Alignment of log records within the partition. This must be a power of 2 and at least the
+ * programming granularity of the flash, since flash words are never programmed twice.
+ */
+#ifndef MMCONFIG_LOG_ALIGN
+#define MMCONFIG_LOG_ALIGN 16
+#endif
+
+/** Rounds @p x up to a multiple of @ref MMCONFIG_LOG_ALIGN */
+#define MMCONFIG_LOG_ALIGN_UP(x) (((x) + MMCONFIG_LOG_ALIGN - 1) & ~(MMCONFIG_LOG_ALIGN - 1))
+
+/** Initial number of slots in the RAM key index, must be a power of 2 */
+#define MMCONFIG_INDEX_MIN_SIZE 16
+
 /** Pointer to primary MMCONFIG partition */
 static struct mmconfig_partition_header *mmconfig_primary_image = NULL;
 
@@ -58,6 +93,28 @@ static struct mmconfig_partition_header *mmconfig_secondary_image = NULL;
 /** Length of each partition in bytes */
 static uint32_t mmconfig_partition_size = 0;
 
+/** Offset in the primary image at which the next log record will be written */
+static uint32_t mmconfig_log_end = 0;
+
+/** Set if the log contains a damaged record, in which case the next write compacts the store */
+static bool mmconfig_log_dirty = false;
+
+/**
+ * Open addressed hash table mapping each live key to the offset of its key header in the primary
+ * image. A value of 0 marks an empty slot (offset 0 is the partition header). If NULL, lookups
+ * fall back to scanning the partition.
+ */
+static uint32_t *mmconfig_index = NULL;
+
+/** Number of slots in @c mmconfig_index */
+static uint32_t mmconfig_index_size = 0;
+
+/** Number of used slots in @c mmconfig_index */
+static uint32_t mmconfig_index_count = 0;
+
+/** Flash usage statistics since boot */
+static struct mmconfig_stats mmconfig_stats;
+
 /** A default mm_litral_configs to avoid compile failure if the user
  * doesn't define mm_litral_configs in the application code.
  */
@@ -465,6 +522,437 @@ static int mmconfig_validate_partition(struct mmconfig_partition_header *partiti
     return MMCONFIG_OK;
 }
 
+/**
+ * Returns the data header that follows the given key header.
+ *
+ * @param  keyheader The key header of a base list entry or log record.
+ * @return           The data header of the entry.
+ */
+static struct mmconfig_data_header *mmconfig_get_data_header(
+    const struct mmconfig_key_header *keyheader)
+{
+    return (struct mmconfig_data_header *)(keyheader->key + keyheader->key_len);
+}
+
+/**
+ * Returns the number of bytes occupied by a key/data entry, excluding any log header.
+ *
+ * @param  keyheader The key header of a base list entry or log record.
+ * @return           The size of the key header, key, data header and data in bytes.
+ */
+static size_t mmconfig_get_entry_size(const struct mmconfig_key_header *keyheader)
+{
+    return sizeof(struct mmconfig_key_header) +
+           keyheader->key_len +
+           sizeof(struct mmconfig_data_header) +
+           mmconfig_get_data_header(keyheader)->data_len;
+}
+
+/**
+ * Returns the next entry in the base list of the given partition.
+ *
+ * @param  partition The partition being walked.
+ * @param  keyheader The current entry, or NULL to get the first entry.
+ * @return           The next entry, or NULL at the end of the list.
+ */
+static struct mmconfig_key_header *mmconfig_next_base_entry(
+    const struct mmconfig_partition_header *partition,
+    const struct mmconfig_key_header *keyheader)
+{
+    struct mmconfig_key_header *next;
+
+    if (keyheader == NULL)
+    {
+        next = (struct mmconfig_key_header *)(partition->data);
+    }
+    else
+    {
+        next = (struct mmconfig_key_header *)((uint8_t *)keyheader +
+                                              mmconfig_get_entry_size(keyheader));
+    }
+
+    /* The list is terminated by a key_len of @c LIST_TERMINATOR or 0 */
+    if ((next->key_len == LIST_TERMINATOR) ||
+        (next->key_len == 0) ||
+        ((uint32_t)next >= (uint32_t)partition + mmconfig_partition_size))
+    {
+        return NULL;
+    }
+
+    return next;
+}
+
+/**
+ * Finds the offset at which the log starts in the given partition. The log starts at the first
+ * aligned offset after the base list terminator, so firmware that predates the log sees only the
+ * base list.
+ *
+ * @param  partition The partition.
+ * @return           Offset of the first log record from the start of the partition.
+ */
+static uint32_t mmconfig_get_log_start(const struct mmconfig_partition_header *partition)
+{
+    const struct mmconfig_key_header *keyheader = NULL;
+    const struct mmconfig_key_header *next;
+    uint32_t terminator;
+
+    while ((next = mmconfig_next_base_entry(partition, keyheader)) != NULL)
+    {
+        keyheader = next;
+    }
+
+    if (keyheader == NULL)
+    {
+        terminator = sizeof(struct mmconfig_partition_header);
+    }
+    else
+    {
+        terminator = ((uint32_t)keyheader - (uint32_t)partition) +
+                     mmconfig_get_entry_size(keyheader);
+    }
+
+    return MMCONFIG_LOG_ALIGN_UP(terminator + 1);
+}
+
+/**
+ * Validates the log record at the given offset of the primary image.
+ *
+ * @param  offset Offset of the log record from the start of the primary image.
+ * @param  erased Set to true if the slot has never been written.
+ * @return        The log header if the record is complete and its checksum matches, else NULL.
+ */
+static struct mmconfig_log_header *mmconfig_get_log_record(uint32_t offset, bool *erased)
+{
+    *erased = false;
+
+    if (offset + sizeof(struct mmconfig_log_header) + sizeof(struct mmconfig_key_header) >
+        mmconfig_partition_size)
+    {
+        *erased = true;
+        return NULL;
+    }
+
+    struct mmconfig_log_header *logheader =
+        (struct mmconfig_log_header *)((uint8_t *)mmconfig_primary_image + offset);
+    if (logheader->magic != MMCONFIG_LOG_MAGIC)
+    {
+        *erased = (logheader->magic == MMCONFIG_LOG_ERASED);
+        return NULL;
+    }
+
+    struct mmconfig_key_header *keyheader = (struct mmconfig_key_header *)(logheader + 1);
+    if ((keyheader->key_len == 0) || (keyheader->key_len > MMCONFIG_MAX_KEYLEN) ||
+        (offset + sizeof(*logheader) + sizeof(*keyheader) + keyheader->key_len +
+         sizeof(struct mmconfig_data_header) > mmconfig_partition_size))
+    {
+        return NULL;
+    }
+
+    size_t entry_size = mmconfig_get_entry_size(keyheader);
+    if (offset + sizeof(*logheader) + entry_size > mmconfig_partition_size)
+    {
+        return NULL;
+    }
+
+    uint32_t checksum = XORHASH_SEED;
+    mmconfig_update_checksum(&checksum, (uint8_t *)keyheader, entry_size);
+    if (checksum != logheader->checksum)
+    {
+        return NULL;
+    }
+
+    return logheader;
+}
+
+/**
+ * Returns the number of bytes occupied by a log record including its header and padding.
+ *
+ * @param  logheader The log record.
+ * @return           The size of the record in bytes.
+ */
+static uint32_t mmconfig_get_log_record_size(const struct mmconfig_log_header *logheader)
+{
+    const struct mmconfig_key_header *keyheader =
+        (const struct mmconfig_key_header *)(logheader + 1);
+    return MMCONFIG_LOG_ALIGN_UP(sizeof(*logheader) + mmconfig_get_entry_size(keyheader));
+}
+
+/**
+ * Computes a case insensitive hash of a key.
+ *
+ * @param  key     The key.
+ * @param  key_len The length of the key.
+ * @return         The hash value.
+ */
+static uint32_t mmconfig_key_hash(const char *key, size_t key_len)
+{
+    /* FNV-1a */
+    uint32_t hash = 2166136261u;
+
+    while (key_len--)
+    {
+        hash ^= (uint8_t)toupper(*key++);
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+/**
+ * Returns the key header referenced by an index slot value.
+ *
+ * @param  offset The slot value.
+ * @return        Pointer to the key header in the primary image.
+ */
+static struct mmconfig_key_header *mmconfig_index_get_entry(uint32_t offset)
+{
+    return (struct mmconfig_key_header *)((uint8_t *)mmconfig_primary_image + offset);
+}
+
+/**
+ * Finds the index slot for the given key.
+ *
+ * @param  key     The key.
+ * @param  key_len The length of the key.
+ * @return         The slot holding the key, or the empty slot at which it would be inserted.
+ */
+static uint32_t mmconfig_index_find_slot(const char *key, size_t key_len)
+{
+    uint32_t mask = mmconfig_index_size - 1;
+    uint32_t slot = mmconfig_key_hash(key, key_len) & mask;
+
+    while (mmconfig_index[slot] != 0)
+    {
+        const struct mmconfig_key_header *keyheader =
+            mmconfig_index_get_entry(mmconfig_index[slot]);
+        if (mmconfig_key_match(key, key_len, keyheader->key, keyheader->key_len))
+        {
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    return slot;
+}
+
+/**
+ * Releases the RAM index. Lookups will fall back to scanning the partition.
+ */
+static void mmconfig_index_free(void)
+{
+    mmosal_free(mmconfig_index);
+    mmconfig_index = NULL;
+    mmconfig_index_size = 0;
+    mmconfig_index_count = 0;
+}
+
+/**
+ * Resizes the RAM index, rehashing all entries.
+ *
+ * @param  size The new number of slots, must be a power of 2.
+ * @return      True on success. On failure the index is released.
+ */
+static bool mmconfig_index_resize(uint32_t size)
+{
+    uint32_t *old_index = mmconfig_index;
+    uint32_t old_size = mmconfig_index_size;
+    uint32_t ii;
+
+    mmconfig_index = (uint32_t *)mmosal_malloc(size * sizeof(*mmconfig_index));
+    if (mmconfig_index == NULL)
+    {
+        mmosal_free(old_index);
+        mmconfig_index_size = 0;
+        mmconfig_index_count = 0;
+        return false;
+    }
+
+    memset(mmconfig_index, 0, size * sizeof(*mmconfig_index));
+    mmconfig_index_size = size;
+
+    for (ii = 0; ii < old_size; ii++)
+    {
+        if (old_index[ii] != 0)
+        {
+            const struct mmconfig_key_header *keyheader = mmconfig_index_get_entry(old_index[ii]);
+            mmconfig_index[mmconfig_index_find_slot(keyheader->key, keyheader->key_len)] =
+                old_index[ii];
+        }
+    }
+
+    mmosal_free(old_index);
+    return true;
+}
+
+/**
+ * Records the given entry as the live entry for its key.
+ *
+ * @param keyheader The key header of the entry in the primary image.
+ */
+static void mmconfig_index_set(const struct mmconfig_key_header *keyheader)
+{
+    if (mmconfig_index == NULL)
+    {
+        return;
+    }
+
+    /* Keep the load factor at or below 3/4 */
+    if (((mmconfig_index_count + 1) * 4 > mmconfig_index_size * 3) &&
+        !mmconfig_index_resize(mmconfig_index_size * 2))
+    {
+        return;
+    }
+
+    uint32_t slot = mmconfig_index_find_slot(keyheader->key, keyheader->key_len);
+    if (mmconfig_index[slot] == 0)
+    {
+        mmconfig_index_count++;
+    }
+    mmconfig_index[slot] = (uint32_t)keyheader - (uint32_t)mmconfig_primary_image;
+}
+
+/**
+ * Removes a key from the RAM index.
+ *
+ * @param key     The key.
+ * @param key_len The length of the key.
+ */
+static void mmconfig_index_remove(const char *key, size_t key_len)
+{
+    if (mmconfig_index == NULL)
+    {
+        return;
+    }
+
+    uint32_t mask = mmconfig_index_size - 1;
+    uint32_t hole = mmconfig_index_find_slot(key, key_len);
+    uint32_t next;
+
+    if (mmconfig_index[hole] == 0)
+    {
+        return;
+    }
+
+    /* Shift back any following entries that would no longer be reachable across the hole */
+    for (next = (hole + 1) & mask; mmconfig_index[next] != 0; next = (next + 1) & mask)
+    {
+        const struct mmconfig_key_header *keyheader =
+            mmconfig_index_get_entry(mmconfig_index[next]);
+        uint32_t home = mmconfig_key_hash(keyheader->key, keyheader->key_len) & mask;
+
+        if (((next - home) & mask) >= ((next - hole) & mask))
+        {
+            mmconfig_index[hole] = mmconfig_index[next];
+            hole = next;
+        }
+    }
+
+    mmconfig_index[hole] = 0;
+    mmconfig_index_count--;
+}
+
+/**
+ * Finds the live entry for a key in the primary image.
+ *
+ * @param  key     The key, which must not contain a wildcard.
+ * @param  key_len The length of the key.
+ * @return         The key header of the live entry, or NULL if the key is not present.
+ */
+static struct mmconfig_key_header *mmconfig_find_entry(const char *key, size_t key_len)
+{
+    struct mmconfig_key_header *found = NULL;
+    struct mmconfig_key_header *keyheader = NULL;
+
+    if (mmconfig_index != NULL)
+    {
+        uint32_t slot = mmconfig_index_find_slot(key, key_len);
+        return mmconfig_index[slot] ? mmconfig_index_get_entry(mmconfig_index[slot]) : NULL;
+    }
+
+    /* No index, so scan the base list and then replay the log */
+    while ((keyheader = mmconfig_next_base_entry(mmconfig_primary_image, keyheader)) != NULL)
+    {
+        if (mmconfig_key_match(key, key_len, keyheader->key, keyheader->key_len))
+        {
+            found = keyheader;
+            break;
+        }
+    }
+
+    uint32_t offset = mmconfig_get_log_start(mmconfig_primary_image);
+    while (offset < mmconfig_log_end)
+    {
+        bool erased;
+        struct mmconfig_log_header *logheader = mmconfig_get_log_record(offset, &erased);
+        if (logheader == NULL)
+        {
+            break;
+        }
+
+        keyheader = (struct mmconfig_key_header *)(logheader + 1);
+        if (mmconfig_key_match(key, key_len, keyheader->key, keyheader->key_len))
+        {
+            found = (logheader->flags & MMCONFIG_LOG_FLAG_DELETED) ? NULL : keyheader;
+        }
+        offset += mmconfig_get_log_record_size(logheader);
+    }
+
+    return found;
+}
+
+/**
+ * Checks whether the given entry is the live entry for its key.
+ *
+ * @param  keyheader The key header of a base list entry or log record.
+ * @return           True if the entry has not been superseded or deleted.
+ */
+static bool mmconfig_entry_is_live(const struct mmconfig_key_header *keyheader)
+{
+    return mmconfig_find_entry(keyheader->key, keyheader->key_len) == keyheader;
+}
+
+/**
+ * Builds the RAM index from the primary image by walking the base list and then replaying the
+ * log. This also locates the end of the log and detects damaged log records.
+ */
+static void mmconfig_build_index(void)
+{
+    struct mmconfig_key_header *keyheader = NULL;
+
+    mmconfig_index_free();
+    mmconfig_index_resize(MMCONFIG_INDEX_MIN_SIZE);
+
+    while ((keyheader = mmconfig_next_base_entry(mmconfig_primary_image, keyheader)) != NULL)
+    {
+        mmconfig_index_set(keyheader);
+    }
+
+    mmconfig_log_dirty = false;
+    mmconfig_log_end = mmconfig_get_log_start(mmconfig_primary_image);
+    while (true)
+    {
+        bool erased;
+        struct mmconfig_log_header *logheader = mmconfig_get_log_record(mmconfig_log_end, &erased);
+        if (logheader == NULL)
+        {
+            /* Anything other than erased flash means a write was interrupted */
+            mmconfig_log_dirty = !erased;
+            break;
+        }
+
+        keyheader = (struct mmconfig_key_header *)(logheader + 1);
+        if (logheader->flags & MMCONFIG_LOG_FLAG_DELETED)
+        {
+            mmconfig_index_remove(keyheader->key, keyheader->key_len);
+        }
+        else
+        {
+            mmconfig_index_set(keyheader);
+        }
+        mmconfig_log_end += mmconfig_get_log_record_size(logheader);
+    }
+}
+
 /**
  * Erases the blocks of flash pointed to by the address and the specified size.
  *
@@ -488,12 +976,26 @@ static int mmconfig_erase_partition(struct mmconfig_partition_header *partition,
         /* This function is expected to erase all bytes in the flash block to @c
          * MMHAL_FLASH_ERASE_VALUE. */
         mmhal_flash_erase(block_address);
+        mmconfig_stats.blocks_erased++;
         block_address += block_size;
     }
 
     return MMCONFIG_OK;
 }
 
+/**
+ * Writes to flash, keeping count of the number of bytes programmed.
+ *
+ * @param address The flash address to write to.
+ * @param data    The data to write.
+ * @param size    The length of the data in bytes.
+ */
+static void mmconfig_flash_write(uint32_t address, const uint8_t *data, size_t size)
+{
+    mmhal_flash_write(address, data, size);
+    mmconfig_stats.bytes_written += size;
+}
+
 /** A temporary staging buffer for flash writes. We choose a staging buffer
  *  size of 128 bytes to get the best burst performance from all supported platforms.
  */
@@ -522,9 +1024,9 @@ static void mmconfig_buffered_write(const uint8_t *data, size_t size)
                data,
                sizeof(mmconfig_staging_buffer) - mmconfig_buffer_index);
 
-        mmhal_flash_write((uint32_t)mmconfig_flashing_address,
-                          mmconfig_staging_buffer,
-                          sizeof(mmconfig_staging_buffer));
+        mmconfig_flash_write((uint32_t)mmconfig_flashing_address,
+                             mmconfig_staging_buffer,
+                             sizeof(mmconfig_staging_buffer));
         data += sizeof(mmconfig_staging_buffer) - mmconfig_buffer_index;
         size -= sizeof(mmconfig_staging_buffer) - mmconfig_buffer_index;
         mmconfig_flashing_address += sizeof(mmconfig_staging_buffer);
@@ -558,6 +1060,19 @@ static void mmconfig_buffered_write_wrapper(uint32_t *checksum, const uint8_t *d
     mmconfig_buffered_write(data, size);
 }
 
+/**
+ * Initializes the staging buffer prior to streaming data to flash.
+ *
+ * @param address The flash address to start writing at.
+ */
+static void mmconfig_start_appending(uint32_t address)
+{
+    /* Initialise Flashing buffer with erase values */
+    memset(mmconfig_staging_buffer, MMHAL_FLASH_ERASE_VALUE, sizeof(mmconfig_staging_buffer));
+    mmconfig_buffer_index = 0;
+    mmconfig_flashing_address = address;
+}
+
 /**
  * Initializes the staging buffer and partition header prior to streaming data to flash.
  *
@@ -569,10 +1084,7 @@ static void mmconfig_start_flashing(struct mmconfig_partition_header *partition,
                                     uint32_t version,
                                     uint32_t checksum)
 {
-    /* Initialise Flashing buffer with erase values */
-    memset(mmconfig_staging_buffer, MMHAL_FLASH_ERASE_VALUE, sizeof(mmconfig_staging_buffer));
-    mmconfig_buffer_index = 0;
-    mmconfig_flashing_address = (uint32_t)partition;
+    mmconfig_start_appending((uint32_t)partition);
 
     /* Write partition header */
     struct mmconfig_partition_header partition_header = {
@@ -589,116 +1101,117 @@ static void mmconfig_start_flashing(struct mmconfig_partition_header *partition,
 static void mmconfig_end_flashing(void)
 {
     /* Write any unwritten data */
-    mmhal_flash_write((uint32_t)mmconfig_flashing_address,
-                      mmconfig_staging_buffer,
-                      mmconfig_buffer_index);
+    mmconfig_flash_write((uint32_t)mmconfig_flashing_address,
+                         mmconfig_staging_buffer,
+                         mmconfig_buffer_index);
 }
 
 /**
- * Works through all keys stored in the flash to identify those unaffected by proposed update.
- *
- * This function contains the common code for comparing each key in the flash against each key in
- * the update list.  If there is no match in the update list then the key and data will be retained
- * unchanged when the update is applied.  Otherwise, the key/data in the flash is skipped over as
- * it is invalidated by the update.
+ * Checks whether the given entry is matched by any node in the update list.
+ *
+ * @param  node_list Pointer to a linked list of nodes comprising a potential update.
+ * @param  keyheader The key header of the entry in flash.
+ * @return           True if the entry will be replaced or deleted by the update.
+ */
+static bool mmconfig_entry_in_node_list(const struct mmconfig_update_node *node_list,
+                                        const struct mmconfig_key_header *keyheader)
+{
+    const struct mmconfig_update_node *node;
+
+    for (node = node_list; node != NULL; node = node->next)
+    {
+        if (mmconfig_key_match(node->key, strlen(node->key), keyheader->key, keyheader->key_len))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Works through all live keys stored in the flash to identify those unaffected by proposed update.
+ *
+ * This function contains the common code for comparing each live key in the flash against each key
+ * in the update list. Live keys are the entries in the base list and the log that have not been
+ * superseded by a later log record. If there is no match in the update list then the key and data
+ * will be retained unchanged when the update is applied.  Otherwise, the key/data in the flash is
+ * skipped over as it is invalidated by the update.
  *
  * The resulting action is taken by the given @c retain_entry_fn function. In practice, this is
  * either:
  *  - mmconfig_update_checksum - to add the key and associated data to the new checksum being
  *    calculated.  This may be a prelude to a write, for which the checksum is needed up front for
  *    the partition header.  Alternatively it may be for the side effect of calculating how much
- *    space will be freed if the update is applied (output in @c keyheader_ptr_out and
- *    @c skipped_key_space_out).
+ *    space will be used if the update is applied (output in @c retained_space_out).
  *
  *  - mmconfig_buffered_write_wrapper - to write the key and associated data to the new partition.
  *    In this case only the write itself is of interest and the checksum is unlikely to be
- *    calculated as it has already been written into the header.  skipped_key_space_out is unlikely
- *    to be of interest at this stage.
+ *    calculated as it has already been written into the header.
  *
  *  In both cases the data pointer and size provided to @c retain_entry_fn is the start of the raw
- * data
- *  in the current flash partition, including the key header, key, data header and data.
+ * data in the current flash partition, including the key header, key, data header and data but
+ * excluding any log header.
  *
  * This function deals only with filtering out keys in the flash that are also in the update list.
  * It is up to the caller to actually add the keys in the update list.
  *
- * @param retain_entry_fn       Function to call when key/data in flash is not in update list
- * @param node_list             Pointer to a linked list of nodes comprising a potential update
- * @param keyheader_ptr_out     Output pointer to the first byte after the final key in the
- *                              current flash partition.  May be used by the caller in conjunction
- *                              with skipped_key_space_out to determine how much space is available
- *                              in the new partition
- * @param checksum_out          Output pointer to the calculated checksum, if supported by
- *                              @c retain_entry_fn
- * @param skipped_key_space_out The number of bytes skipped over because the key was found in the
- *                              update list.
+ * @param retain_entry_fn    Function to call when key/data in flash is not in update list
+ * @param node_list          Pointer to a linked list of nodes comprising a potential update
+ * @param checksum_out       Output pointer to the calculated checksum, if supported by
+ *                           @c retain_entry_fn
+ * @param retained_space_out The number of bytes retained from the current flash partition.
  */
 static void mmconfig_process_existing_storage(
     void (*retain_entry_fn)(uint32_t *checksum, const uint8_t *data, size_t size),
     const struct mmconfig_update_node *node_list,
-    struct mmconfig_key_header **keyheader_ptr_out,
     uint32_t *checksum_out,
-    uint32_t *skipped_key_space_out)
+    uint32_t *retained_space_out)
 {
-    uint32_t skipped_key_space = 0;
+    uint32_t retained_space = 0;
 
     /* Initialise checksum although it may not be computed, depending on retain_entry_fn() */
     uint32_t checksum = XORHASH_SEED;
 
-    /* Provide limited protection against mmconfig_primary_image changing under us */
-    struct mmconfig_partition_header *mmconfig_current_image = mmconfig_primary_image;
-
-    /* Find the first keyheader which is at the end of mmconfig_partition_header */
-    struct mmconfig_key_header *keyheader_ptr =
-        (struct mmconfig_key_header *)(mmconfig_current_image->data);
+    struct mmconfig_key_header *keyheader_ptr = NULL;
 
-    /* Loop till we find a terminator marked by key_len of @c LIST_TERMINATOR or 0 */
-    while ((keyheader_ptr->key_len != LIST_TERMINATOR) &&
-           (keyheader_ptr->key_len != 0) &&
-           ((uint32_t)keyheader_ptr < (uint32_t)mmconfig_current_image + mmconfig_partition_size))
+    /* Base list first, skipping entries superseded by the log */
+    while ((keyheader_ptr = mmconfig_next_base_entry(mmconfig_primary_image,
+                                                     keyheader_ptr)) != NULL)
     {
-        /* Find data header and data */
-        struct mmconfig_data_header *dataheader_ptr =
-            (struct mmconfig_data_header *)(keyheader_ptr->key + keyheader_ptr->key_len);
-        uint8_t *data_ptr = dataheader_ptr->data;
-
-        const struct mmconfig_update_node *node = node_list;
-
-        while (node != NULL)
+        if (mmconfig_entry_is_live(keyheader_ptr) &&
+            !mmconfig_entry_in_node_list(node_list, keyheader_ptr))
         {
-            /* If the key in the flash matches any node in the update list, exclude it */
-            if (mmconfig_key_match(node->key,
-                                   strlen(node->key),
-                                   keyheader_ptr->key,
-                                   keyheader_ptr->key_len))
-            {
-                skipped_key_space += sizeof(struct mmconfig_key_header) +
-                                     keyheader_ptr->key_len +
-                                     sizeof(struct mmconfig_data_header) +
-                                     dataheader_ptr->data_len;
-                break;
-            }
-            node = node->next;
+            size_t bytecount = mmconfig_get_entry_size(keyheader_ptr);
+            retain_entry_fn(&checksum, (uint8_t *)keyheader_ptr, bytecount);
+            retained_space += bytecount;
         }
+    }
 
-        if (node == NULL)
+    /* Then the latest log record for each key that is still live */
+    uint32_t offset = mmconfig_get_log_start(mmconfig_primary_image);
+    while (offset < mmconfig_log_end)
+    {
+        bool erased;
+        struct mmconfig_log_header *logheader = mmconfig_get_log_record(offset, &erased);
+        if (logheader == NULL)
         {
-            /* Key in flash does not match any update node, so compute number of bytes to retain */
-            size_t bytecount = sizeof(struct mmconfig_key_header) +
-                               keyheader_ptr->key_len +
-                               sizeof(struct mmconfig_data_header) +
-                               dataheader_ptr->data_len;
+            break;
+        }
 
-            /* Retain key header, key name, data header and data */
+        keyheader_ptr = (struct mmconfig_key_header *)(logheader + 1);
+        if (!(logheader->flags & MMCONFIG_LOG_FLAG_DELETED) &&
+            mmconfig_entry_is_live(keyheader_ptr) &&
+            !mmconfig_entry_in_node_list(node_list, keyheader_ptr))
+        {
+            size_t bytecount = mmconfig_get_entry_size(keyheader_ptr);
             retain_entry_fn(&checksum, (uint8_t *)keyheader_ptr, bytecount);
+            retained_space += bytecount;
         }
-
-        /* Move to next record */
-        keyheader_ptr = (struct mmconfig_key_header *)(data_ptr + dataheader_ptr->data_len);
+        offset += mmconfig_get_log_record_size(logheader);
     }
 
-    *keyheader_ptr_out = keyheader_ptr;
-    *skipped_key_space_out = skipped_key_space;
+    *retained_space_out = retained_space;
     *checksum_out = checksum;
 }
 
@@ -726,17 +1239,13 @@ static uint32_t mmconfig_compute_new_checksum(const struct mmconfig_update_node
         return MMCONFIG_ERR_NOT_SUPPORTED;
     }
 
-    struct mmconfig_key_header *keyheader_ptr;
-    uint32_t skipped_key_space;
+    uint32_t retained_space;
 
-    /* Process existing storage to checksum items to be retained and count up bytes freed
-     * for items that will be deleted or replaced.
-     */
+    /* Process existing storage to checksum items to be retained and count up the bytes they use */
     mmconfig_process_existing_storage(mmconfig_update_checksum,
                                       node_list,
-                                      &keyheader_ptr,
                                       checksum,
-                                      &skipped_key_space);
+                                      &retained_space);
 
     /* Checksum new and updated data items and check there is sufficient space to store them all */
     const struct mmconfig_update_node *node = node_list;
@@ -774,8 +1283,8 @@ static uint32_t mmconfig_compute_new_checksum(const struct mmconfig_update_node
     }
 
     /* Check that we won't exceed available space in partition */
-    uint32_t space_required = ((uint32_t)keyheader_ptr - (uint32_t)mmconfig_primary_image) +
-                              (required_space - skipped_key_space);
+    uint32_t space_required = sizeof(struct mmconfig_partition_header) +
+                              retained_space + required_space;
     uint32_t space_available = mmconfig_partition_size;
 
     if (bytes_remaining != NULL)
@@ -829,16 +1338,14 @@ static int mmconfig_update_secondary_image(const struct mmconfig_update_node *no
                             mmconfig_primary_image->version + 1,
                             checksum);
 
-    struct mmconfig_key_header *keyheader_ptr;
-    uint32_t skipped_key_space;
+    uint32_t retained_space;
     uint32_t rechecksum;
 
     /* Process existing storage to copy unchanged items to the secondary partition */
     mmconfig_process_existing_storage(mmconfig_buffered_write_wrapper,
                                       node_list,
-                                      &keyheader_ptr,
                                       &rechecksum,
-                                      &skipped_key_space);
+                                      &retained_space);
 
     /* We have copied primary partition to secondary excluding deleted or updated keys.
      * Now add the new key data effectively replacing the old key data. Don't do anything
@@ -883,11 +1390,102 @@ static int mmconfig_update_secondary_image(const struct mmconfig_update_node *no
         struct mmconfig_partition_header *tmp_partition = mmconfig_secondary_image;
         mmconfig_secondary_image = mmconfig_primary_image;
         mmconfig_primary_image = tmp_partition;
+
+        /* The log has been folded into the base list of the new primary */
+        mmconfig_build_index();
+        mmconfig_stats.compactions++;
     }
 
     return MMCONFIG_OK;
 }
 
+/**
+ * Applies a single update by appending a record to the log of the primary image, avoiding the
+ * erase and copy of a full update.
+ *
+ * @param  node The update to apply. Its key must not contain a wildcard.
+ * @return      True if the update was applied, false if the caller must fall back to
+ *              @ref mmconfig_update_secondary_image().
+ */
+static bool mmconfig_append_record(const struct mmconfig_update_node *node)
+{
+    if (mmconfig_log_dirty || (mmconfig_validate_key(node->key) != MMCONFIG_OK))
+    {
+        return false;
+    }
+
+    struct mmconfig_log_header logheader = {
+        .magic = MMCONFIG_LOG_MAGIC,
+        .flags = (node->data == NULL) ? MMCONFIG_LOG_FLAG_DELETED : 0,
+        .reserved = 0,
+    };
+    struct mmconfig_key_header keyheader = {
+        .key_len = strlen(node->key),
+    };
+    struct mmconfig_data_header dataheader = {
+        .data_len = (node->data == NULL) ? 0 : node->size,
+    };
+
+    if ((logheader.flags & MMCONFIG_LOG_FLAG_DELETED) &&
+        (mmconfig_find_entry(node->key, keyheader.key_len) == NULL))
+    {
+        /* Nothing to delete */
+        return true;
+    }
+
+    size_t entry_size = sizeof(keyheader) + keyheader.key_len + sizeof(dataheader) +
+                        dataheader.data_len;
+    uint32_t record_size = MMCONFIG_LOG_ALIGN_UP(sizeof(logheader) + entry_size);
+    if (mmconfig_log_end + record_size > mmconfig_partition_size)
+    {
+        return false;
+    }
+
+    uint32_t checksum = XORHASH_SEED;
+    mmconfig_update_checksum(&checksum, (uint8_t *)&keyheader, sizeof(keyheader));
+    mmconfig_update_checksum(&checksum, (const uint8_t *)node->key, keyheader.key_len);
+    mmconfig_update_checksum(&checksum, (uint8_t *)&dataheader, sizeof(dataheader));
+    mmconfig_update_checksum(&checksum, (const uint8_t *)node->data, dataheader.data_len);
+    logheader.checksum = checksum;
+
+    mmconfig_start_appending((uint32_t)mmconfig_primary_image + mmconfig_log_end);
+    mmconfig_buffered_write((uint8_t *)&logheader, sizeof(logheader));
+    mmconfig_buffered_write((uint8_t *)&keyheader, sizeof(keyheader));
+    mmconfig_buffered_write((const uint8_t *)node->key, keyheader.key_len);
+    mmconfig_buffered_write((uint8_t *)&dataheader, sizeof(dataheader));
+    mmconfig_buffered_write((const uint8_t *)node->data, dataheader.data_len);
+
+    /* Pad to the record alignment so that every flash word is programmed exactly once */
+    uint8_t padding[MMCONFIG_LOG_ALIGN];
+    memset(padding, MMHAL_FLASH_ERASE_VALUE, sizeof(padding));
+    mmconfig_buffered_write(padding, record_size - sizeof(logheader) - entry_size);
+    mmconfig_end_flashing();
+
+    /* Check that the record was written correctly */
+    bool erased;
+    struct mmconfig_log_header *written = mmconfig_get_log_record(mmconfig_log_end, &erased);
+    if (written == NULL)
+    {
+        /* The slot may be partially programmed so do not append after it */
+        mmconfig_log_dirty = true;
+        return false;
+    }
+
+    struct mmconfig_key_header *written_keyheader = (struct mmconfig_key_header *)(written + 1);
+    if (written->flags & MMCONFIG_LOG_FLAG_DELETED)
+    {
+        mmconfig_index_remove(written_keyheader->key, written_keyheader->key_len);
+    }
+    else
+    {
+        mmconfig_index_set(written_keyheader);
+    }
+    mmconfig_log_end += record_size;
+    mmconfig_stats.appends++;
+
+    return true;
+}
+
 /**
  * Initialize the internal structures of the mmconfig API.
  *
@@ -970,6 +1568,11 @@ static int mmconfig_init(void)
         mmconfig_eraseall();
         retval = MMCONFIG_DATA_ERASED;
     }
+
+    if (retval == MMCONFIG_OK)
+    {
+        mmconfig_build_index();
+    }
     return retval;
 }
 
@@ -1001,12 +1604,14 @@ int mmconfig_eraseall(void)
     mmconfig_erase_partition(mmconfig_secondary_image, mmconfig_partition_size);
 
     /* Write to both partitions */
-    mmhal_flash_write((uint32_t)mmconfig_primary_image,
-                      (uint8_t *)&partition_header,
-                      sizeof(partition_header));
-    mmhal_flash_write((uint32_t)mmconfig_secondary_image,
-                      (uint8_t *)&partition_header,
-                      sizeof(partition_header));
+    mmconfig_flash_write((uint32_t)mmconfig_primary_image,
+                         (uint8_t *)&partition_header,
+                         sizeof(partition_header));
+    mmconfig_flash_write((uint32_t)mmconfig_secondary_image,
+                         (uint8_t *)&partition_header,
+                         sizeof(partition_header));
+
+    mmconfig_build_index();
 
     /* All done, release mutex */
     mmosal_mutex_release(mmconfig_mutex);
@@ -1047,36 +1652,15 @@ static int mmconfig_read_data(const char *key, const void **data)
         return MMCONFIG_ERR_INVALID_KEY;
     }
 
-    /* Provide limited protection against mmconfig_primary_image changing under us */
-    struct mmconfig_partition_header *mmconfig_current_image = mmconfig_primary_image;
-
-    /* Find the first keyheader which is at the end of mmconfig_partition_header */
-    struct mmconfig_key_header *keyheader_ptr =
-        (struct mmconfig_key_header *)(mmconfig_current_image->data);
-
-    /* Loop till we find a terminator marked by key_len of @c LIST_TERMINATOR */
-    while ((keyheader_ptr->key_len != LIST_TERMINATOR) &&
-           (keyheader_ptr->key_len != 0) &&
-           ((uint32_t)keyheader_ptr < (uint32_t)mmconfig_current_image + mmconfig_partition_size))
+    struct mmconfig_key_header *keyheader_ptr = mmconfig_find_entry(key, strlen(key));
+    if (keyheader_ptr != NULL)
     {
-        uint8_t *data_ptr;
-        char *keyname_ptr = keyheader_ptr->key;
-
-        struct mmconfig_data_header *dataheader_ptr =
-            (struct mmconfig_data_header *)(keyname_ptr + keyheader_ptr->key_len);
-        data_ptr = dataheader_ptr->data;
-
-        if (mmconfig_key_match(key, strlen(key), keyname_ptr, keyheader_ptr->key_len))
+        struct mmconfig_data_header *dataheader_ptr = mmconfig_get_data_header(keyheader_ptr);
+        if (data)
         {
-            if (data)
-            {
-                *data = (void *)data_ptr;
-            }
-            return dataheader_ptr->data_len;
+            *data = (void *)dataheader_ptr->data;
         }
-
-        /* Move to next record */
-        keyheader_ptr = (struct mmconfig_key_header *)(data_ptr + dataheader_ptr->data_len);
+        return dataheader_ptr->data_len;
     }
 
     /* if not found in CONFIG partition, look in mm_litral_configs*/
@@ -1209,8 +1793,18 @@ int mmconfig_write_update_node_list(const struct mmconfig_update_node *node_list
     /* Take the mutex, who knows what other tasks are doing... */
     mmosal_mutex_get(mmconfig_mutex, UINT32_MAX);
 
-    /* Update the secondary image, this switches primary and secondary images */
-    retval = mmconfig_update_secondary_image(node_list);
+    const struct mmconfig_update_node *node;
+    for (node = node_list; node != NULL; node = node->next)
+    {
+        mmconfig_stats.bytes_requested += strlen(node->key) + (node->data ? node->size : 0);
+    }
+
+    /* A single update can usually be appended to the log. Otherwise (or if the log is full or
+     * damaged) update the secondary image, this switches primary and secondary images */
+    if ((node_list->next != NULL) || !mmconfig_append_record(node_list))
+    {
+        retval = mmconfig_update_secondary_image(node_list);
+    }
 
     /* Uncomment this line to update both partition images on each write,
      * this ensures that if the primary gets corrupt, the latest value is in secondary too.
@@ -1224,179 +1818,287 @@ int mmconfig_write_update_node_list(const struct mmconfig_update_node *node_list
     return retval;
 }
 
-int mmconfig_read_bytes(const char *key, void *buffer, uint32_t buffsize, uint32_t offset)
+/**
+ * Copies raw data found in the config store to the caller's buffer.
+ *
+ * @param  length   The length returned by @ref mmconfig_read_data(), or a negative error code.
+ * @param  data     The data returned by @ref mmconfig_read_data().
+ * @param  buffer   Buffer to copy the data to, or NULL to just return the length.
+ * @param  buffsize The size of @p buffer.
+ * @param  offset   Offset into the data to start copying from.
+ * @return          As for @ref mmconfig_read_bytes().
+ */
+static int mmconfig_decode_bytes(int length,
+                                 const uint8_t *data,
+                                 void *buffer,
+                                 uint32_t buffsize,
+                                 uint32_t offset)
 {
-    int length;
-    const uint8_t *data;
-    int result;
     int copied;
 
-    result = mmconfig_init();
-    if (result == MMCONFIG_ERR_NOT_SUPPORTED)
-    {
-        return MMCONFIG_ERR_NOT_SUPPORTED;
-    }
-
-    mmosal_mutex_get(mmconfig_mutex, UINT32_MAX);
-
-    /* Look for the key in config store */
-    length = mmconfig_read_data(key, (const void **)&data);
-
     if (length < 0)
     {
         /* We got an error */
-        result = length;
-        goto mmconfig_read_bytes_cleanup;
+        return length;
     }
 
     if (offset > (uint32_t)length)
     {
-        result = MMCONFIG_ERR_OUT_OF_BOUNDS;
-        goto mmconfig_read_bytes_cleanup;
+        return MMCONFIG_ERR_OUT_OF_BOUNDS;
     }
 
     /* If buffer is NULL, just return the length required */
     if (buffer == NULL)
     {
-        result = length;
-        goto mmconfig_read_bytes_cleanup;
+        return length;
     }
 
     copied = buffsize < (length - offset) ? buffsize : length - offset;
     memcpy(buffer, &data[offset], copied);
-    result = copied;
-
-mmconfig_read_bytes_cleanup:
-    mmosal_mutex_release(mmconfig_mutex);
-
-    return result;
+    return copied;
 }
 
-int mmconfig_write_string(const char *key, const char *value)
-{
-    /* Treat the string as raw data including the NULL terminator */
-    return mmconfig_write_data(key, (const void *)value, strlen(value) + 1);
-}
-
-int mmconfig_read_string(const char *key, char *buffer, int bufsize)
+/**
+ * Copies a string found in the config store to the caller's buffer.
+ *
+ * @param  length  The length returned by @ref mmconfig_read_data(), or a negative error code.
+ * @param  value   The data returned by @ref mmconfig_read_data().
+ * @param  buffer  Buffer to copy the string to, or NULL to just return the length.
+ * @param  bufsize The size of @p buffer.
+ * @return         As for @ref mmconfig_read_string().
+ */
+static int mmconfig_decode_string(int length, const char *value, char *buffer, int bufsize)
 {
-    const char *value;
-
-    if (mmconfig_init() == MMCONFIG_ERR_NOT_SUPPORTED)
-    {
-        return MMCONFIG_ERR_NOT_SUPPORTED;
-    }
-
-    mmosal_mutex_get(mmconfig_mutex, UINT32_MAX);
-    int retval = mmconfig_read_data(key, (const void **)&value);
-
     /* Check for error */
-    if (retval < 0)
+    if (length < 0)
     {
-        goto mmconfig_read_string_cleanup;
+        return length;
     }
 
     /* Treat a NULL data (0 length) as invalid, (not same as a NULL string "") */
-    if (retval == 0)
+    if (length == 0)
     {
-        retval = MMCONFIG_ERR_INCORRECT_TYPE;
-        goto mmconfig_read_string_cleanup;
+        return MMCONFIG_ERR_INCORRECT_TYPE;
     }
 
     /* Check for NULL termination */
-    if (value[retval - 1] != 0)
+    if (value[length - 1] != 0)
     {
-        retval = MMCONFIG_ERR_INCORRECT_TYPE;
-        goto mmconfig_read_string_cleanup;
+        return MMCONFIG_ERR_INCORRECT_TYPE;
     }
 
     /* If buffer is NULL just return the number of bytes required */
     if (buffer)
     {
         /* Check for sufficient buffer */
-        if (retval > bufsize)
+        if (length > bufsize)
         {
-            retval = MMCONFIG_ERR_INSUFFICIENT_MEMORY;
-            goto mmconfig_read_string_cleanup;
+            return MMCONFIG_ERR_INSUFFICIENT_MEMORY;
         }
 
         /* All good, do it */
-        memcpy(buffer, value, retval);
+        memcpy(buffer, value, length);
     }
 
-mmconfig_read_string_cleanup:
-    mmosal_mutex_release(mmconfig_mutex);
+    return length;
+}
 
-    return retval;
+/**
+ * Checks that data found in the config store is a non-empty NULL terminated string.
+ *
+ * @param  length The length returned by @ref mmconfig_read_data(), or a negative error code.
+ * @param  data   The data returned by @ref mmconfig_read_data().
+ * @return        @c MMCONFIG_OK if the data is a string, else an error code.
+ */
+static int mmconfig_check_string(int length, const char *data)
+{
+    /* Check for error */
+    if (length < 0)
+    {
+        return length;
+    }
+
+    /* Treat a NULL data (0 length) as invalid */
+    if (length == 0)
+    {
+        return MMCONFIG_ERR_INCORRECT_TYPE;
+    }
+
+    /* Check for NULL termination */
+    if (data[length - 1] != 0)
+    {
+        return MMCONFIG_ERR_INCORRECT_TYPE;
+    }
+
+    return MMCONFIG_OK;
 }
 
-int mmconfig_write_int(const char *key, int value)
+/**
+ * Converts data found in the config store to a signed integer.
+ *
+ * @param  length The length returned by @ref mmconfig_read_data(), or a negative error code.
+ * @param  data   The data returned by @ref mmconfig_read_data().
+ * @param  value  Returns the integer. Untouched on error.
+ * @return        As for @ref mmconfig_read_int().
+ */
+static int mmconfig_decode_int(int length, const char *data, int *value)
 {
-    char str[16];
+    int retval = mmconfig_check_string(length, data);
+    if (retval != MMCONFIG_OK)
+    {
+        return retval;
+    }
 
-    /* For maximum compatibility, we are going to represent the integer as a string */
-    return mmconfig_write_string(key, mmconfig_int_to_str(str, sizeof(str), value));
+    /* Try to convert to int */
+    if (mmconfig_str_to_int(data, value) == MMCONFIG_OK)
+    {
+        return MMCONFIG_OK;
+    }
+
+    return MMCONFIG_ERR_INCORRECT_TYPE;
 }
 
-int mmconfig_read_int(const char *key, int *value)
+/**
+ * Converts data found in the config store to an unsigned integer.
+ *
+ * @param  length The length returned by @ref mmconfig_read_data(), or a negative error code.
+ * @param  data   The data returned by @ref mmconfig_read_data().
+ * @param  value  Returns the integer. Untouched on error.
+ * @return        As for @ref mmconfig_read_uint32().
+ */
+static int mmconfig_decode_uint32(int length, const char *data, uint32_t *value)
 {
-    /* For maximum compatibility, we are going to represent the integer as a string */
-    const char *data;
+    int retval = mmconfig_check_string(length, data);
+    if (retval != MMCONFIG_OK)
+    {
+        return retval;
+    }
 
-    if (mmconfig_init() == MMCONFIG_ERR_NOT_SUPPORTED)
+    /* Is it a hexadecimal or plain numeric string */
+    if (mmconfig_str_to_uint(data, value) == MMCONFIG_OK)
     {
-        return MMCONFIG_ERR_NOT_SUPPORTED;
+        return MMCONFIG_OK;
     }
 
-    mmosal_mutex_get(mmconfig_mutex, UINT32_MAX);
-    int retval = mmconfig_read_data(key, (const void **)&data);
+    return MMCONFIG_ERR_INCORRECT_TYPE;
+}
 
+/**
+ * Converts data found in the config store to a boolean.
+ *
+ * @param  length The length returned by @ref mmconfig_read_data(), or a negative error code.
+ * @param  data   The data returned by @ref mmconfig_read_data().
+ * @param  value  Returns the boolean. Untouched on error.
+ * @return        As for @ref mmconfig_read_bool().
+ */
+static int mmconfig_decode_bool(int length, const char *data, bool *value)
+{
     /* Check for error */
-    if (retval < 0)
+    if (length < 0)
     {
-        goto mmconfig_read_int_cleanup;
+        return length;
     }
 
     /* Treat a NULL data (0 length) as invalid */
-    if (retval == 0)
+    if (length == 0)
     {
-        retval = MMCONFIG_ERR_INCORRECT_TYPE;
-        goto mmconfig_read_int_cleanup;
+        return MMCONFIG_ERR_INCORRECT_TYPE;
     }
 
-    /* Check for NULL termination */
-    if (data[retval - 1] != 0)
+    /* Single byte encoded bool */
+    if (length == 1)
     {
-        retval = MMCONFIG_ERR_INCORRECT_TYPE;
-        goto mmconfig_read_int_cleanup;
+        /* Non zero is true */
+        *value = (data[0] != 0);
+        return length;
+    }
+
+    /* Length > 1, must be a string, check for NULL termination */
+    if (data[length - 1] != 0)
+    {
+        return MMCONFIG_ERR_INCORRECT_TYPE;
+    }
+
+    if (strcasecmp(data, "true") == 0)
+    {
+        *value = true;
+        return MMCONFIG_OK;
+    }
+
+    if (strcasecmp(data, "false") == 0)
+    {
+        *value = false;
+        return MMCONFIG_OK;
     }
 
     /* Try to convert to int */
-    if (mmconfig_str_to_int(data, value) == MMCONFIG_OK)
+    int tmp;
+    if (mmconfig_str_to_int(data, &tmp) == MMCONFIG_OK)
+    {
+        *value = (tmp != 0);
+        return MMCONFIG_OK;
+    }
+
+    /* Didn't match anything we could interpret as bool */
+    return MMCONFIG_ERR_INCORRECT_TYPE;
+}
+
+int mmconfig_read_bytes(const char *key, void *buffer, uint32_t buffsize, uint32_t offset)
+{
+    const uint8_t *data;
+    int result;
+
+    result = mmconfig_init();
+    if (result == MMCONFIG_ERR_NOT_SUPPORTED)
     {
-        retval = MMCONFIG_OK;
-        goto mmconfig_read_int_cleanup;
+        return MMCONFIG_ERR_NOT_SUPPORTED;
     }
 
-    retval = MMCONFIG_ERR_INCORRECT_TYPE;
+    mmosal_mutex_get(mmconfig_mutex, UINT32_MAX);
+
+    /* Look for the key in config store */
+    result = mmconfig_read_data(key, (const void **)&data);
+    result = mmconfig_decode_bytes(result, data, buffer, buffsize, offset);
 
-mmconfig_read_int_cleanup:
+    mmosal_mutex_release(mmconfig_mutex);
+
+    return result;
+}
+
+int mmconfig_write_string(const char *key, const char *value)
+{
+    /* Treat the string as raw data including the NULL terminator */
+    return mmconfig_write_data(key, (const void *)value, strlen(value) + 1);
+}
+
+int mmconfig_read_string(const char *key, char *buffer, int bufsize)
+{
+    const char *value;
+
+    if (mmconfig_init() == MMCONFIG_ERR_NOT_SUPPORTED)
+    {
+        return MMCONFIG_ERR_NOT_SUPPORTED;
+    }
+
+    mmosal_mutex_get(mmconfig_mutex, UINT32_MAX);
+    int retval = mmconfig_read_data(key, (const void **)&value);
+    retval = mmconfig_decode_string(retval, value, buffer, bufsize);
     mmosal_mutex_release(mmconfig_mutex);
 
     return retval;
 }
 
-int mmconfig_write_uint32(const char *key, uint32_t value)
+int mmconfig_write_int(const char *key, int value)
 {
     char str[16];
 
     /* For maximum compatibility, we are going to represent the integer as a string */
-    return mmconfig_write_string(key, mmconfig_uint_to_str(str, sizeof(str), value));
+    return mmconfig_write_string(key, mmconfig_int_to_str(str, sizeof(str), value));
 }
 
-int mmconfig_read_uint32(const char *key, uint32_t *value)
+int mmconfig_read_int(const char *key, int *value)
 {
-    /* For maximum compatibility, we are going to represent the value as a string */
+    /* For maximum compatibility, we are going to represent the integer as a string */
     const char *data;
 
     if (mmconfig_init() == MMCONFIG_ERR_NOT_SUPPORTED)
@@ -1405,39 +2107,34 @@ int mmconfig_read_uint32(const char *key, uint32_t *value)
     }
 
     mmosal_mutex_get(mmconfig_mutex, UINT32_MAX);
-
     int retval = mmconfig_read_data(key, (const void **)&data);
+    retval = mmconfig_decode_int(retval, data, value);
+    mmosal_mutex_release(mmconfig_mutex);
 
-    /* Check for error */
-    if (retval < 0)
-    {
-        goto mmconfig_read_uint32_cleanup;
-    }
+    return retval;
+}
 
-    /* Treat a NULL data (0 length) as invalid */
-    if (retval == 0)
-    {
-        retval = MMCONFIG_ERR_INCORRECT_TYPE;
-        goto mmconfig_read_uint32_cleanup;
-    }
+int mmconfig_write_uint32(const char *key, uint32_t value)
+{
+    char str[16];
 
-    /* Check for NULL termination */
-    if (data[retval - 1] != 0)
-    {
-        retval = MMCONFIG_ERR_INCORRECT_TYPE;
-        goto mmconfig_read_uint32_cleanup;
-    }
+    /* For maximum compatibility, we are going to represent the integer as a string */
+    return mmconfig_write_string(key, mmconfig_uint_to_str(str, sizeof(str), value));
+}
 
-    /* Is it a hexadecimal or plain numeric string */
-    if (mmconfig_str_to_uint(data, value) == MMCONFIG_OK)
+int mmconfig_read_uint32(const char *key, uint32_t *value)
+{
+    /* For maximum compatibility, we are going to represent the value as a string */
+    const char *data;
+
+    if (mmconfig_init() == MMCONFIG_ERR_NOT_SUPPORTED)
     {
-        retval = MMCONFIG_OK;
-        goto mmconfig_read_uint32_cleanup;
+        return MMCONFIG_ERR_NOT_SUPPORTED;
     }
 
-    retval = MMCONFIG_ERR_INCORRECT_TYPE;
-
-mmconfig_read_uint32_cleanup:
+    mmosal_mutex_get(mmconfig_mutex, UINT32_MAX);
+    int retval = mmconfig_read_data(key, (const void **)&data);
+    retval = mmconfig_decode_uint32(retval, data, value);
     mmosal_mutex_release(mmconfig_mutex);
 
     return retval;
@@ -1467,67 +2164,87 @@ int mmconfig_read_bool(const char *key, bool *value)
     }
 
     mmosal_mutex_get(mmconfig_mutex, UINT32_MAX);
-
     int retval = mmconfig_read_data(key, (const void **)&data);
+    retval = mmconfig_decode_bool(retval, data, value);
+    mmosal_mutex_release(mmconfig_mutex);
 
-    /* Check for error */
-    if (retval < 0)
-    {
-        goto mmconfig_read_bool_cleanup;
-    }
+    return retval;
+}
 
-    /* Treat a NULL data (0 length) as invalid */
-    if (retval == 0)
-    {
-        retval = MMCONFIG_ERR_INCORRECT_TYPE;
-        goto mmconfig_read_bool_cleanup;
-    }
+int mmconfig_read_items(struct mmconfig_read_item *items, size_t count)
+{
+    size_t ii;
+    int found = 0;
 
-    /* Single byte encoded bool */
-    if (retval == 1)
+    if (mmconfig_init() == MMCONFIG_ERR_NOT_SUPPORTED)
     {
-        /* Non zero is true */
-        *value = (data[0] != 0);
-        goto mmconfig_read_bool_cleanup;
+        return MMCONFIG_ERR_NOT_SUPPORTED;
     }
 
-    /* Length > 1, must be a string, check for NULL termination */
-    if (data[retval - 1] != 0)
-    {
-        retval = MMCONFIG_ERR_INCORRECT_TYPE;
-        goto mmconfig_read_bool_cleanup;
-    }
+    /* Resolve every item under a single acquisition of the mutex. Each lookup is a probe of the
+     * RAM index, so the partition is not rescanned per key. */
+    mmosal_mutex_get(mmconfig_mutex, UINT32_MAX);
 
-    if (strcasecmp(data, "true") == 0)
+    for (ii = 0; ii < count; ii++)
     {
-        *value = true;
-        retval = MMCONFIG_OK;
-        goto mmconfig_read_bool_cleanup;
-    }
+        struct mmconfig_read_item *item = &items[ii];
+        const char *data = NULL;
+        int length = mmconfig_read_data(item->key, (const void **)&data);
 
-    if (strcasecmp(data, "false") == 0)
-    {
-        *value = false;
-        retval = MMCONFIG_OK;
-        goto mmconfig_read_bool_cleanup;
+        switch (item->type)
+        {
+            case MMCONFIG_ITEM_BYTES:
+                item->result = mmconfig_decode_bytes(length, (const uint8_t *)data, item->value,
+                                                     item->size, 0);
+                break;
+
+            case MMCONFIG_ITEM_STRING:
+                item->result = mmconfig_decode_string(length, data, (char *)item->value,
+                                                      (int)item->size);
+                break;
+
+            case MMCONFIG_ITEM_INT:
+                item->result = mmconfig_decode_int(length, data, (int *)item->value);
+                break;
+
+            case MMCONFIG_ITEM_UINT32:
+                item->result = mmconfig_decode_uint32(length, data, (uint32_t *)item->value);
+                break;
+
+            case MMCONFIG_ITEM_BOOL:
+                item->result = mmconfig_decode_bool(length, data, (bool *)item->value);
+                break;
+
+            default:
+                item->result = MMCONFIG_ERR_INCORRECT_TYPE;
+                break;
+        }
+
+        if (item->result >= 0)
+        {
+            found++;
+        }
     }
 
-    /* Try to convert to int */
-    int tmp;
-    if (mmconfig_str_to_int(data, &tmp) == MMCONFIG_OK)
+    mmosal_mutex_release(mmconfig_mutex);
+
+    return found;
+}
+
+int mmconfig_get_stats(struct mmconfig_stats *stats)
+{
+    if (mmconfig_init() == MMCONFIG_ERR_NOT_SUPPORTED)
     {
-        *value = (tmp != 0);
-        retval = MMCONFIG_OK;
-        goto mmconfig_read_bool_cleanup;
+        return MMCONFIG_ERR_NOT_SUPPORTED;
     }
 
-    /* Didn't match anything we could interpret as bool */
-    retval = MMCONFIG_ERR_INCORRECT_TYPE;
-
-mmconfig_read_bool_cleanup:
+    mmosal_mutex_get(mmconfig_mutex, UINT32_MAX);
+    *stats = mmconfig_stats;
+    stats->log_bytes_used = mmconfig_log_end - mmconfig_get_log_start(mmconfig_primary_image);
+    stats->index_entries = mmconfig_index_count;
     mmosal_mutex_release(mmconfig_mutex);
 
-    return retval;
+    return MMCONFIG_OK;
 }
 
 int mmconfig_check_usage(const struct mmconfig_update_node *node_list,
@@ -17,9 +17,9 @@
  * designated primary - this is the highest versioned valid partition. Whenever data needs to be
  * written, the secondary is updated and then the pointers are switched to make the now updated
  * secondary the primary. This ensures that primary always points to a valid and latest copy. For
- * redundancy, this process is done twice so that both primary and secondary are up to date. Flash
- * life can be doubled by doing this only once with the disadvantage that if primary partition gets
- * corrupted then the secondary data will be stale.
+ * redundancy, this process can be done twice so that both primary and secondary are up to date.
+ * Flash life can be doubled by doing this only once with the disadvantage that if primary
+ * partition gets corrupted then the secondary data will be stale.
  *
  * Partition Header
  * ----------------
@@ -46,6 +46,27 @@
  * |-------|-----------|---------|----------|---------------------------|-------------------|
  * @endcode
  *
+ * Update log
+ * ----------
+ * Single key updates are appended to a log that follows the list instead of rewriting the
+ * partition. The log starts at the first 16 byte aligned offset after the end marker, so the
+ * checksum in the partition header continues to cover the list only and firmware that predates
+ * the log still reads a valid (if older) store. Each log record is:
+ * @code
+ * |-------|-------|-------|----------|----------|---------------------------|---------|
+ * |       | Magic | Flags | Reserved | Checksum | Key/Value Pair            | Padding |
+ * |-------|-------|-------|----------|----------|---------------------------|---------|
+ * | Bytes |   2   |   1   |     1    |     4    |             n             |  0-15   |
+ * |-------|-------|-------|----------|----------|---------------------------|---------|
+ * @endcode
+ *
+ * The magic is the text 'LR' in little endian format. If bit 0 of the flags is set then the
+ * record deletes the key and the value is empty. The checksum covers the key/value pair only.
+ * Records are padded so that each starts on a 16 byte boundary; this ensures that no flash word is
+ * ever programmed twice on devices with a 128 bit programming granularity. A later record for a
+ * key supersedes any earlier record or list entry for the same key. The log ends at the first
+ * record that does not start with the magic.
+ *
  * Key-Value pair
  * --------------
  * ### Keys
@@ -145,23 +166,33 @@
  * written to both with version number 0. Since the first byte following the header is @c 0xFF this
  * is treated as an empty list.
  *
+ * The list and then the log of the primary partition are then walked to build an index in RAM of
+ * the location of the latest value of every key. If a damaged log record is found (for example,
+ * because power was lost part way through writing it) the log is ended at that record and the
+ * next write compacts the store as described below.
+ *
  * Writing a new Key-Value pair
  * ----------------------------
  *
- * To write a new key value pair the system first erases the secondary partition. Then it copies all
- * key-value pairs from the primary partition to the secondary partition. If a key with the same
- * name as the new key is found then it is excluded from the copy. The system then appends the new
- * Key-Value pair to the end of the list. If the new data is NULL then it skips writing the new
- * Key-Value pair effectively deleting the named key. Once this is done, the new checksum is
- * computed and the header is written after incrementing the version number by 1. The written data
- * is then validated and if correct the partitions are swapped and the newly written partition
- * becomes the primary.
+ * A single key value pair (or deletion of a single key without a wildcard) is appended to the log
+ * of the primary partition and read back to verify it. No flash is erased.
+ *
+ * If the log is full or damaged, or a wildcard deletion or a list of updates is written, the
+ * store is compacted. The system first erases the secondary partition. Then it copies the latest
+ * value of every key in the list and log of the primary partition to the list of the secondary
+ * partition. If a key with the same name as the new key is found then it is excluded from the
+ * copy. The system then appends the new Key-Value pair to the end of the list. If the new data is
+ * NULL then it skips writing the new Key-Value pair effectively deleting the named key. Once this
+ * is done, the new checksum is computed and the header is written after incrementing the version
+ * number by 1. The written data is then validated and if correct the partitions are swapped and
+ * the newly written partition becomes the primary.
  *
  * Reading Data
  * ------------
  *
- * To read data we simply scan the primary partition Key-Value by Key-Value till we find the
- * requested key or run into the @c 0xFF marker signifying end of the list.
+ * To read data we look up the requested key in the RAM index. If there was insufficient memory for
+ * the index, we instead scan the list of the primary partition Key-Value by Key-Value and then the
+ * log, keeping the last match.
  *
  * Programming the config store from a host PC {#MMCONFIG_PROGRAMMING}
  * ===========================================
@@ -497,6 +528,67 @@ int mmconfig_write_bool(const char *key, bool value);
  */
 int mmconfig_read_bool(const char *key, bool *value);
 
+/** Data types supported by @ref mmconfig_read_items() */
+enum mmconfig_item_type
+{
+    MMCONFIG_ITEM_BYTES, /**< Raw data, as read by @ref mmconfig_read_bytes() */
+    MMCONFIG_ITEM_STRING, /**< String, as read by @ref mmconfig_read_string() */
+    MMCONFIG_ITEM_INT, /**< Signed integer, as read by @ref mmconfig_read_int() */
+    MMCONFIG_ITEM_UINT32, /**< Unsigned integer, as read by @ref mmconfig_read_uint32() */
+    MMCONFIG_ITEM_BOOL /**< Boolean, as read by @ref mmconfig_read_bool() */
+};
+
+/**
+ * An entry in the table of keys passed to @ref mmconfig_read_items().
+ */
+struct mmconfig_read_item
+{
+    /** The key to read. Same rules as for the individual read functions. */
+    const char *key;
+    /** The type of the data, which selects the conversion applied. */
+    enum mmconfig_item_type type;
+    /** Destination for the value. Untouched if the key is not found or cannot be converted. */
+    void *value;
+    /** Size of the destination buffer, for @c MMCONFIG_ITEM_BYTES and @c MMCONFIG_ITEM_STRING. */
+    size_t size;
+    /** Returns the value the corresponding individual read function would have returned. */
+    int result;
+};
+
+/** Initializer for a @ref mmconfig_read_item that reads raw data into a buffer. */
+#define MMCONFIG_READ_ITEM_BYTES(_key, _buf, _size) \
+    { .key = (_key), .type = MMCONFIG_ITEM_BYTES, .value = (_buf), .size = (_size) }
+
+/** Initializer for a @ref mmconfig_read_item that reads a string into a buffer. */
+#define MMCONFIG_READ_ITEM_STRING(_key, _buf, _size) \
+    { .key = (_key), .type = MMCONFIG_ITEM_STRING, .value = (_buf), .size = (_size) }
+
+/** Initializer for a @ref mmconfig_read_item that reads an @c int. */
+#define MMCONFIG_READ_ITEM_INT(_key, _ptr) \
+    { .key = (_key), .type = MMCONFIG_ITEM_INT, .value = (_ptr), .size = sizeof(int) }
+
+/** Initializer for a @ref mmconfig_read_item that reads a @c uint32_t. */
+#define MMCONFIG_READ_ITEM_UINT32(_key, _ptr) \
+    { .key = (_key), .type = MMCONFIG_ITEM_UINT32, .value = (_ptr), .size = sizeof(uint32_t) }
+
+/** Initializer for a @ref mmconfig_read_item that reads a @c bool. */
+#define MMCONFIG_READ_ITEM_BOOL(_key, _ptr) \
+    { .key = (_key), .type = MMCONFIG_ITEM_BOOL, .value = (_ptr), .size = sizeof(bool) }
+
+/**
+ * Reads a table of keys from persistent store in a single operation.
+ *
+ * This is equivalent to calling the individual read function for each item, but the config store
+ * is locked only once and each key is resolved once, which reduces start-up time when an
+ * application loads many settings.
+ *
+ * @param  items Table of items to read. The @c result of each item is set on return.
+ * @param  count Number of items in the table.
+ * @return       Returns the number of items that were read successfully. On error returns:
+ *                          @c MMCONFIG_ERR_NOT_SUPPORTED if there is no persistent store
+ */
+int mmconfig_read_items(struct mmconfig_read_item *items, size_t count);
+
 /**
  * Returns the persistent store data identified by the key.
  * @param  key      Identifies the data element in persistent storage and is a
@@ -557,6 +649,36 @@ int mmconfig_check_usage(const struct mmconfig_update_node *node_list,
                          uint32_t *bytes_used,
                          int32_t *bytes_remaining);
 
+/** Flash usage statistics of the persistent store, accumulated since boot. */
+struct mmconfig_stats
+{
+    /** Number of bytes of keys and data passed to the write functions. */
+    uint32_t bytes_requested;
+    /** Number of bytes programmed into flash. */
+    uint32_t bytes_written;
+    /** Number of flash blocks erased. */
+    uint32_t blocks_erased;
+    /** Number of updates applied by appending a record to the log. */
+    uint32_t appends;
+    /** Number of updates that required the store to be compacted into the other partition. */
+    uint32_t compactions;
+    /** Number of bytes currently used by the log in the primary partition. */
+    uint32_t log_bytes_used;
+    /** Number of keys in the RAM index, or 0 if the index could not be allocated. */
+    uint32_t index_entries;
+};
+
+/**
+ * Gets the flash usage statistics of the persistent store.
+ *
+ * The write amplification since boot is given by @c bytes_written / @c bytes_requested.
+ *
+ * @param  stats Returns the statistics.
+ * @return       Returns @c MMCONFIG_OK on success. On error returns:
+ *                          @c MMCONFIG_ERR_NOT_SUPPORTED if there is no persistent store
+ */
+int mmconfig_get_stats(struct mmconfig_stats *stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -12,14 +12,28 @@
 #include "lwip/etharp.h"
 #include "lwip/ethip6.h"
 #include "lwip/tcpip.h"
+#include "netif/ethernet.h"
 #if LWIP_SNMP
 #include "lwip/snmp.h"
 #endif
 
+/**
+ * Maximum number of received packets held for the TCP/IP thread. Packets received while this many
+ * are already pending are dropped, so that a stalled TCP/IP thread cannot consume the whole RX
+ * packet pool.
+ */
+#ifndef MMNETIF_RX_PENDING_MAXLEN
+#define MMNETIF_RX_PENDING_MAXLEN   (TCPIP_MBOX_SIZE)
+#endif
+
 struct netif_state
 {
     enum mmwlan_vif vif;
     volatile uint8_t tx_qos_tid;
+    /** Received packets waiting to be passed to the stack by the TCP/IP thread. */
+    struct mmpkt_list rx_pending;
+    /** Whether @c mmnetif_rx_process() has been scheduled on the TCP/IP thread. */
+    bool rx_scheduled;
 };
 
 static struct netif_state *get_netif_state(struct netif *netif)
@@ -53,21 +67,8 @@ static void mmpkt_pbuf_wrapper_free(struct pbuf *p)
     LWIP_MEMPOOL_FREE(RX_POOL, pbuf);
 }
 
-static void mmnetif_rx(struct mmpkt *rxpkt, const struct mmwlan_rx_metadata *metadata, void *arg)
+static void mmnetif_input_pkt(struct netif *netif, struct mmpkt *rxpkt)
 {
-    struct netif *netif = (struct netif *)arg;
-    LWIP_ASSERT("arg NULL", netif != NULL);
-
-    struct netif_state *state = get_netif_state(netif);
-    if (metadata->vif != state->vif)
-    {
-        LWIP_DEBUGF(NETIF_DEBUG, ("mmnetif: dropping rx packet on other VIF\n"));
-        mmpkt_release(rxpkt);
-        return;
-    }
-
-    LWIP_DEBUGF(NETIF_DEBUG, ("mmnetif: packet received\n"));
-
     struct mmpkt_pbuf_wrapper *pbuf = (struct mmpkt_pbuf_wrapper *)LWIP_MEMPOOL_ALLOC(RX_POOL);
     if (pbuf != NULL)
     {
@@ -83,8 +84,9 @@ static void mmnetif_rx(struct mmpkt *rxpkt, const struct mmwlan_rx_metadata *met
                                 &pbuf->p,
                                 mmpkt_get_data_start(pbuf->pktview),
                                 mmpkt_get_data_length(pbuf->pktview));
-        MMOSAL_DEV_ASSERT(netif->input != NULL);
-        int ret = netif->input(p, netif);
+        /* We are already running in the TCP/IP thread so bypass netif->input (which would
+         * post the packet to the TCP/IP mailbox) and hand the packet straight to the stack. */
+        int ret = ethernet_input(p, netif);
         if (ret == ERR_OK)
         {
             LINK_STATS_INC(link.recv);
@@ -105,6 +107,89 @@ static void mmnetif_rx(struct mmpkt *rxpkt, const struct mmwlan_rx_metadata *met
     }
 }
 
+/** Runs in the TCP/IP thread to pass all pending received packets to the stack. */
+static void mmnetif_rx_process(void *arg)
+{
+    struct netif *netif = (struct netif *)arg;
+    struct netif_state *state = get_netif_state(netif);
+    struct mmpkt_list pkts = MMPKT_LIST_INIT;
+    struct mmpkt *rxpkt;
+
+    MMOSAL_TASK_ENTER_CRITICAL();
+    while ((rxpkt = mmpkt_list_dequeue(&state->rx_pending)) != NULL)
+    {
+        mmpkt_list_append(&pkts, rxpkt);
+    }
+    state->rx_scheduled = false;
+    MMOSAL_TASK_EXIT_CRITICAL();
+
+    LWIP_DEBUGF(NETIF_DEBUG, ("mmnetif: %lu packets received\n", mmpkt_list_length(&pkts)));
+
+    while ((rxpkt = mmpkt_list_dequeue(&pkts)) != NULL)
+    {
+        mmnetif_input_pkt(netif, rxpkt);
+    }
+}
+
+static void mmnetif_rx_batch(struct mmpkt_list *rxpkts, enum mmwlan_vif vif, void *arg)
+{
+    struct netif *netif = (struct netif *)arg;
+    LWIP_ASSERT("arg NULL", netif != NULL);
+
+    struct netif_state *state = get_netif_state(netif);
+    if (vif != state->vif)
+    {
+        LWIP_DEBUGF(NETIF_DEBUG, ("mmnetif: dropping rx packets on other VIF\n"));
+        mmpkt_list_clear(rxpkts);
+        return;
+    }
+
+    struct mmpkt *rxpkt;
+    bool schedule;
+
+    MMOSAL_TASK_ENTER_CRITICAL();
+    while (mmpkt_list_length(&state->rx_pending) < MMNETIF_RX_PENDING_MAXLEN &&
+           (rxpkt = mmpkt_list_dequeue(rxpkts)) != NULL)
+    {
+        mmpkt_list_append(&state->rx_pending, rxpkt);
+    }
+    schedule = !state->rx_scheduled;
+    state->rx_scheduled = true;
+    MMOSAL_TASK_EXIT_CRITICAL();
+
+    /* Anything left in the batch did not fit in the pending queue */
+    while ((rxpkt = mmpkt_list_dequeue(rxpkts)) != NULL)
+    {
+        LWIP_DEBUGF(NETIF_DEBUG, ("mmnetif: rx pending queue full\n"));
+        LINK_STATS_INC(link.drop);
+        mmpkt_release(rxpkt);
+    }
+
+    if (!schedule)
+    {
+        return;
+    }
+
+    /* A single TCP/IP mailbox post covers every packet queued before the callback runs. */
+    err_t err = tcpip_try_callback(mmnetif_rx_process, netif);
+    if (err != ERR_OK)
+    {
+        struct mmpkt_list dropped = MMPKT_LIST_INIT;
+
+        LWIP_DEBUGF(NETIF_DEBUG | LWIP_DBG_LEVEL_SERIOUS, ("mmnetif: rx schedule failed\n"));
+        MMOSAL_TASK_ENTER_CRITICAL();
+        while ((rxpkt = mmpkt_list_dequeue(&state->rx_pending)) != NULL)
+        {
+            mmpkt_list_append(&dropped, rxpkt);
+        }
+        state->rx_scheduled = false;
+        MMOSAL_TASK_EXIT_CRITICAL();
+
+        LINK_STATS_INC(link.drop);
+        mmpkt_list_clear(&dropped);
+    }
+}
+
 static void mmnetif_vif_state(const struct mmwlan_vif_state *state, void *arg)
 {
     struct netif *netif = (struct netif *)arg;
@@ -270,9 +355,10 @@ err_t mmnetif_init(struct netif *netif)
     MMOSAL_ASSERT(state != NULL);
     state->tx_qos_tid = MMWLAN_TX_DEFAULT_QOS_TID;
     state->vif = MMWLAN_VIF_UNSPECIFIED;
+    mmpkt_list_init(&state->rx_pending);
     netif->state = state;
 
-    status = mmwlan_register_rx_pkt_ext_cb(MMWLAN_VIF_UNSPECIFIED, mmnetif_rx, netif);
+    status = mmwlan_register_rx_pkt_batch_cb(MMWLAN_VIF_UNSPECIFIED, mmnetif_rx_batch, netif);
     MMOSAL_ASSERT(status == MMWLAN_SUCCESS);
     status = mmwlan_register_vif_state_cb(MMWLAN_VIF_UNSPECIFIED, mmnetif_vif_state, netif);
     MMOSAL_ASSERT(status == MMWLAN_SUCCESS);
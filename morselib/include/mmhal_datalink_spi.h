@@ -0,0 +1,112 @@
+/*
+ * Copyright 2025 Morse Micro
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @ingroup MMHAL
+ * @defgroup MMHAL_DATALINK_SPI Morse Micro SPI Data-link Hardware Abstraction Layer API
+ *
+ * This provides an abstraction layer for an SPI slave interface with DMA, as used by the
+ * mmagic SPI data-link. The agent is the SPI slave. In addition to the standard SPI signals
+ * (SCK, MOSI, MISO and CS) a "ready" GPIO output is used to signal the controller that the
+ * agent has armed a transfer or has data to send.
+ *
+ * Each transaction is delimited by the controller asserting and deasserting CS. Before each
+ * transaction the data-link arms the DMA with a transmit and/or receive buffer using
+ * @ref mmhal_datalink_spi_arm(), and the HAL reports completion using the callback given to
+ * @ref mmhal_datalink_spi_init().
+ *
+ * @{
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * Function type for the SPI transfer complete callback.
+ *
+ * @note This callback may be invoked from interrupt context, so implementations must not block.
+ *
+ * @param length Number of bytes clocked during the transaction. This may be less than the length
+ *               that was armed if the controller deasserted CS early.
+ * @param arg    Opaque argument (as passed in to @ref mmhal_datalink_spi_init()).
+ */
+typedef void (*mmhal_datalink_spi_xfer_cb_t)(size_t length, void *arg);
+
+/**
+ * Initialize the SPI data-link HAL and perform any setup necessary. The ready line will be
+ * deasserted and no transfer will be armed on return.
+ *
+ * @param xfer_cb     Callback to be invoked on completion of each transaction.
+ * @param xfer_cb_arg Opaque argument to be passed to @p xfer_cb. May be NULL.
+ */
+void mmhal_datalink_spi_init(mmhal_datalink_spi_xfer_cb_t xfer_cb, void *xfer_cb_arg);
+
+/**
+ * Deinitialize the SPI data-link HAL, cancelling any armed transfer and disabling the SPI
+ * peripheral.
+ */
+void mmhal_datalink_spi_deinit(void);
+
+/**
+ * Arm the DMA for the next transaction. Only one transfer may be armed at a time; arming a new
+ * transfer replaces any transfer that has not yet started.
+ *
+ * The buffers must remain valid until the transfer complete callback has been invoked.
+ *
+ * @param tx_data Data to clock out on MISO. If @c NULL, the HAL will transmit zeros.
+ * @param rx_data Buffer to receive data clocked in on MOSI. If @c NULL, received data is
+ *                discarded.
+ * @param length  Length of the transfer. Both @p tx_data and @p rx_data (where given) must be at
+ *                least this long.
+ *
+ * @returns @c true on success, else @c false.
+ */
+bool mmhal_datalink_spi_arm(const uint8_t *tx_data, uint8_t *rx_data, size_t length);
+
+/**
+ * Set the state of the ready line.
+ *
+ * @note The HAL must automatically deassert the ready line when the controller asserts CS so
+ *       that each assertion of the line is seen by the controller as a new event.
+ *
+ * @param ready @c true to assert the ready line, @c false to deassert it.
+ */
+void mmhal_datalink_spi_set_ready(bool ready);
+
+/** Enumeration of deep sleep modes for the SPI data-link HAL. */
+enum mmhal_datalink_spi_deep_sleep_mode
+{
+    /** Deep sleep mode is disabled. */
+    MMHAL_DATALINK_SPI_DEEP_SLEEP_DISABLED,
+    /** Enable deep sleep until activity occurs on data-link transport. */
+    MMHAL_DATALINK_SPI_DEEP_SLEEP_ONE_SHOT,
+    /** Deep sleep is vetoed by the HAL whenever CS is asserted. */
+    MMHAL_DATALINK_SPI_DEEP_SLEEP_HARDWARE,
+};
+
+/**
+ * Set the deep sleep mode for the SPI data-link. See @ref mmhal_datalink_spi_deep_sleep_mode for
+ * possible deep sleep modes. Note that a given platform may not support all modes.
+ *
+ * @param mode The deep sleep mode to set.
+ *
+ * @returns true if the mode was set successfully; false on failure (e.g., unsupported mode).
+ */
+bool mmhal_datalink_spi_set_deep_sleep_mode(enum mmhal_datalink_spi_deep_sleep_mode mode);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
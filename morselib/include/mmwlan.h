@@ -39,6 +39,7 @@
 #include <string.h>
 
 #include "mmpkt.h"
+#include "mmpkt_list.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -460,6 +461,45 @@ enum mmwlan_status mmwlan_set_subbands_enabled(bool subbands_enabled);
  */
 enum mmwlan_status mmwlan_set_ampdu_enabled(bool ampdu_enabled);
 
+/**
+ * Sets whether or not Aggregated MAC Service Data Unit (A-MSDU) transmission is enabled.
+ * This defaults to enabled, if not set otherwise.
+ *
+ * When enabled, A-MSDU support is advertised in Block Ack agreements and frames that are
+ * already queued for the same peer and TID are combined into a single A-MSDU when the peer
+ * has agreed to accept A-MSDUs for that TID. Received A-MSDUs are always de-aggregated.
+ *
+ * @note This must only be invoked when MMWLAN is inactive (i.e., STA mode not enabled).
+ *
+ * @param amsdu_enabled   Boolean value indicating whether A-MSDU support should be enabled.
+ *
+ * @return @ref MMWLAN_SUCCESS on success, else an appropriate error code.
+ */
+enum mmwlan_status mmwlan_set_amsdu_enabled(bool amsdu_enabled);
+
+/** Minimum value of the A-MSDU length limit that can be set with @ref mmwlan_set_amsdu_limits(). */
+#define MMWLAN_AMSDU_MIN_MAX_LEN (512)
+
+/** Maximum value of the A-MSDU length limit that can be set with @ref mmwlan_set_amsdu_limits(). */
+#define MMWLAN_AMSDU_MAX_MAX_LEN (3839)
+
+/**
+ * Sets the limits applied when building A-MSDUs for transmission.
+ *
+ * Aggregation never delays a frame: only frames that are already queued are combined, so the
+ * subframe limit also bounds the time that the first frame of an A-MSDU spends waiting for the
+ * rest to be copied in.
+ *
+ * @param max_len           Maximum length of an A-MSDU in octets, including subframe headers
+ *                          and padding. Must be between @ref MMWLAN_AMSDU_MIN_MAX_LEN and
+ *                          @ref MMWLAN_AMSDU_MAX_MAX_LEN.
+ * @param max_subframes     Maximum number of MSDUs to combine into a single A-MSDU. A value of
+ *                          1 disables aggregation.
+ *
+ * @return @ref MMWLAN_SUCCESS on success, else an appropriate error code.
+ */
+enum mmwlan_status mmwlan_set_amsdu_limits(uint16_t max_len, uint8_t max_subframes);
+
 /**
  * Minimum value of fragmentation threshold that can be set with
  * @ref mmwlan_set_fragment_threshold().
@@ -527,6 +567,61 @@ struct mmwlan_qos_queue_params
 enum mmwlan_status mmwlan_set_default_qos_queue_params(const struct mmwlan_qos_queue_params *params,
                                                        size_t count);
 
+/** Enumeration of the ways in which the per-access category TX queues can be served. */
+enum mmwlan_txq_service_mode
+{
+    /**
+     * Access categories are served in priority order (VO, VI, BE, BK), but each may send at
+     * most its weight in frames before lower priority access categories with queued frames
+     * get a turn.
+     */
+    MMWLAN_TXQ_SERVICE_WEIGHTED,
+    /** A frame is only sent from an access category if all higher priority queues are empty. */
+    MMWLAN_TXQ_SERVICE_STRICT,
+};
+
+/** Structure for storing the UMAC TX queue management parameters. */
+struct mmwlan_txq_params
+{
+    /** How the per-access category queues are served. */
+    enum mmwlan_txq_service_mode service_mode;
+    /**
+     * Weights, in frames, of each access category indexed by Access Category Index (ACI).
+     * Only used with @ref MMWLAN_TXQ_SERVICE_WEIGHTED. Each weight must be at least 1.
+     */
+    uint8_t weights[MMWLAN_QOS_QUEUE_NUM_ACIS];
+    /**
+     * Target sojourn time in milliseconds. Once frames have spent longer than this in a queue
+     * for at least @c codel_interval_ms, frames are dropped from the head of that queue at an
+     * increasing rate until the sojourn time drops back below the target (CoDel). A value of 0
+     * disables sojourn time based dropping.
+     */
+    uint16_t codel_target_ms;
+    /** CoDel interval in milliseconds. Must be greater than @c codel_target_ms. */
+    uint16_t codel_interval_ms;
+};
+
+/** Initializer for @ref mmwlan_txq_params, giving the default configuration. */
+#define MMWLAN_TXQ_PARAMS_INIT                       \
+    {                                                \
+        .service_mode = MMWLAN_TXQ_SERVICE_WEIGHTED, \
+        .weights = { 4, 1, 8, 16 },                  \
+        .codel_target_ms = 5,                        \
+        .codel_interval_ms = 100,                    \
+    }
+
+/**
+ * Sets the parameters used to manage the UMAC TX queues.
+ *
+ * Frames queued for transmission are held in a separate queue for each access category of
+ * each peer so that bulk traffic does not delay latency sensitive traffic.
+ *
+ * @param params    The parameters to apply. See @ref MMWLAN_TXQ_PARAMS_INIT for the defaults.
+ *
+ * @return @ref MMWLAN_SUCCESS on success, else an appropriate error code.
+ */
+enum mmwlan_status mmwlan_set_txq_params(const struct mmwlan_txq_params *params);
+
 /** Enumeration of configuration states for MCS10 behavior. */
 enum mmwlan_mcs10_mode
 {
@@ -1444,6 +1539,101 @@ int32_t mmwlan_get_rssi(void);
  */
 enum mmwlan_status mmwlan_set_listen_interval(uint16_t interval);
 
+/**
+ * Serialize the cached SAE PMKSA entries and the SAE hash-to-element password element (PT) for
+ * the current network into the given buffer, so that they can be persisted by the application.
+ *
+ * After a successful SAE authentication the supplicant caches the resulting PMKSA. While the AP
+ * also retains the PMKSA, subsequent associations use Open System authentication with the PMKID
+ * instead of repeating the SAE exchange. Cached entries are retained across
+ * @ref mmwlan_sta_disable() and @ref mmwlan_shutdown(), but not across @ref mmwlan_deinit() or
+ * a reboot; use this function and @ref mmwlan_sta_pmksa_load() to persist them.
+ *
+ * The serialized data contains key material and must be stored securely. It is bound to the
+ * SSID and passphrase in use when it was captured and is ignored if these change.
+ *
+ * Entry lifetimes are stored as the time remaining, rounded up to the next hour, and only count
+ * down while the device is running. Time spent powered off or in deep sleep is not accounted
+ * for, so a restored entry may outlive its expiry on the AP. In that case association with the
+ * cached PMKID is rejected and the supplicant falls back to a full SAE exchange.
+ *
+ * @param[out]    buf Buffer to receive the serialized data. May be @c NULL to query the
+ *                    required length.
+ * @param[in,out] len On entry, the length of @p buf. On return, the length of the serialized
+ *                    data (or the required length if @p buf is @c NULL or too short).
+ *
+ * @returns @ref MMWLAN_SUCCESS on success, @ref MMWLAN_NOT_FOUND if there is nothing cached,
+ *          @ref MMWLAN_NO_MEM if @p buf is too short, else an appropriate error code.
+ */
+enum mmwlan_status mmwlan_sta_pmksa_save(uint8_t *buf, size_t *len);
+
+/**
+ * Load PMKSA and PT data previously returned by @ref mmwlan_sta_pmksa_save(). This should be
+ * invoked before @ref mmwlan_sta_enable(). Any currently stored data is replaced.
+ *
+ * @param buf Buffer containing the serialized data, or @c NULL to discard stored data.
+ * @param len Length of @p buf.
+ *
+ * @returns @ref MMWLAN_SUCCESS on success, @ref MMWLAN_INVALID_ARGUMENT if the data is malformed,
+ *          else an appropriate error code.
+ */
+enum mmwlan_status mmwlan_sta_pmksa_load(const uint8_t *buf, size_t len);
+
+/**
+ * @defgroup MMWLAN_BSS_CACHE     BSS cache for fast reconnect
+ *
+ * Details of recently seen BSSs (BSSID, SSID, channel and S1G operation) are cached as probe
+ * responses are received during scans. When the STA is not connected and a cached entry matches
+ * the configured SSID (and BSSID, if set), the first scan performed by the STA is restricted to
+ * the channel of that BSS. If the BSS is not found then the entry is discarded and a scan across
+ * the full channel list is performed.
+ *
+ * The cache is held in RAM and cleared by @ref mmwlan_init(). The application may save the
+ * cache to persistent storage using @ref mmwlan_bss_cache_save() and restore it after a reboot
+ * using @ref mmwlan_bss_cache_load() to avoid a full scan on the first connection.
+ *
+ * @{
+ */
+
+/**
+ * Serialize the contents of the BSS cache into the given buffer.
+ *
+ * Entries are serialized from most to least recently seen. Signal strength and timestamps are
+ * not included, so the result only changes when the set of cached BSSs or their parameters
+ * change. The application can therefore compare it against the stored copy to avoid
+ * unnecessary writes to persistent storage.
+ *
+ * @param[out]    buf Buffer to receive the serialized cache. May be @c NULL to query the
+ *                    required length.
+ * @param[in,out] len On entry, the length of @p buf. On return, the length of the serialized
+ *                    cache (or the required length if @p buf is @c NULL or too short).
+ *
+ * @returns @ref MMWLAN_SUCCESS on success, @ref MMWLAN_NO_MEM if @p buf is too short, else an
+ *          appropriate error code.
+ */
+enum mmwlan_status mmwlan_bss_cache_save(uint8_t *buf, size_t *len);
+
+/**
+ * Replace the contents of the BSS cache with data previously returned by
+ * @ref mmwlan_bss_cache_save().
+ *
+ * @param buf Buffer containing the serialized cache.
+ * @param len Length of @p buf.
+ *
+ * @returns @ref MMWLAN_SUCCESS on success, @ref MMWLAN_INVALID_ARGUMENT if the data is malformed,
+ *          else an appropriate error code.
+ */
+enum mmwlan_status mmwlan_bss_cache_load(const uint8_t *buf, size_t len);
+
+/**
+ * Remove all entries from the BSS cache.
+ *
+ * @returns @ref MMWLAN_SUCCESS on success, else an appropriate error code.
+ */
+enum mmwlan_status mmwlan_bss_cache_clear(void);
+
+/** @} */
+
 /**
  * @defgroup MMWLAN_WNM     WNM Sleep management
  *
@@ -2340,6 +2530,42 @@ enum mmwlan_status mmwlan_register_rx_pkt_ext_cb(enum mmwlan_vif vif,
                                                  mmwlan_rx_pkt_ext_cb_t callback,
                                                  void *arg);
 
+/**
+ * Receive data packet batch callback function, consuming a list of mmpkts.
+ *
+ * Received packets are collected while the UMAC processes a batch of received frames and are
+ * then passed to this callback in a single invocation, so that per-packet overheads in the
+ * network stack (e.g., posting to a message queue) can be amortized over the batch.
+ *
+ * @param pkts  List of mmpkts in the order that they were received, each containing a received
+ *              packet including an 802.3 header. Ownership of the mmpkts is passed to this
+ *              callback, which should remove them from the list. Any mmpkts remaining in the
+ *              list when the callback returns will be freed.
+ * @param vif   The virtual interface that the packets were received on.
+ * @param arg   Opaque argument that was given when the callback was registered.
+ */
+typedef void (*mmwlan_rx_pkt_batch_cb_t)(struct mmpkt_list *pkts, enum mmwlan_vif vif, void *arg);
+
+/**
+ * Register a receive callback which consumes batches of mmpkts.
+ *
+ * @note Only one receive callback of this type may be registered for each VIF. Further
+ *       registration will overwrite the previously registered callback. Registration of
+ *       any callback through this function will override any callbacks previously registered
+ *       by @ref mmwlan_register_rx_cb(), @ref mmwlan_register_rx_pkt_cb() or
+ *       @ref mmwlan_register_rx_pkt_ext_cb() (for the given VIF).
+ *
+ * @param vif       The VIF to register this callback for. If @ref MMWLAN_VIF_UNSPECIFIED then
+ *                  it will be registered for all VIFs.
+ * @param callback  The callback to register (@c NULL to unregister).
+ * @param arg       Opaque argument to be passed to the callback.
+ *
+ * @return @ref MMWLAN_SUCCESS on success, else an appropriate error code.
+ */
+enum mmwlan_status mmwlan_register_rx_pkt_batch_cb(enum mmwlan_vif vif,
+                                                   mmwlan_rx_pkt_batch_cb_t callback,
+                                                   void *arg);
+
 /**
  * Blocks until the transmit path is ready for transmit.
  *
@@ -2452,6 +2678,31 @@ struct mmwlan_tx_metadata
  */
 enum mmwlan_status mmwlan_tx_pkt(struct mmpkt *pkt, const struct mmwlan_tx_metadata *metadata);
 
+/**
+ * Transmit a list of packets. This is equivalent to invoking @ref mmwlan_tx_pkt() for each
+ * packet in turn, except that the metadata is validated once, the peer is looked up once per
+ * run of packets with the same destination address, each run is queued in one operation and
+ * the UMAC is woken once for the whole list.
+ *
+ * Each packet must start with an 802.3 header and must have been allocated by
+ * @ref mmwlan_alloc_mmpkt_for_tx().
+ *
+ * @note This function is non-blocking. Use @ref mmwlan_tx_wait_until_ready() or the tx flow
+ *       control callback before invoking this function.
+ *
+ * @param pkts      List of packets to transmit. All packets are consumed by this function
+ *                  (including any that could not be queued) and the list will be empty on
+ *                  return.
+ * @param metadata  Extra information relating to the packet transmission, applied to all
+ *                  packets in the list. May be @c NULL, in which case default values will be
+ *                  used.
+ *
+ * @return @ref MMWLAN_SUCCESS if all packets were queued, else the error code for the first
+ *         packet that could not be queued.
+ */
+enum mmwlan_status mmwlan_tx_pkt_list(struct mmpkt_list *pkts,
+                                      const struct mmwlan_tx_metadata *metadata);
+
 /**
  * Transmit the given packet using the given QoS Traffic ID (TID). The packet must start with
  * an 802.3 header that will be translated into an 802.11 header.
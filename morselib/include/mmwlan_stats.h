@@ -41,6 +41,19 @@ enum mmwlan_stats_connect_timestamp_index
     MMWLAN_STATS_CONNECT_TIMESTAMP_N_ENTRIES
 };
 
+/**
+ * Enumeration of valid indexes for the per access category TX queue stats. These match the
+ * Access Category Index (ACI).
+ */
+enum mmwlan_stats_txq_ac_index
+{
+    MMWLAN_STATS_TXQ_AC_BE,
+    MMWLAN_STATS_TXQ_AC_BK,
+    MMWLAN_STATS_TXQ_AC_VI,
+    MMWLAN_STATS_TXQ_AC_VO,
+    MMWLAN_STATS_TXQ_AC_N_ENTRIES
+};
+
 /**
  * Data structure to contain all stats from the UMAC.
  * @warning This is not considered stable API and may change between releases.
@@ -117,6 +130,31 @@ struct mmwlan_stats_umac_data
     /** Number of frames sent by the driver that timed out before receiving a TX status from the
      *  chip. */
     uint32_t datapath_driver_tx_pending_status_timeout;
+
+    /** Number of probe responses transmitted by the AP. */
+    uint32_t ap_probe_rsp_sent;
+
+    /** Number of probe requests answered by a coalesced broadcast probe response rather than
+     *  an individual response. */
+    uint32_t ap_probe_rsp_suppressed;
+
+    /** High water mark of the TX queue of each access category of any single peer. */
+    uint16_t datapath_txq_ac_high_water_mark[MMWLAN_STATS_TXQ_AC_N_ENTRIES];
+
+    /** Number of frames dequeued for transmission from the TX queue of each access category. */
+    uint32_t datapath_txq_ac_dequeued[MMWLAN_STATS_TXQ_AC_N_ENTRIES];
+
+    /** Total time in milliseconds that dequeued frames spent in the TX queue of each access
+     *  category. Divide by @c datapath_txq_ac_dequeued to get the mean sojourn time. */
+    uint32_t datapath_txq_ac_sojourn_total_ms[MMWLAN_STATS_TXQ_AC_N_ENTRIES];
+
+    /** Maximum time in milliseconds that a dequeued frame spent in the TX queue of each access
+     *  category. */
+    uint32_t datapath_txq_ac_sojourn_max_ms[MMWLAN_STATS_TXQ_AC_N_ENTRIES];
+
+    /** Number of frames dropped from the TX queue of each access category because the sojourn
+     *  time remained above the CoDel target. */
+    uint32_t datapath_txq_ac_aqm_drops[MMWLAN_STATS_TXQ_AC_N_ENTRIES];
 };
 
 /** @} */
@@ -19,13 +19,17 @@ struct consbuf
     uint32_t buf_size;
 
     uint32_t offset;
+
+    bool allow_overflow;
+
+    bool overflowed;
 };
 
 
-#define CONSBUF_INIT_WITHOUT_BUF { NULL, 0, 0 }
+#define CONSBUF_INIT_WITHOUT_BUF { NULL, 0, 0, false, false }
 
 
-#define CONSBUF_INIT_WITH_BUF(buf, buf_size) { (buf), (buf_size), 0 }
+#define CONSBUF_INIT_WITH_BUF(buf, buf_size) { (buf), (buf_size), 0, false, false }
 
 
 void consbuf_reinit(struct consbuf *cbuf, uint8_t *buf, uint32_t buf_size);
@@ -34,12 +38,48 @@ void consbuf_reinit(struct consbuf *cbuf, uint8_t *buf, uint32_t buf_size);
 void consbuf_reinit_from_mmpkt(struct consbuf *cbuf, struct mmpktview *view);
 
 
-void consbuf_append(struct consbuf *buf, const uint8_t *data, uint32_t len);
+void consbuf_overflow(struct consbuf *buf);
 
 
-void consbuf_append_be16(struct consbuf *buf, uint16_t data);
+static inline uint8_t *consbuf_reserve(struct consbuf *buf, uint32_t len)
+{
+    uint8_t *ret = NULL;
+    if (buf->buf != NULL)
+    {
+        if (len <= buf->buf_size - buf->offset)
+        {
+            ret = buf->buf + buf->offset;
+        }
+        else
+        {
+            consbuf_overflow(buf);
+        }
+    }
+
+    buf->offset += len;
+
+    return ret;
+}
+
+
+static inline void consbuf_append(struct consbuf *buf, const uint8_t *data, uint32_t len)
+{
+    uint8_t *dst = consbuf_reserve(buf, len);
+    if (dst != NULL)
+    {
+        memcpy(dst, data, len);
+    }
+}
 
 
-uint8_t *consbuf_reserve(struct consbuf *buf, uint32_t len);
+static inline void consbuf_append_be16(struct consbuf *buf, uint16_t data)
+{
+    uint8_t *dst = consbuf_reserve(buf, sizeof(data));
+    if (dst != NULL)
+    {
+        dst[0] = data >> 8;
+        dst[1] = data & 0xff;
+    }
+}
 
 
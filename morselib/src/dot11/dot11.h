@@ -83,6 +83,8 @@ enum dot11_qos_control
 {
     DOT11_SHIFT_QC_TID = 0,
     DOT11_MASK_QC_TID = 0x0ful << 0,
+    DOT11_SHIFT_QC_AMSDU_PRESENT = 7,
+    DOT11_MASK_QC_AMSDU_PRESENT = 0x01ul << 7,
 };
 
 
@@ -99,6 +101,20 @@ static inline uint16_t dot11_qos_control_get_tid(uint16_t qc_le)
     } while (0)
 
 
+static inline uint16_t dot11_qos_control_get_amsdu_present(uint16_t qc_le)
+{
+    return ((le16toh(qc_le) & DOT11_MASK_QC_AMSDU_PRESENT) >> DOT11_SHIFT_QC_AMSDU_PRESENT);
+}
+
+
+#define DOT11_QOS_CONTROL_SET_AMSDU_PRESENT(qc_le, val_ho)             \
+    do {                                                               \
+        qc_le &= ~DOT11_MASK_QC_AMSDU_PRESENT;                         \
+        qc_le |= (htole16(((val_ho) << DOT11_SHIFT_QC_AMSDU_PRESENT) & \
+                          DOT11_MASK_QC_AMSDU_PRESENT));               \
+    } while (0)
+
+
 enum dot11_capability_information
 {
     DOT11_SHIFT_CAPINFO_ESS = 0,
@@ -2376,6 +2392,30 @@ enum dot11_aci
 };
 
 
+static inline enum dot11_aci dot11_tid_to_aci(uint8_t tid)
+{
+    switch (tid)
+    {
+        case 1:
+        case 2:
+            return DOT11_ACI_AC_BK;
+
+        case 4:
+        case 5:
+            return DOT11_ACI_AC_VI;
+
+        case 6:
+        case 7:
+            return DOT11_ACI_AC_VO;
+
+        case 0:
+        case 3:
+        default:
+            return DOT11_ACI_AC_BE;
+    }
+}
+
+
 enum dot11_twt_setup_cmd
 {
     DOT11_TWT_SETUP_CMD_REQUEST = 0,
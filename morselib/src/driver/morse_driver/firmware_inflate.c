@@ -0,0 +1,616 @@
+/*
+ * Copyright 2026 Morse Micro
+ * SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-MorseMicroCommercial
+ *
+ * Streaming, table-driven inflater (RFC 1951) for deflated firmware segments. Output is produced
+ * into a power-of-two ring sized to the deflate window and handed to the caller each time the ring
+ * fills, so memory use is bounded by the window rather than the size of the segment.
+ */
+
+#include <errno.h>
+
+#include "morse.h"
+#include "firmware_inflate.h"
+
+#define INFLATE_MAXBITS   (15)
+#define INFLATE_MAXLCODES (286)
+#define INFLATE_MAXDCODES (30)
+#define INFLATE_MAXCODES  (INFLATE_MAXLCODES + INFLATE_MAXDCODES)
+#define INFLATE_FIXLCODES (288)
+
+
+#define INFLATE_FAST_BITS        (9)
+#define INFLATE_FAST_MASK        ((1u << INFLATE_FAST_BITS) - 1)
+#define INFLATE_FAST_LEN_SHIFT   (9)
+#define INFLATE_FAST_SYMBOL_MASK ((1u << INFLATE_FAST_LEN_SHIFT) - 1)
+
+
+#define INFLATE_OUTPUT_ALIGN (4)
+
+
+struct inflate_huffman
+{
+
+    uint16_t count[INFLATE_MAXBITS + 1];
+
+    uint16_t symbol[INFLATE_FIXLCODES];
+
+    uint16_t fast[1u << INFLATE_FAST_BITS];
+};
+
+struct inflate_state
+{
+    firmware_inflate_read_cb_t read_cb;
+    firmware_inflate_write_cb_t write_cb;
+    void *cb_arg;
+
+
+    const uint8_t *in;
+    uint32_t in_len;
+    uint32_t bitbuf;
+    uint32_t bitcnt;
+
+
+    int status;
+
+
+    uint8_t *window;
+    uint32_t window_mask;
+    uint32_t window_pos;
+    uint32_t flush_pos;
+    uint32_t out_cnt;
+    uint32_t out_max;
+
+    struct inflate_huffman lencode;
+    struct inflate_huffman distcode;
+};
+
+
+static bool inflate_refill(struct inflate_state *s, uint32_t need)
+{
+    while (s->bitcnt < need)
+    {
+        if (s->in_len == 0)
+        {
+            if (s->status != 0)
+            {
+                return false;
+            }
+
+            int ret = s->read_cb(s->cb_arg, &s->in, &s->in_len);
+            if (ret != 0)
+            {
+                s->status = ret;
+                return false;
+            }
+            if (s->in_len == 0)
+            {
+                return false;
+            }
+        }
+
+        s->bitbuf |= (uint32_t)(*s->in++) << s->bitcnt;
+        s->in_len--;
+        s->bitcnt += 8;
+    }
+
+    return true;
+}
+
+static uint32_t inflate_bits(struct inflate_state *s, uint32_t need)
+{
+    if (!inflate_refill(s, need))
+    {
+        if (s->status == 0)
+        {
+            MMLOG_WRN("Deflate stream truncated\n");
+            s->status = -EIO;
+        }
+        return 0;
+    }
+
+    uint32_t val = s->bitbuf & ((1ul << need) - 1);
+    s->bitbuf >>= need;
+    s->bitcnt -= need;
+    return val;
+}
+
+static int inflate_flush(struct inflate_state *s)
+{
+    uint32_t len = s->window_pos - s->flush_pos;
+    if (len == 0)
+    {
+        return 0;
+    }
+
+    int ret = s->write_cb(s->cb_arg, s->window + s->flush_pos, len);
+    s->flush_pos = s->window_pos;
+    return ret;
+}
+
+static inline int inflate_put(struct inflate_state *s, uint8_t byte)
+{
+    s->window[s->window_pos++] = byte;
+    if (s->window_pos > s->window_mask)
+    {
+        int ret = inflate_flush(s);
+        s->window_pos = 0;
+        s->flush_pos = 0;
+        return ret;
+    }
+    return 0;
+}
+
+
+static uint16_t inflate_reverse_bits(uint16_t code, uint32_t len)
+{
+    uint16_t rev = 0;
+    while (len--)
+    {
+        rev = (rev << 1) | (code & 1);
+        code >>= 1;
+    }
+    return rev;
+}
+
+
+static int inflate_construct(struct inflate_huffman *h, const uint16_t *length, int n)
+{
+    uint16_t offs[INFLATE_MAXBITS + 1];
+    uint16_t next_code[INFLATE_MAXBITS + 1];
+    uint16_t code = 0;
+    int symbol;
+    int left;
+    int len;
+
+    memset(h->count, 0, sizeof(h->count));
+    memset(h->fast, 0, sizeof(h->fast));
+
+    for (symbol = 0; symbol < n; symbol++)
+    {
+        h->count[length[symbol]]++;
+    }
+    if (h->count[0] == n)
+    {
+        return 0;
+    }
+
+    left = 1;
+    for (len = 1; len <= INFLATE_MAXBITS; len++)
+    {
+        left <<= 1;
+        left -= h->count[len];
+        if (left < 0)
+        {
+            return left;
+        }
+    }
+
+    offs[1] = 0;
+    for (len = 1; len < INFLATE_MAXBITS; len++)
+    {
+        offs[len + 1] = offs[len] + h->count[len];
+    }
+
+    for (len = 1; len <= INFLATE_MAXBITS; len++)
+    {
+        next_code[len] = code;
+        code = (code + h->count[len]) << 1;
+    }
+
+    for (symbol = 0; symbol < n; symbol++)
+    {
+        len = length[symbol];
+        if (len == 0)
+        {
+            continue;
+        }
+
+        h->symbol[offs[len]++] = symbol;
+
+        code = next_code[len]++;
+        if (len <= INFLATE_FAST_BITS)
+        {
+
+            uint16_t entry = (uint16_t)((len << INFLATE_FAST_LEN_SHIFT) | symbol);
+            for (uint32_t idx = inflate_reverse_bits(code, len); idx <= INFLATE_FAST_MASK;
+                 idx += (1u << len))
+            {
+                h->fast[idx] = entry;
+            }
+        }
+    }
+
+    return left;
+}
+
+
+static int inflate_decode(struct inflate_state *s, const struct inflate_huffman *h)
+{
+
+    (void)inflate_refill(s, INFLATE_FAST_BITS);
+
+    uint16_t entry = h->fast[s->bitbuf & INFLATE_FAST_MASK];
+    uint32_t entry_len = entry >> INFLATE_FAST_LEN_SHIFT;
+    if (entry_len != 0 && entry_len <= s->bitcnt)
+    {
+        s->bitbuf >>= entry_len;
+        s->bitcnt -= entry_len;
+        return entry & INFLATE_FAST_SYMBOL_MASK;
+    }
+
+
+    int code = 0;
+    int first = 0;
+    int index = 0;
+    for (int len = 1; len <= INFLATE_MAXBITS; len++)
+    {
+        code |= inflate_bits(s, 1);
+        if (s->status != 0)
+        {
+            return s->status;
+        }
+
+        int count = h->count[len];
+        if (code - count < first)
+        {
+            return h->symbol[index + (code - first)];
+        }
+        index += count;
+        first += count;
+        first <<= 1;
+        code <<= 1;
+    }
+
+    return -EINVAL;
+}
+
+static int inflate_stored(struct inflate_state *s)
+{
+
+    (void)inflate_bits(s, s->bitcnt & 7);
+
+    uint32_t len = inflate_bits(s, 16);
+    uint32_t nlen = inflate_bits(s, 16);
+    if (s->status != 0)
+    {
+        return s->status;
+    }
+    if (len != (~nlen & 0xffff))
+    {
+        return -EINVAL;
+    }
+    if (s->out_max - s->out_cnt < len)
+    {
+        return -ENOSPC;
+    }
+
+    s->out_cnt += len;
+    while (len--)
+    {
+        uint8_t byte = inflate_bits(s, 8);
+        if (s->status != 0)
+        {
+            return s->status;
+        }
+
+        int ret = inflate_put(s, byte);
+        if (ret != 0)
+        {
+            return ret;
+        }
+    }
+
+    return 0;
+}
+
+static int inflate_codes(struct inflate_state *s)
+{
+    static const uint16_t lens[29] = {
+        3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+        31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258,
+    };
+    static const uint8_t lext[29] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0,
+    };
+    static const uint16_t dists[30] = {
+        1,   2,   3,   4,   5,   7,    9,    13,   17,   25,   33,   49,   65,    97,    129,
+        193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577,
+    };
+    static const uint8_t dext[30] = {
+        0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+        7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13,
+    };
+    int symbol;
+    int ret = 0;
+
+    do {
+        symbol = inflate_decode(s, &s->lencode);
+        if (symbol < 0)
+        {
+            return symbol;
+        }
+
+        if (symbol < 256)
+        {
+            if (s->out_cnt == s->out_max)
+            {
+                return -ENOSPC;
+            }
+            s->out_cnt++;
+            ret = inflate_put(s, (uint8_t)symbol);
+        }
+        else if (symbol > 256)
+        {
+            symbol -= 257;
+            if (symbol >= (int)MM_ARRAY_COUNT(lens))
+            {
+                return -EINVAL;
+            }
+            uint32_t len = lens[symbol] + inflate_bits(s, lext[symbol]);
+
+            symbol = inflate_decode(s, &s->distcode);
+            if (symbol < 0)
+            {
+                return symbol;
+            }
+            if (symbol >= (int)MM_ARRAY_COUNT(dists))
+            {
+                return -EINVAL;
+            }
+            uint32_t dist = dists[symbol] + inflate_bits(s, dext[symbol]);
+            if (s->status != 0)
+            {
+                return s->status;
+            }
+
+            if (dist > s->out_cnt || dist > s->window_mask + 1)
+            {
+                return -EINVAL;
+            }
+            if (s->out_max - s->out_cnt < len)
+            {
+                return -ENOSPC;
+            }
+
+            s->out_cnt += len;
+            uint32_t from = (s->window_pos - dist) & s->window_mask;
+            while (len-- && ret == 0)
+            {
+                uint8_t byte = s->window[from];
+                from = (from + 1) & s->window_mask;
+                ret = inflate_put(s, byte);
+            }
+        }
+
+        if (ret != 0)
+        {
+            return ret;
+        }
+    } while (symbol != 256);
+
+    return 0;
+}
+
+static int inflate_fixed(struct inflate_state *s)
+{
+    uint16_t lengths[INFLATE_FIXLCODES];
+    int symbol;
+
+    for (symbol = 0; symbol < 144; symbol++)
+    {
+        lengths[symbol] = 8;
+    }
+    for (; symbol < 256; symbol++)
+    {
+        lengths[symbol] = 9;
+    }
+    for (; symbol < 280; symbol++)
+    {
+        lengths[symbol] = 7;
+    }
+    for (; symbol < INFLATE_FIXLCODES; symbol++)
+    {
+        lengths[symbol] = 8;
+    }
+    (void)inflate_construct(&s->lencode, lengths, INFLATE_FIXLCODES);
+
+    for (symbol = 0; symbol < INFLATE_MAXDCODES; symbol++)
+    {
+        lengths[symbol] = 5;
+    }
+    (void)inflate_construct(&s->distcode, lengths, INFLATE_MAXDCODES);
+
+    return inflate_codes(s);
+}
+
+static int inflate_dynamic(struct inflate_state *s)
+{
+    static const uint8_t order[19] = {
+        16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15,
+    };
+    uint16_t lengths[INFLATE_MAXCODES];
+    int index;
+    int err;
+
+    int nlen = inflate_bits(s, 5) + 257;
+    int ndist = inflate_bits(s, 5) + 1;
+    int ncode = inflate_bits(s, 4) + 4;
+    if (s->status != 0)
+    {
+        return s->status;
+    }
+    if (nlen > INFLATE_MAXLCODES || ndist > INFLATE_MAXDCODES)
+    {
+        return -EINVAL;
+    }
+
+    for (index = 0; index < ncode; index++)
+    {
+        lengths[order[index]] = inflate_bits(s, 3);
+    }
+    for (; index < 19; index++)
+    {
+        lengths[order[index]] = 0;
+    }
+    if (s->status != 0)
+    {
+        return s->status;
+    }
+
+
+    err = inflate_construct(&s->lencode, lengths, 19);
+    if (err != 0)
+    {
+        return -EINVAL;
+    }
+
+    index = 0;
+    while (index < nlen + ndist)
+    {
+        int symbol = inflate_decode(s, &s->lencode);
+        if (symbol < 0)
+        {
+            return symbol;
+        }
+
+        if (symbol < 16)
+        {
+            lengths[index++] = symbol;
+            continue;
+        }
+
+        uint16_t len = 0;
+        if (symbol == 16)
+        {
+            if (index == 0)
+            {
+                return -EINVAL;
+            }
+            len = lengths[index - 1];
+            symbol = 3 + inflate_bits(s, 2);
+        }
+        else if (symbol == 17)
+        {
+            symbol = 3 + inflate_bits(s, 3);
+        }
+        else
+        {
+            symbol = 11 + inflate_bits(s, 7);
+        }
+        if (s->status != 0)
+        {
+            return s->status;
+        }
+        if (index + symbol > nlen + ndist)
+        {
+            return -EINVAL;
+        }
+        while (symbol--)
+        {
+            lengths[index++] = len;
+        }
+    }
+
+    if (lengths[256] == 0)
+    {
+        return -EINVAL;
+    }
+
+
+    err = inflate_construct(&s->lencode, lengths, nlen);
+    if (err && (err < 0 || nlen != s->lencode.count[0] + s->lencode.count[1]))
+    {
+        return -EINVAL;
+    }
+
+    err = inflate_construct(&s->distcode, lengths + nlen, ndist);
+    if (err && (err < 0 || ndist != s->distcode.count[0] + s->distcode.count[1]))
+    {
+        return -EINVAL;
+    }
+
+    return inflate_codes(s);
+}
+
+int firmware_inflate(uint8_t window_bits,
+                     uint32_t max_output_len,
+                     firmware_inflate_read_cb_t read_cb,
+                     firmware_inflate_write_cb_t write_cb,
+                     void *cb_arg,
+                     uint32_t *output_len)
+{
+    int ret = 0;
+    uint32_t last;
+
+    if (window_bits > FIRMWARE_INFLATE_MAX_WINDOW_BITS)
+    {
+        return -EINVAL;
+    }
+
+
+    uint32_t window_size = INFLATE_OUTPUT_ALIGN;
+    while (window_size < (1ul << window_bits) && window_size < max_output_len)
+    {
+        window_size <<= 1;
+    }
+
+    uint32_t alloc_len = sizeof(struct inflate_state) + window_size;
+    struct inflate_state *s = (struct inflate_state *)mmosal_malloc(alloc_len);
+    if (s == NULL)
+    {
+        MMLOG_WRN("Failed to allocate %lu octets for inflate\n", alloc_len);
+        return -ENOMEM;
+    }
+
+    memset(s, 0, sizeof(*s));
+    s->read_cb = read_cb;
+    s->write_cb = write_cb;
+    s->cb_arg = cb_arg;
+    s->window = (uint8_t *)(s + 1);
+    s->window_mask = window_size - 1;
+    s->out_max = max_output_len;
+
+    do {
+        last = inflate_bits(s, 1);
+        uint32_t type = inflate_bits(s, 2);
+        if (s->status != 0)
+        {
+            ret = s->status;
+            break;
+        }
+
+        switch (type)
+        {
+            case 0:
+                ret = inflate_stored(s);
+                break;
+
+            case 1:
+                ret = inflate_fixed(s);
+                break;
+
+            case 2:
+                ret = inflate_dynamic(s);
+                break;
+
+            default:
+                ret = -EINVAL;
+                break;
+        }
+    } while (ret == 0 && !last);
+
+    if (ret == 0)
+    {
+
+        while (s->window_pos & (INFLATE_OUTPUT_ALIGN - 1))
+        {
+            s->window[s->window_pos++] = 0;
+        }
+        ret = inflate_flush(s);
+    }
+
+    *output_len = s->out_cnt;
+    mmosal_free(s);
+    return ret;
+}
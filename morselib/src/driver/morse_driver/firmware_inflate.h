@@ -0,0 +1,26 @@
+/*
+ * Copyright 2026 Morse Micro
+ * SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-MorseMicroCommercial
+ *
+ * Streaming inflater for deflated firmware segments.
+ */
+#pragma once
+
+#include <stdint.h>
+
+
+#define FIRMWARE_INFLATE_MAX_WINDOW_BITS (15)
+
+
+typedef int (*firmware_inflate_read_cb_t)(void *arg, const uint8_t **buf, uint32_t *len);
+
+
+typedef int (*firmware_inflate_write_cb_t)(void *arg, const uint8_t *buf, uint32_t len);
+
+
+int firmware_inflate(uint8_t window_bits,
+                     uint32_t max_output_len,
+                     firmware_inflate_read_cb_t read_cb,
+                     firmware_inflate_write_cb_t write_cb,
+                     void *cb_arg,
+                     uint32_t *output_len);
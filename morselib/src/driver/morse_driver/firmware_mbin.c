@@ -9,7 +9,7 @@
 
 #include "morse.h"
 #include "firmware.h"
-#include "driver/puff/puff.h"
+#include "firmware_inflate.h"
 #include "mbin.h"
 #include "driver/transport/morse_transport.h"
 #include "mmhal_wlan.h"
@@ -287,92 +287,152 @@ static int process_segment(struct driver_data *driverd,
     return ret;
 }
 
-static int process_segment_deflated(struct driver_data *driverd,
-                                    morse_file_read_cb_t file_read_cb,
-                                    uint32_t *file_read_offset,
-                                    struct mbin_tlv_hdr tlv_hdr)
+struct deflated_segment_stream
 {
-    struct mmhal_robuf robuf = { 0 };
-    uint8_t *buf = NULL;
-    unsigned long src_len;
-    unsigned long dst_len;
+    struct driver_data *driverd;
+    morse_file_read_cb_t file_read_cb;
+    uint32_t *file_read_offset;
+    uint32_t remaining;
+    struct mmhal_robuf robuf;
+    uint32_t address;
+};
 
-    int ret = read_into_robuf(&robuf, file_read_cb, file_read_offset, tlv_hdr.len);
+
+static int deflated_segment_read(void *arg, const uint8_t **buf, uint32_t *len)
+{
+    struct deflated_segment_stream *stream = (struct deflated_segment_stream *)arg;
+
+    robuf_cleanup(&stream->robuf);
+    *buf = NULL;
+    *len = 0;
+
+    if (stream->remaining == 0)
+    {
+        return 0;
+    }
+
+    int ret = read_into_robuf(&stream->robuf,
+                              stream->file_read_cb,
+                              stream->file_read_offset,
+                              stream->remaining);
     if (ret != 0)
     {
         return ret;
     }
 
-    if (robuf.len < tlv_hdr.len)
+    stream->remaining -= stream->robuf.len;
+    *buf = stream->robuf.buf;
+    *len = stream->robuf.len;
+    return 0;
+}
+
+
+static int deflated_segment_write(void *arg, const uint8_t *buf, uint32_t len)
+{
+    struct deflated_segment_stream *stream = (struct deflated_segment_stream *)arg;
+
+    MMLOG_VRB("  ... write %lu bytes to 0x%08lx\n", len, stream->address);
+    morse_trns_claim(stream->driverd);
+    int ret = morse_trns_write_multi_byte(stream->driverd, stream->address, buf, len);
+    morse_trns_release(stream->driverd);
+    if (ret != 0)
     {
-        MMLOG_ERR("Deflated chunk read too short (expected %u bytes, got %lu bytes)\n",
-                  tlv_hdr.len,
-                  robuf.len);
-        return -EFAULT;
+        MMLOG_WRN("Failed to write %lu octets to %08lx\n", len, stream->address);
+        return ret;
     }
 
-    const struct mbin_deflated_segment_hdr *seg_hdr =
-        (const struct mbin_deflated_segment_hdr *)robuf.buf;
+    stream->address += len;
+    return 0;
+}
 
-    uint32_t base_address = le32toh(seg_hdr->base_address);
-    uint16_t chunk_size = le16toh(seg_hdr->chunk_size);
-    uint16_t rounded_chunk_size = FAST_ROUND_UP(chunk_size, 4);
+static int process_segment_deflated(struct driver_data *driverd,
+                                    morse_file_read_cb_t file_read_cb,
+                                    uint32_t *file_read_offset,
+                                    struct mbin_tlv_hdr tlv_hdr)
+{
+    struct mmhal_robuf robuf = { 0 };
+    struct mbin_deflated_segment_hdr seg_hdr;
+    uint32_t received = 0;
+    uint32_t output_len = 0;
 
-    buf = (uint8_t *)mmosal_malloc(rounded_chunk_size);
-    if (buf == NULL)
+    if (tlv_hdr.len < sizeof(seg_hdr))
     {
-        MMLOG_WRN("Failed to allocate %u octets for fw chunk\n", rounded_chunk_size);
-        ret = -ENOMEM;
-        goto cleanup;
+        MMLOG_ERR("Deflated chunk too short (%u bytes)\n", tlv_hdr.len);
+        return -EFAULT;
     }
 
 
-    *((uint32_t *)buf + rounded_chunk_size - 4) = 0;
+    while (received < sizeof(seg_hdr))
+    {
+        int ret = read_into_robuf(&robuf,
+                                  file_read_cb,
+                                  file_read_offset,
+                                  sizeof(seg_hdr) - received);
+        if (ret != 0)
+        {
+            return ret;
+        }
 
-    src_len = tlv_hdr.len - sizeof(*seg_hdr);
-    dst_len = chunk_size;
+        memcpy(((uint8_t *)&seg_hdr) + received, robuf.buf, robuf.len);
+        received += robuf.len;
+        robuf_cleanup(&robuf);
+    }
+
+    uint32_t base_address = le32toh(seg_hdr.base_address);
+    uint16_t chunk_size = le16toh(seg_hdr.chunk_size);
+    const uint8_t *zlib_header = seg_hdr.zlib_header;
+    uint8_t cinfo = zlib_header[0] >> 4;
+    uint32_t compressed_len = tlv_hdr.len - sizeof(seg_hdr);
 
-    MMLOG_DBG("Found compressed segment; compressed len=%lu, decompressed len=%lu %02x %02x\n",
-              src_len,
-              dst_len,
-              *(robuf.buf + sizeof(*seg_hdr)),
-              *(robuf.buf + sizeof(*seg_hdr) + 1));
+    MMLOG_DBG("Found compressed segment; compressed len=%lu, decompressed len=%u %02x %02x\n",
+              compressed_len,
+              chunk_size,
+              zlib_header[0],
+              zlib_header[1]);
 
-    if ((seg_hdr->zlib_header[0] >> 4) != 7)
+    if ((zlib_header[0] & 0x0f) != 8 || cinfo > 7)
     {
         MMLOG_WRN("Firmware segment uses unsupported compression (%02x %02x)\n",
-                  seg_hdr->zlib_header[0],
-                  seg_hdr->zlib_header[1]);
+                  zlib_header[0],
+                  zlib_header[1]);
+        return -EINVAL;
     }
 
-    ret = puff(buf, &dst_len, robuf.buf + sizeof(*seg_hdr), &src_len);
+    struct deflated_segment_stream stream = {
+        .driverd = driverd,
+        .file_read_cb = file_read_cb,
+        .file_read_offset = file_read_offset,
+        .remaining = compressed_len,
+        .address = base_address,
+    };
+
+
+    int ret = firmware_inflate(cinfo + 8,
+                               chunk_size,
+                               deflated_segment_read,
+                               deflated_segment_write,
+                               &stream,
+                               &output_len);
+    robuf_cleanup(&stream.robuf);
+
+
+    *file_read_offset += stream.remaining;
+
     if (ret != 0)
     {
         MMLOG_WRN("Failed to decompress fw chunk for %08lx: %d\n", base_address, ret);
-        goto cleanup;
+        return ret;
     }
 
-    if (dst_len != chunk_size)
+    if (output_len != chunk_size)
     {
-        MMLOG_WRN("Firmware decompressed size invalid (%lu, expect %u)\n", dst_len, chunk_size);
-        ret = -EFAULT;
-        goto cleanup;
+        MMLOG_WRN("Firmware decompressed size invalid (%lu, expect %u)\n", output_len, chunk_size);
+        return -EFAULT;
     }
 
-    MMLOG_DBG("Writing segment dest=0x%08lx, len=%u\n", base_address, tlv_hdr.len);
+    MMLOG_DBG("Wrote segment dest=0x%08lx, len=%u\n", base_address, chunk_size);
 
-    morse_trns_claim(driverd);
-    ret = morse_trns_write_multi_byte(driverd, base_address, buf, rounded_chunk_size);
-    if (ret != 0)
-    {
-        MMLOG_WRN("Failed to write %u octets to %08lx\n", rounded_chunk_size, base_address);
-    }
-    morse_trns_release(driverd);
-
-cleanup:
-    mmosal_free(buf);
-    robuf_cleanup(&robuf);
-    return ret;
+    return 0;
 }
 
 int morse_firmware_load_mbin(struct driver_data *driverd, morse_file_read_cb_t file_read_cb)
@@ -713,6 +713,8 @@ static void convert_tx_metadata_to_tx_info(struct morse_skb_tx_info *tx_info,
     tx_info->tid_params =
         ((tx_metadata->flags & MMDRV_TX_FLAG_AMPDU_ENABLED) ? TX_INFO_TID_PARAMS_AMPDU_ENABLED :
                                                               0) |
+        ((tx_metadata->flags & MMDRV_TX_FLAG_AMSDU_SUPPORTED) ? TX_INFO_TID_PARAMS_AMSDU_SUPPORTED :
+                                                                0) |
         (tx_metadata->tid_max_reorder_buf_size ? (tx_metadata->tid_max_reorder_buf_size - 1) : 0);
 
     for (ii = 0; ii < sizeof(tx_info->rates) / sizeof(tx_info->rates[0]); ii++)
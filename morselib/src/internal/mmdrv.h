@@ -272,6 +272,8 @@ enum mmdrv_tx_metadata_flags
     MMDRV_TX_FLAG_NO_ACK = 0x10,
 
     MMDRV_TX_FLAG_CR_1MHZ_PRE_ENABLED = 0x20,
+
+    MMDRV_TX_FLAG_AMSDU_SUPPORTED = 0x40,
 };
 
 
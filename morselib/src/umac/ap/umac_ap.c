@@ -245,6 +245,56 @@ error:
     return status;
 }
 
+
+static enum mmwlan_status umac_ap_build_beacon_template(struct umac_ap_data *data)
+{
+    mmosal_free(data->beacon_template);
+    data->beacon_template_len = 0;
+    data->beacon_tim_len = 0;
+
+    data->beacon_template = (uint8_t *)mmosal_malloc(data->config.head_len +
+                                                     S1G_TIM_MAX_BUILD_LEN +
+                                                     data->config.tail_len);
+    if (data->beacon_template == NULL)
+    {
+        return MMWLAN_NO_MEM;
+    }
+
+
+    memcpy(data->beacon_template, data->config.head, data->config.head_len);
+    data->beacon_tim_offset = data->config.head_len;
+    memcpy(data->beacon_template + data->beacon_tim_offset,
+           data->config.tail,
+           data->config.tail_len);
+    data->beacon_template_len = data->config.head_len + data->config.tail_len;
+
+    return MMWLAN_SUCCESS;
+}
+
+
+static void umac_ap_patch_beacon_tim(struct umac_ap_data *data, bool traffic_indicator)
+{
+    uint8_t tim[S1G_TIM_MAX_BUILD_LEN];
+    struct consbuf cbuf = CONSBUF_INIT_WITH_BUF(tim, sizeof(tim));
+    ie_s1g_tim_build(&cbuf,
+                     data->dtim_count,
+                     data->config.dtim_period,
+                     traffic_indicator,
+                     data->bitmap);
+
+    uint8_t *tim_ie = data->beacon_template + data->beacon_tim_offset;
+    if (cbuf.offset != data->beacon_tim_len)
+    {
+
+        uint32_t tail_len =
+            data->beacon_template_len - data->beacon_tim_offset - data->beacon_tim_len;
+        memmove(tim_ie + cbuf.offset, tim_ie + data->beacon_tim_len, tail_len);
+        data->beacon_template_len = data->beacon_tim_offset + cbuf.offset + tail_len;
+        data->beacon_tim_len = cbuf.offset;
+    }
+    memcpy(tim_ie, tim, cbuf.offset);
+}
+
 enum mmwlan_status umac_ap_start(struct umac_data *umacd, const struct umac_ap_config *cfg)
 {
     struct umac_ap_data *data = umac_data_get_ap(umacd);
@@ -267,6 +317,18 @@ enum mmwlan_status umac_ap_start(struct umac_data *umacd, const struct umac_ap_c
     }
 
     data->dtim_count = data->config.dtim_period - 1;
+
+    status = umac_ap_build_beacon_template(data);
+    if (status != MMWLAN_SUCCESS)
+    {
+        MMLOG_ERR("Failed to allocate beacon template\n");
+        goto failure;
+    }
+
+
+    mmosal_free(data->probe_rsp_template);
+    data->probe_rsp_template = NULL;
+
     umac_ap_set_stad_sleep_state_(data->sta_common, true);
     umac_ap_set_stad_state_(data->sta_common, MORSE_STA_AUTHORIZED);
     umac_sta_data_set_security(data->sta_common, data->args.security_type, data->args.pmf_mode);
@@ -344,24 +406,12 @@ failure:
     mmosal_free(data->config.head);
     mmosal_free(data->config.tail);
     memset(&(data->config), 0, sizeof(data->config));
+    mmosal_free(data->beacon_template);
+    data->beacon_template = NULL;
+    data->beacon_template_len = 0;
     return status;
 }
 
-void umac_ap_build_beacon(struct umac_data *umacd, struct consbuf *buf, void *params)
-{
-    const bool *traffic_indicator = (const bool *)params;
-
-    struct umac_ap_data *data = umac_data_get_ap(umacd);
-    MMOSAL_ASSERT(data != NULL);
-
-    consbuf_append(buf, data->config.head, data->config.head_len);
-    ie_s1g_tim_build(buf,
-                     data->dtim_count,
-                     data->config.dtim_period,
-                     *traffic_indicator,
-                     data->bitmap);
-    consbuf_append(buf, data->config.tail, data->config.tail_len);
-}
 
 struct mmpkt *umac_ap_get_beacon(struct umac_data *umacd)
 {
@@ -374,7 +424,16 @@ struct mmpkt *umac_ap_get_beacon(struct umac_data *umacd)
     bool traffic_indicator = (data->dtim_count == 0) &&
                              umac_sta_data_get_queued_len(data->sta_common);
     MMOSAL_TASK_EXIT_CRITICAL();
-    struct mmpkt *beacon = build_mgmt_frame(umacd, umac_ap_build_beacon, &traffic_indicator);
+    umac_ap_patch_beacon_tim(data, traffic_indicator);
+
+    struct mmpkt *beacon =
+        umac_datapath_alloc_raw_tx_mmpkt(MMDRV_PKT_CLASS_MGMT, 0, data->beacon_template_len);
+    if (beacon != NULL)
+    {
+        struct mmpktview *view = mmpkt_open(beacon);
+        mmpkt_append_data(view, data->beacon_template, data->beacon_template_len);
+        mmpkt_close(&view);
+    }
 
 
     if (data->dtim_count == 0)
@@ -412,16 +471,12 @@ struct mmpkt *umac_ap_get_beacon(struct umac_data *umacd)
     return beacon;
 }
 
-void umac_ap_handle_probe_req(struct umac_data *umacd, struct mmpktview *rxbufview)
+static enum mmwlan_status umac_ap_build_probe_rsp_template(struct umac_data *umacd,
+                                                           struct umac_ap_data *data)
 {
-    struct umac_ap_data *data = umac_data_get_ap(umacd);
-    if (data == NULL)
-    {
-        MMLOG_WRN("Ignoring probe req\n");
-        return;
-    }
-
-    const struct dot11_hdr *probe_req_header = (struct dot11_hdr *)mmpkt_get_data_start(rxbufview);
+    mmosal_free(data->probe_rsp_template);
+    data->probe_rsp_template = NULL;
+    data->probe_rsp_template_len = 0;
 
 
     uint16_t capability_info = DOT11_MASK_CAPINFO_ESS;
@@ -433,45 +488,155 @@ void umac_ap_handle_probe_req(struct umac_data *umacd, struct mmpktview *rxbufvi
     }
 
     struct frame_data_probe_response probe_rsp_args = {
-        .destination_address = dot11_get_sa(probe_req_header),
+        .destination_address = mac_addr_broadcast,
         .timestamp = NULL,
         .bssid = data->config.bssid,
         .ssid = data->config.ssid,
         .ssid_len = data->config.ssid_len,
         .ies = data->config.tail,
         .ies_len = data->config.tail_len,
+        .beacon_interval = data->config.beacon_interval_tus,
         .capability_info = capability_info,
     };
 
-    struct mmpkt *probe_rsp = build_mgmt_frame(umacd, frame_probe_response_build, &probe_rsp_args);
+    struct consbuf cbuf = CONSBUF_INIT_WITHOUT_BUF;
+    frame_probe_response_build(umacd, &cbuf, &probe_rsp_args);
+
+    uint8_t *template = (uint8_t *)mmosal_malloc(cbuf.offset);
+    if (template == NULL)
+    {
+        return MMWLAN_NO_MEM;
+    }
+
+    consbuf_reinit(&cbuf, template, cbuf.offset);
+    frame_probe_response_build(umacd, &cbuf, &probe_rsp_args);
+
+    data->probe_rsp_template = template;
+    data->probe_rsp_template_len = cbuf.offset;
+    return MMWLAN_SUCCESS;
+}
+
+
+static void umac_ap_tx_probe_rsp(struct umac_data *umacd,
+                                 struct umac_ap_data *data,
+                                 const uint8_t *destination_address,
+                                 uint8_t bw_mhz)
+{
+    struct mmpkt *probe_rsp = umac_datapath_alloc_raw_tx_mmpkt(MMDRV_PKT_CLASS_MGMT,
+                                                               0,
+                                                               data->probe_rsp_template_len);
     if (probe_rsp == NULL)
     {
         MMLOG_WRN("Failed to contruct probe rsp\n");
         return;
     }
 
-    struct mmdrv_rx_metadata *rx_metadata = mmpkt_get_metadata(mmpkt_from_view(rxbufview)).rx;
-
-    MMOSAL_ASSERT(rx_metadata != NULL);
+    struct mmpktview *view = mmpkt_open(probe_rsp);
+    mmpkt_append_data(view, data->probe_rsp_template, data->probe_rsp_template_len);
+    struct dot11_hdr *hdr = (struct dot11_hdr *)mmpkt_get_data_start(view);
+    mac_addr_copy(hdr->addr1, destination_address);
+    mmpkt_close(&view);
 
     struct mmrc_rate mmrc_rate_override = {
         .attempts = 5,
         .rate = MMRC_MCS0,
-        .bw = (rx_metadata->bw_mhz == 1) ? MMRC_BW_1MHZ : MMRC_BW_2MHZ,
+        .bw = (bw_mhz == 1) ? MMRC_BW_1MHZ : MMRC_BW_2MHZ,
         .guard = MMRC_GUARD_LONG,
         .ss = MMRC_SPATIAL_STREAM_1,
         .flags = 0,
     };
 
     MMLOG_DBG("Scheduled Probe RSP TX (BSSID=" MM_MAC_ADDR_FMT ", DA=" MM_MAC_ADDR_FMT ")\n",
-              MM_MAC_ADDR_VAL(probe_rsp_args.bssid),
-              MM_MAC_ADDR_VAL(probe_rsp_args.destination_address));
+              MM_MAC_ADDR_VAL(data->config.bssid),
+              MM_MAC_ADDR_VAL(destination_address));
     enum mmwlan_status status =
         umac_datapath_tx_mgmt_frame_ap(umacd, probe_rsp, &mmrc_rate_override);
     if (status != MMWLAN_SUCCESS)
     {
         MMLOG_WRN("Failed to send probe rsp\n");
+        return;
     }
+
+    umac_stats_increment_ap_probe_rsp_sent(umacd);
+}
+
+#if UMAC_AP_PROBE_RSP_COALESCE_MS > 0
+
+static void umac_ap_probe_rsp_coalesce_timeout_handler(void *arg1, void *arg2)
+{
+    struct umac_data *umacd = (struct umac_data *)arg1;
+    MM_UNUSED(arg2);
+
+    struct umac_ap_data *data = umac_data_get_ap(umacd);
+    if (data == NULL || !data->probe_rsp_pending)
+    {
+        return;
+    }
+
+    data->probe_rsp_pending = false;
+    umac_ap_tx_probe_rsp(umacd, data, mac_addr_broadcast, data->probe_rsp_bw_mhz);
+}
+
+
+static bool umac_ap_coalesce_probe_rsp(struct umac_data *umacd,
+                                       struct umac_ap_data *data,
+                                       uint8_t bw_mhz)
+{
+    if (data->probe_rsp_pending)
+    {
+        data->probe_rsp_bw_mhz = MM_MIN(data->probe_rsp_bw_mhz, bw_mhz);
+        umac_stats_increment_ap_probe_rsp_suppressed(umacd);
+        return true;
+    }
+
+    bool ok = umac_core_register_timeout(umacd,
+                                         UMAC_AP_PROBE_RSP_COALESCE_MS,
+                                         umac_ap_probe_rsp_coalesce_timeout_handler,
+                                         umacd,
+                                         NULL);
+    if (!ok)
+    {
+
+        return false;
+    }
+
+    data->probe_rsp_pending = true;
+    data->probe_rsp_bw_mhz = bw_mhz;
+    return true;
+}
+#endif
+
+void umac_ap_handle_probe_req(struct umac_data *umacd, struct mmpktview *rxbufview)
+{
+    struct umac_ap_data *data = umac_data_get_ap(umacd);
+    if (data == NULL)
+    {
+        MMLOG_WRN("Ignoring probe req\n");
+        return;
+    }
+
+    if (data->probe_rsp_template == NULL &&
+        umac_ap_build_probe_rsp_template(umacd, data) != MMWLAN_SUCCESS)
+    {
+        MMLOG_WRN("Failed to contruct probe rsp\n");
+        return;
+    }
+
+    const struct dot11_hdr *probe_req_header = (struct dot11_hdr *)mmpkt_get_data_start(rxbufview);
+    struct mmdrv_rx_metadata *rx_metadata = mmpkt_get_metadata(mmpkt_from_view(rxbufview)).rx;
+
+    MMOSAL_ASSERT(rx_metadata != NULL);
+
+#if UMAC_AP_PROBE_RSP_COALESCE_MS > 0
+
+    if (mm_mac_addr_is_multicast(probe_req_header->addr1) &&
+        umac_ap_coalesce_probe_rsp(umacd, data, rx_metadata->bw_mhz))
+    {
+        return;
+    }
+#endif
+
+    umac_ap_tx_probe_rsp(umacd, data, dot11_get_sa(probe_req_header), rx_metadata->bw_mhz);
 }
 
 
@@ -759,7 +924,7 @@ static enum mmwlan_status umac_ap_remove_sta_record(struct umac_data *umacd,
 
     umac_rc_stop(stad);
     umac_rc_deinit(stad);
-    umac_datapath_stad_flush_txq(umacd, stad);
+    umac_datapath_stad_flush(umacd, stad);
 
     mmosal_free(stad);
 
@@ -898,19 +1063,26 @@ static bool umac_ap_get_stad_sleep_state(struct umac_sta_data *stad)
     return sta_data->asleep;
 }
 
-void umac_ap_queue_pkt(struct umac_data *umacd, struct umac_sta_data *stad, struct mmpkt *mmpkt)
+void umac_ap_queue_pkts(struct umac_data *umacd,
+                        struct umac_sta_data *stad,
+                        struct mmpkt_list *mmpkts)
 {
     struct umac_ap_data *data = umac_data_get_ap(umacd);
+    struct mmpkt *mmpkt;
     if (data == NULL)
     {
         MMOSAL_DEV_ASSERT(false);
-        mmpkt_release(mmpkt);
+        mmpkt_list_clear(mmpkts);
         return;
     }
 
     MMOSAL_TASK_ENTER_CRITICAL();
-    umac_sta_data_queue_pkt(stad, mmpkt);
-    umac_stats_update_datapath_txq_high_water_mark(umacd, ++data->num_pkts_queued);
+    while ((mmpkt = mmpkt_list_dequeue(mmpkts)) != NULL)
+    {
+        umac_sta_data_queue_pkt(stad, mmpkt);
+        ++data->num_pkts_queued;
+    }
+    umac_stats_update_datapath_txq_high_water_mark(umacd, data->num_pkts_queued);
     MMOSAL_TASK_EXIT_CRITICAL();
 
     bool asleep = umac_ap_get_stad_sleep_state(stad);
@@ -978,9 +1150,11 @@ bool umac_ap_tx_dequeue_frame(struct umac_data *umacd,
         return false;
     }
 
+    struct mmpkt_list dropped = MMPKT_LIST_INIT;
     bool has_more = false;
     MMOSAL_TASK_ENTER_CRITICAL();
-    struct mmpkt *txbuf = umac_sta_data_pop_pkt(stad);
+    struct mmpkt *txbuf = umac_sta_data_pop_pkt(stad, &dropped);
+    data->num_pkts_queued -= mmpkt_list_length(&dropped);
     if (txbuf != NULL)
     {
         has_more = --data->num_pkts_queued;
@@ -990,12 +1164,35 @@ bool umac_ap_tx_dequeue_frame(struct umac_data *umacd,
         stad = NULL;
     }
     MMOSAL_TASK_EXIT_CRITICAL();
+    mmpkt_list_clear(&dropped);
 
     *stad_ptr = stad;
     *txbuf_ptr = txbuf;
     return has_more;
 }
 
+struct mmpkt *umac_ap_tx_dequeue_frame_if(struct umac_data *umacd,
+                                          struct umac_sta_data *stad,
+                                          bool (*match)(struct mmpkt *txbuf, void *arg),
+                                          void *arg)
+{
+    struct umac_ap_data *data = umac_data_get_ap(umacd);
+    if (data == NULL)
+    {
+        return NULL;
+    }
+
+    MMOSAL_TASK_ENTER_CRITICAL();
+    struct mmpkt *txbuf = umac_sta_data_pop_pkt_if(stad, match, arg);
+    if (txbuf != NULL)
+    {
+        --data->num_pkts_queued;
+    }
+    MMOSAL_TASK_EXIT_CRITICAL();
+
+    return txbuf;
+}
+
 bool umac_ap_set_stad_sleep_state(struct umac_sta_data *stad, bool asleep)
 {
     uint16_t aid = umac_sta_data_get_aid(stad);
@@ -1120,6 +1317,13 @@ enum mmwlan_status umac_ap_disable_ap(struct umac_data *umacd)
     data->config.head = NULL;
     mmosal_free(data->config.tail);
     data->config.tail = NULL;
+    mmosal_free(data->beacon_template);
+    data->beacon_template = NULL;
+    mmosal_free(data->probe_rsp_template);
+    data->probe_rsp_template = NULL;
+#if UMAC_AP_PROBE_RSP_COALESCE_MS > 0
+    umac_core_cancel_timeout(umacd, umac_ap_probe_rsp_coalesce_timeout_handler, umacd, NULL);
+#endif
 
     MMLOG_DBG("Removing AP interface\n");
     umac_interface_remove(umacd, UMAC_INTERFACE_AP);
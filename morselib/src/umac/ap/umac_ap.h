@@ -103,7 +103,9 @@ struct umac_sta_data *umac_ap_lookup_sta_by_addr(struct umac_data *umacd, const
 struct umac_sta_data *umac_ap_lookup_sta_by_aid(struct umac_data *umacd, uint16_t aid);
 
 
-void umac_ap_queue_pkt(struct umac_data *umacd, struct umac_sta_data *stad, struct mmpkt *mmpkt);
+void umac_ap_queue_pkts(struct umac_data *umacd,
+                        struct umac_sta_data *stad,
+                        struct mmpkt_list *mmpkts);
 
 
 bool umac_ap_is_stad_paused(struct umac_sta_data *stad);
@@ -127,3 +129,9 @@ bool umac_ap_tx_dequeue_frame(struct umac_data *umacd,
                               struct umac_sta_data **stad,
                               struct mmpkt **txbuf);
 
+
+struct mmpkt *umac_ap_tx_dequeue_frame_if(struct umac_data *umacd,
+                                          struct umac_sta_data *stad,
+                                          bool (*match)(struct mmpkt *txbuf, void *arg),
+                                          void *arg);
+
@@ -10,6 +10,11 @@
 #include "umac/ap/traffic_bitmap.h"
 
 
+#ifndef UMAC_AP_PROBE_RSP_COALESCE_MS
+#define UMAC_AP_PROBE_RSP_COALESCE_MS (10)
+#endif
+
+
 struct umac_ap_data
 {
 
@@ -21,6 +26,24 @@ struct umac_ap_data
 
     uint8_t dtim_count;
 
+
+    uint8_t *beacon_template;
+
+    uint32_t beacon_template_len;
+
+    uint32_t beacon_tim_offset;
+
+    uint32_t beacon_tim_len;
+
+
+    uint8_t *probe_rsp_template;
+
+    uint32_t probe_rsp_template_len;
+
+    bool probe_rsp_pending;
+
+    uint8_t probe_rsp_bw_mhz;
+
     struct umac_sta_data *sta_common;
 
     uint32_t max_stas;
@@ -141,18 +141,33 @@ static void umac_ba_rx_delba(struct umac_sta_data *stad, const uint8_t *field, u
     struct umac_data *umacd = umac_sta_data_get_umacd(stad);
     umac_core_cancel_timeout(umacd, umac_ba_addba_req_timeout_handler, stad, session);
 
-    umac_datapath_flush_rx_reorder_list_for_tid(stad, session->tid);
+    if (session == &data->sessions.recipient[tid])
+    {
+        umac_datapath_flush_rx_reorder_list_for_tid(stad, session->tid);
+    }
 
     MMLOG_DBG("BA session disabled. TID %u.\n", session->tid);
     session->status = UMAC_BA_DISABLED;
 }
 
 
-static uint16_t umac_ba_build_param_set(struct umac_ba_session *session)
+static bool umac_ba_is_amsdu_supported_locally(struct umac_sta_data *stad)
+{
+    struct umac_data *umacd = umac_sta_data_get_umacd(stad);
+    return umac_config_is_amsdu_enabled(umacd) &&
+           MORSE_CAP_SUPPORTED(umac_interface_get_capabilities(umacd), AMSDU);
+}
+
+
+static uint16_t umac_ba_build_param_set(struct umac_sta_data *stad,
+                                        struct umac_ba_session *session)
 {
     uint16_t param_set = 0;
 
-    DOT11_BA_PARAMETER_SET_FIELD_SET_AMSDU_SUPPORTED(param_set, DOT11_BA_AMSDU_NOT_SUPPORTED);
+    DOT11_BA_PARAMETER_SET_FIELD_SET_AMSDU_SUPPORTED(param_set,
+                                                     umac_ba_is_amsdu_supported_locally(stad) ?
+                                                         DOT11_BA_AMSDU_SUPPORTED :
+                                                         DOT11_BA_AMSDU_NOT_SUPPORTED);
     DOT11_BA_PARAMETER_SET_FIELD_SET_BA_POLICY(param_set, DOT11_BA_POLICY_IMMEDIATE);
     DOT11_BA_PARAMETER_SET_FIELD_SET_TID(param_set, (uint16_t)session->tid);
     DOT11_BA_PARAMETER_SET_FIELD_SET_BUFFER_SIZE(param_set, session->buffer_size);
@@ -169,7 +184,7 @@ static void umac_ba_tx_addba_resp(struct umac_sta_data *stad, struct umac_ba_ses
     resp.ba_action = DOT11_BA_ACTION_NDP_ADDBA_RESP;
     resp.dialog_token = session->dialog_token;
     resp.status_code = htole16(DOT11_STATUS_SUCCESS);
-    resp.ba_param_set = umac_ba_build_param_set(session);
+    resp.ba_param_set = umac_ba_build_param_set(stad, session);
 
     struct frame_data_action params = { .bssid = umac_sta_data_peek_bssid(stad),
                                         .dst_address = umac_sta_data_peek_peer_addr(stad),
@@ -247,6 +262,10 @@ static void umac_ba_rx_addba_resp(struct umac_sta_data *stad,
 
     session->buffer_size = min_u16(dot11_ba_parameter_set_field_get_buffer_size(resp->ba_param_set),
                                    session->buffer_size);
+    session->amsdu_supported =
+        umac_ba_is_amsdu_supported_locally(stad) &&
+        (dot11_ba_parameter_set_field_get_amsdu_supported(resp->ba_param_set) ==
+         DOT11_BA_AMSDU_SUPPORTED);
 
     MMLOG_DBG("BA session successful, originator. TID %u.\n", session->tid);
     session->status = UMAC_BA_SUCCESS;
@@ -260,7 +279,7 @@ static void umac_ba_tx_addba_req(struct umac_sta_data *stad, struct umac_ba_sess
     req.category = DOT11_ACTION_CATEGORY_BLOCK_ACK;
     req.ba_action = DOT11_BA_ACTION_NDP_ADDBA_REQ;
     req.dialog_token = session->dialog_token;
-    req.ba_param_set = umac_ba_build_param_set(session);
+    req.ba_param_set = umac_ba_build_param_set(stad, session);
     req.ba_timeout = htole16(session->timeout);
     req.ba_ssc = session->starting_seq_ctrl;
 
@@ -342,6 +361,12 @@ static void umac_ba_rx_addba_req(struct umac_sta_data *stad,
     MMOSAL_DEV_ASSERT(req->ba_timeout == DOT11_BLOCK_ACK_TIMEOUT_DISABLED);
     session->timeout = DOT11_BLOCK_ACK_TIMEOUT_DISABLED;
 
+    if (!umac_datapath_alloc_rx_reorder_list_for_tid(stad, tid))
+    {
+        umac_ba_tx_delba(stad, DOT11_DELBA_INITIATOR_RECIPIENT, tid, DOT11_REASON_UNSPECIFIED);
+        return;
+    }
+
     umac_ba_tx_addba_resp(stad, session);
 }
 
@@ -456,6 +481,11 @@ void umac_ba_session_deinit(struct umac_sta_data *stad,
         return;
     }
 
+    if (initiator == DOT11_DELBA_INITIATOR_RECIPIENT)
+    {
+        umac_datapath_flush_rx_reorder_list_for_tid(stad, tid);
+    }
+
     memset(session, 0, sizeof(*session));
     MMLOG_DBG("Successful deinit of BA session. Initiator (%u), TID (%u)\n", initiator, tid);
 }
@@ -520,3 +550,14 @@ bool umac_ba_is_ampdu_permitted(struct umac_sta_data *stad, uint8_t tid)
 
     return (data->sessions.originator[tid].status == UMAC_BA_SUCCESS);
 }
+
+bool umac_ba_is_amsdu_permitted(struct umac_sta_data *stad, uint8_t tid)
+{
+    if (!umac_ba_is_ampdu_permitted(stad, tid))
+    {
+        return false;
+    }
+
+    struct umac_ba_sta_data *data = umac_sta_data_get_ba(stad);
+    return data->sessions.originator[tid].amsdu_supported;
+}
@@ -41,3 +41,6 @@ void umac_ba_set_expected_rx_seq_num(struct umac_sta_data *stad, uint8_t tid, ui
 bool umac_ba_is_ampdu_permitted(struct umac_sta_data *stad, uint8_t tid);
 
 
+bool umac_ba_is_amsdu_permitted(struct umac_sta_data *stad, uint8_t tid);
+
+
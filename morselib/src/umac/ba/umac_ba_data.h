@@ -30,6 +30,8 @@ struct umac_ba_session
 
     uint16_t buffer_size;
 
+    bool amsdu_supported;
+
     uint16_t timeout;
 
     uint16_t starting_seq_ctrl;
@@ -50,6 +50,8 @@ static void populate_default_qos_queue_params(
     params->txop_max_us = MORSE_DEFAULT_TXOP_MAX_US;
 }
 
+static const struct mmwlan_txq_params default_txq_params = MMWLAN_TXQ_PARAMS_INIT;
+
 void umac_config_init(struct umac_data *umacd)
 {
     struct umac_config_data *data = umac_data_get_config(umacd);
@@ -62,6 +64,9 @@ void umac_config_init(struct umac_data *umacd)
     data->opclass_check_enabled = true;
     data->ctrl_resp_out_1mhz_enabled = false;
     data->ampdu_enabled = true;
+    data->amsdu_enabled = true;
+    data->amsdu_max_len = UMAC_DATAPATH_DEFAULT_AMSDU_MAX_LEN;
+    data->amsdu_max_subframes = UMAC_DATAPATH_DEFAULT_AMSDU_MAX_SUBFRAMES;
     data->chip_powerdown_enabled = false;
     data->rts_threshold = 0;
     data->fragmentation_threshold = 0;
@@ -77,6 +82,7 @@ void umac_config_init(struct umac_data *umacd)
     data->beacon_vendor_ie_filter = NULL;
     data->datapath_rx_reorder_list_maxlen = UMAC_DATAPATH_DEFAULT_RXREORDERQ_MAXLEN;
     populate_default_qos_queue_params(data->default_qos_queue_params);
+    data->txq_params = default_txq_params;
     data->mcs10_mode = MMWLAN_MCS10_MODE_DISABLED;
     data->supp_scan_home_dwell_time_ms = MMWLAN_SCAN_DEFAULT_DWELL_ON_HOME_MS;
     data->duty_cycle_mode = MMWLAN_DUTY_CYCLE_MODE_SPREAD;
@@ -168,6 +174,37 @@ bool umac_config_is_ampdu_enabled(struct umac_data *umacd)
     return data->ampdu_enabled;
 }
 
+void umac_config_set_amsdu_enabled(struct umac_data *umacd, bool enabled)
+{
+    struct umac_config_data *data = umac_data_get_config(umacd);
+    data->amsdu_enabled = enabled;
+}
+
+bool umac_config_is_amsdu_enabled(struct umac_data *umacd)
+{
+    struct umac_config_data *data = umac_data_get_config(umacd);
+    return data->amsdu_enabled;
+}
+
+void umac_config_set_amsdu_limits(struct umac_data *umacd, uint16_t max_len, uint8_t max_subframes)
+{
+    struct umac_config_data *data = umac_data_get_config(umacd);
+    data->amsdu_max_len = max_len;
+    data->amsdu_max_subframes = max_subframes;
+}
+
+uint16_t umac_config_get_amsdu_max_len(struct umac_data *umacd)
+{
+    struct umac_config_data *data = umac_data_get_config(umacd);
+    return data->amsdu_max_len;
+}
+
+uint8_t umac_config_get_amsdu_max_subframes(struct umac_data *umacd)
+{
+    struct umac_config_data *data = umac_data_get_config(umacd);
+    return data->amsdu_max_subframes;
+}
+
 void umac_config_set_non_tim_mode_enabled(struct umac_data *umacd, bool non_tim_mode_enabled)
 {
     struct umac_config_data *data = umac_data_get_config(umacd);
@@ -379,6 +416,18 @@ const struct mmwlan_qos_queue_params *umac_config_get_default_qos_queue_params(
     return data->default_qos_queue_params;
 }
 
+void umac_config_set_txq_params(struct umac_data *umacd, const struct mmwlan_txq_params *params)
+{
+    struct umac_config_data *data = umac_data_get_config(umacd);
+    data->txq_params = *params;
+}
+
+const struct mmwlan_txq_params *umac_config_get_txq_params(struct umac_data *umacd)
+{
+    struct umac_config_data *data = umac_data_get_config(umacd);
+    return &data->txq_params;
+}
+
 void umac_config_set_mcs10_mode(struct umac_data *umacd, enum mmwlan_mcs10_mode mcs10_mode)
 {
     struct umac_config_data *data = umac_data_get_config(umacd);
@@ -65,6 +65,21 @@ void umac_config_set_ampdu_enabled(struct umac_data *umacd, bool enabled);
 bool umac_config_is_ampdu_enabled(struct umac_data *umacd);
 
 
+void umac_config_set_amsdu_enabled(struct umac_data *umacd, bool enabled);
+
+
+bool umac_config_is_amsdu_enabled(struct umac_data *umacd);
+
+
+void umac_config_set_amsdu_limits(struct umac_data *umacd, uint16_t max_len, uint8_t max_subframes);
+
+
+uint16_t umac_config_get_amsdu_max_len(struct umac_data *umacd);
+
+
+uint8_t umac_config_get_amsdu_max_subframes(struct umac_data *umacd);
+
+
 void umac_config_set_non_tim_mode_enabled(struct umac_data *umacd, bool non_tim_mode_enabled);
 
 
@@ -174,6 +189,12 @@ const struct mmwlan_qos_queue_params *umac_config_get_default_qos_queue_params(
     struct umac_data *umacd);
 
 
+void umac_config_set_txq_params(struct umac_data *umacd, const struct mmwlan_txq_params *params);
+
+
+const struct mmwlan_txq_params *umac_config_get_txq_params(struct umac_data *umacd);
+
+
 void umac_config_set_mcs10_mode(struct umac_data *umacd, enum mmwlan_mcs10_mode mcs10_mode);
 
 
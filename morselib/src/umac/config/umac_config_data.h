@@ -17,6 +17,9 @@ struct umac_config_data
     bool opclass_check_enabled;
     bool ctrl_resp_out_1mhz_enabled;
     bool ampdu_enabled;
+    bool amsdu_enabled;
+    uint16_t amsdu_max_len;
+    uint8_t amsdu_max_subframes;
     bool chip_powerdown_enabled;
     uint32_t rts_threshold;
     uint32_t fragmentation_threshold;
@@ -32,6 +35,7 @@ struct umac_config_data
     const struct mmwlan_beacon_vendor_ie_filter *beacon_vendor_ie_filter;
     uint32_t datapath_rx_reorder_list_maxlen;
     struct mmwlan_qos_queue_params default_qos_queue_params[MMWLAN_QOS_QUEUE_NUM_ACIS];
+    struct mmwlan_txq_params txq_params;
     enum mmwlan_mcs10_mode mcs10_mode;
     uint32_t supp_scan_home_dwell_time_ms;
     enum mmwlan_duty_cycle_mode duty_cycle_mode;
@@ -268,6 +268,30 @@ struct umac_evt
 
             volatile enum mmwlan_status *status;
         } relay_stop;
+
+        struct
+        {
+
+            uint8_t *buf;
+
+            size_t *len;
+
+            struct mmosal_semb *semb;
+
+            volatile enum mmwlan_status *status;
+        } pmksa_save;
+
+        struct
+        {
+
+            const uint8_t *buf;
+
+            size_t len;
+
+            struct mmosal_semb *semb;
+
+            volatile enum mmwlan_status *status;
+        } pmksa_load;
     } args;
 };
 
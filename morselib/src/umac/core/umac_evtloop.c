@@ -41,6 +41,9 @@ static uint32_t evtloop_iteration(struct umac_data *umacd, struct umac_core_data
     num_timeouts_fired = umac_timeoutq_dispatch(core);
     umac_stats_increment_timeouts_fired(umacd, num_timeouts_fired);
 
+
+    umac_datapath_deliver_rx_batches(umacd);
+
     if (datapath_pending || !umac_evtq_is_empty(&(core->evtq)))
     {
 
@@ -8,6 +8,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "mmpkt_list.h"
 #include "mmwlan.h"
 
 
@@ -172,7 +173,12 @@ enum mmwlan_security_type umac_sta_data_get_security_type(struct umac_sta_data *
 void umac_sta_data_queue_pkt(struct umac_sta_data *stad, struct mmpkt *mmpkt);
 
 
-struct mmpkt *umac_sta_data_pop_pkt(struct umac_sta_data *stad);
+struct mmpkt *umac_sta_data_pop_pkt(struct umac_sta_data *stad, struct mmpkt_list *dropped);
+
+
+struct mmpkt *umac_sta_data_pop_pkt_if(struct umac_sta_data *stad,
+                                       bool (*match)(struct mmpkt *mmpkt, void *arg),
+                                       void *arg);
 
 
 uint32_t umac_sta_data_get_queued_len(struct umac_sta_data *stad);
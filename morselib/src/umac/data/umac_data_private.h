@@ -38,5 +38,5 @@ struct umac_sta_data
     struct umac_keys_sta_data keys;
     struct umac_datapath_sta_data datapath;
     struct umac_rc_sta_data rc;
-    struct mmpkt_list txq;
+    struct datapath_txq_data txq[DOT11_ACI_NUM_ACS];
 };
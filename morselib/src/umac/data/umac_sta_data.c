@@ -4,7 +4,11 @@
  */
 
 #include "mmwlan.h"
+#include "mmdrv.h"
 #include "umac_data_private.h"
+#include "umac/config/umac_config.h"
+#include "umac/datapath/umac_datapath.h"
+#include "umac/stats/umac_stats.h"
 
 struct umac_data *umac_sta_data_get_umacd(struct umac_sta_data *stad)
 {
@@ -29,6 +33,7 @@ void umac_sta_data_set_vif_id(struct umac_sta_data *stad, uint16_t vif_id)
 {
     MMOSAL_ASSERT(stad != NULL);
     stad->vif_id = vif_id;
+    umac_datapath_invalidate_tx_templates(stad);
 }
 
 uint16_t umac_sta_data_get_vif_id(struct umac_sta_data *stad)
@@ -41,6 +46,7 @@ void umac_sta_data_set_bssid(struct umac_sta_data *stad, const uint8_t *bssid)
 {
     MMOSAL_ASSERT(stad != NULL);
     memcpy(stad->bssid, bssid, sizeof(stad->bssid));
+    umac_datapath_invalidate_tx_templates(stad);
 }
 
 void umac_sta_data_get_bssid(struct umac_sta_data *stad, uint8_t *bssid)
@@ -65,6 +71,7 @@ void umac_sta_data_set_peer_addr(struct umac_sta_data *stad, const uint8_t *addr
 {
     MMOSAL_ASSERT(stad != NULL);
     memcpy(stad->peer_addr, addr, sizeof(stad->peer_addr));
+    umac_datapath_invalidate_tx_templates(stad);
 }
 
 void umac_sta_data_get_peer_addr(struct umac_sta_data *stad, uint8_t *addr)
@@ -92,6 +99,7 @@ void umac_sta_data_set_security(struct umac_sta_data *stad,
     MMOSAL_ASSERT(stad != NULL);
     stad->security_type = security_type;
     stad->pmf_mode = pmf_mode;
+    umac_datapath_invalidate_tx_templates(stad);
 }
 
 bool umac_sta_data_pmf_is_required(struct umac_sta_data *stad)
@@ -106,22 +114,270 @@ enum mmwlan_security_type umac_sta_data_get_security_type(struct umac_sta_data *
     return stad->security_type;
 }
 
+static const enum dot11_aci txq_aci_priority_order[DOT11_ACI_NUM_ACS] = {
+    DOT11_ACI_AC_VO,
+    DOT11_ACI_AC_VI,
+    DOT11_ACI_AC_BE,
+    DOT11_ACI_AC_BK,
+};
+
 void umac_sta_data_queue_pkt(struct umac_sta_data *stad, struct mmpkt *pkt)
 {
     MMOSAL_ASSERT(stad != NULL);
     MMOSAL_DEV_ASSERT(pkt);
-    mmpkt_list_append(&stad->txq, pkt);
+    struct mmdrv_tx_metadata *tx_metadata = mmdrv_get_tx_metadata(pkt);
+    enum dot11_aci aci = dot11_tid_to_aci(tx_metadata->tid);
+    struct mmpkt_list *queue = &stad->txq[aci].queue;
+
+
+    tx_metadata->timeout_abs_ms = mmosal_get_time_ms();
+    mmpkt_list_append(queue, pkt);
+    umac_stats_update_datapath_txq_ac_high_water_mark(stad->umacd, aci, mmpkt_list_length(queue));
+}
+
+
+static int umac_sta_data_txq_select(struct umac_sta_data *stad,
+                                    const struct mmwlan_txq_params *params)
+{
+    for (unsigned pass = 0; pass < 2; pass++)
+    {
+        bool has_traffic = false;
+        for (unsigned ii = 0; ii < MM_ARRAY_COUNT(txq_aci_priority_order); ii++)
+        {
+            enum dot11_aci aci = txq_aci_priority_order[ii];
+            struct datapath_txq_data *txq = &stad->txq[aci];
+            if (mmpkt_list_is_empty(&txq->queue))
+            {
+                continue;
+            }
+
+            if (params->service_mode == MMWLAN_TXQ_SERVICE_STRICT)
+            {
+                return aci;
+            }
+
+            has_traffic = true;
+            if (txq->credit > 0)
+            {
+                txq->credit--;
+                return aci;
+            }
+        }
+
+        if (!has_traffic)
+        {
+            break;
+        }
+
+
+        for (unsigned aci = 0; aci < MM_ARRAY_COUNT(stad->txq); aci++)
+        {
+            stad->txq[aci].credit = params->weights[aci];
+        }
+    }
+
+    return -1;
+}
+
+static struct mmpkt *umac_sta_data_txq_dequeue(struct datapath_txq_data *txq,
+                                               uint32_t now_ms,
+                                               uint32_t *sojourn_ms)
+{
+    struct mmpkt *pkt = mmpkt_list_dequeue(&txq->queue);
+    if (pkt != NULL)
+    {
+        *sojourn_ms = now_ms - mmdrv_get_tx_metadata(pkt)->timeout_abs_ms;
+    }
+    return pkt;
+}
+
+static uint32_t umac_sta_data_txq_isqrt(uint32_t x)
+{
+    uint32_t result = 0;
+    uint32_t bit = 1ul << 30;
+
+    while (bit > x)
+    {
+        bit >>= 2;
+    }
+
+    while (bit != 0)
+    {
+        if (x >= result + bit)
+        {
+            x -= result + bit;
+            result = (result >> 1) + bit;
+        }
+        else
+        {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return result;
+}
+
+
+static uint32_t umac_sta_data_txq_codel_control_law(uint32_t time_ms,
+                                                    uint16_t interval_ms,
+                                                    uint16_t drop_count)
+{
+    MMOSAL_DEV_ASSERT(drop_count > 0 && drop_count <= DATAPATH_TXQ_CODEL_MAX_DROP_COUNT);
+    return time_ms +
+           ((uint32_t)interval_ms << 10) / umac_sta_data_txq_isqrt((uint32_t)drop_count << 20);
+}
+
+static bool umac_sta_data_txq_codel_ok_to_drop(struct datapath_txq_data *txq,
+                                               const struct mmwlan_txq_params *params,
+                                               uint32_t sojourn_ms,
+                                               uint32_t now_ms)
+{
+
+    if (sojourn_ms < params->codel_target_ms || mmpkt_list_is_empty(&txq->queue))
+    {
+        txq->first_above_time_ms = 0;
+        return false;
+    }
+
+    if (txq->first_above_time_ms == 0)
+    {
+        txq->first_above_time_ms = (now_ms + params->codel_interval_ms) | 1;
+        return false;
+    }
+
+    return mmosal_time_le(txq->first_above_time_ms, now_ms);
 }
 
-struct mmpkt *umac_sta_data_pop_pkt(struct umac_sta_data *stad)
+static struct mmpkt *umac_sta_data_txq_codel_drop(struct umac_sta_data *stad,
+                                                  enum dot11_aci aci,
+                                                  struct mmpkt *pkt,
+                                                  uint32_t now_ms,
+                                                  uint32_t *sojourn_ms,
+                                                  struct mmpkt_list *dropped)
+{
+    struct datapath_txq_data *txq = &stad->txq[aci];
+    mmpkt_list_append(dropped, pkt);
+    umac_stats_increment_datapath_txq_ac_aqm_drops(stad->umacd, aci);
+    if (txq->drop_count < DATAPATH_TXQ_CODEL_MAX_DROP_COUNT)
+    {
+        txq->drop_count++;
+    }
+    return umac_sta_data_txq_dequeue(txq, now_ms, sojourn_ms);
+}
+
+
+static struct mmpkt *umac_sta_data_txq_codel(struct umac_sta_data *stad,
+                                             enum dot11_aci aci,
+                                             const struct mmwlan_txq_params *params,
+                                             struct mmpkt *pkt,
+                                             uint32_t now_ms,
+                                             uint32_t *sojourn_ms,
+                                             struct mmpkt_list *dropped)
+{
+    struct datapath_txq_data *txq = &stad->txq[aci];
+    bool ok_to_drop = umac_sta_data_txq_codel_ok_to_drop(txq, params, *sojourn_ms, now_ms);
+
+    if (txq->dropping)
+    {
+        if (!ok_to_drop)
+        {
+            txq->dropping = false;
+        }
+
+        while (txq->dropping && mmosal_time_le(txq->drop_next_ms, now_ms))
+        {
+            pkt = umac_sta_data_txq_codel_drop(stad, aci, pkt, now_ms, sojourn_ms, dropped);
+            if (!umac_sta_data_txq_codel_ok_to_drop(txq, params, *sojourn_ms, now_ms))
+            {
+                txq->dropping = false;
+            }
+            else
+            {
+                txq->drop_next_ms = umac_sta_data_txq_codel_control_law(txq->drop_next_ms,
+                                                                        params->codel_interval_ms,
+                                                                        txq->drop_count);
+            }
+        }
+    }
+    else if (ok_to_drop)
+    {
+        uint16_t delta = txq->drop_count - txq->last_drop_count;
+        bool recently_dropping =
+            mmosal_time_lt(now_ms, txq->drop_next_ms + 16 * params->codel_interval_ms);
+
+        txq->drop_count = 0;
+        pkt = umac_sta_data_txq_codel_drop(stad, aci, pkt, now_ms, sojourn_ms, dropped);
+        (void)umac_sta_data_txq_codel_ok_to_drop(txq, params, *sojourn_ms, now_ms);
+        txq->dropping = true;
+
+
+        if (delta > 1 && recently_dropping)
+        {
+            txq->drop_count = delta;
+        }
+        txq->drop_next_ms =
+            umac_sta_data_txq_codel_control_law(now_ms, params->codel_interval_ms, txq->drop_count);
+        txq->last_drop_count = txq->drop_count;
+    }
+
+    return pkt;
+}
+
+struct mmpkt *umac_sta_data_pop_pkt(struct umac_sta_data *stad, struct mmpkt_list *dropped)
 {
     MMOSAL_ASSERT(stad != NULL);
-    return mmpkt_list_dequeue(&stad->txq);
+    const struct mmwlan_txq_params *params = umac_config_get_txq_params(stad->umacd);
+    int aci = umac_sta_data_txq_select(stad, params);
+    if (aci < 0)
+    {
+        return NULL;
+    }
+
+    uint32_t now_ms = mmosal_get_time_ms();
+    uint32_t sojourn_ms = 0;
+    struct mmpkt *pkt = umac_sta_data_txq_dequeue(&stad->txq[aci], now_ms, &sojourn_ms);
+    if (dropped != NULL && params->codel_target_ms != 0)
+    {
+        pkt = umac_sta_data_txq_codel(stad, aci, params, pkt, now_ms, &sojourn_ms, dropped);
+    }
+
+    if (pkt != NULL)
+    {
+        umac_stats_update_datapath_txq_ac_sojourn(stad->umacd, aci, sojourn_ms);
+    }
+    return pkt;
+}
+
+struct mmpkt *umac_sta_data_pop_pkt_if(struct umac_sta_data *stad,
+                                       bool (*match)(struct mmpkt *mmpkt, void *arg),
+                                       void *arg)
+{
+    MMOSAL_ASSERT(stad != NULL && match != NULL);
+    for (unsigned ii = 0; ii < MM_ARRAY_COUNT(txq_aci_priority_order); ii++)
+    {
+        enum dot11_aci aci = txq_aci_priority_order[ii];
+        struct datapath_txq_data *txq = &stad->txq[aci];
+        struct mmpkt *pkt = mmpkt_list_peek(&txq->queue);
+        if (pkt != NULL && match(pkt, arg))
+        {
+            uint32_t sojourn_ms = 0;
+            pkt = umac_sta_data_txq_dequeue(txq, mmosal_get_time_ms(), &sojourn_ms);
+            umac_stats_update_datapath_txq_ac_sojourn(stad->umacd, aci, sojourn_ms);
+            return pkt;
+        }
+    }
+    return NULL;
 }
 
 uint32_t umac_sta_data_get_queued_len(struct umac_sta_data *stad)
 {
-    return mmpkt_list_length(&stad->txq);
+    uint32_t len = 0;
+    for (unsigned aci = 0; aci < MM_ARRAY_COUNT(stad->txq); aci++)
+    {
+        len += mmpkt_list_length(&stad->txq[aci].queue);
+    }
+    return len;
 }
 
 bool umac_sta_data_is_paused(struct umac_sta_data *stad)
@@ -12,9 +12,7 @@
 #define DEFRAG_TIMEOUT_MS (1000)
 
 
-#define FRAG_CHAIN_MIN_ALLOC_LENGTH (1600)
-
-#define FRAG_CHAIN_MAX_ALLOC_LENGTH (DOT11_MAX_PAYLOAD_LEN + sizeof(struct dot11_data_hdr))
+#define FRAG_CHAIN_MAX_LENGTH (DOT11_MAX_PAYLOAD_LEN)
 
 
 static struct datapath_defrag_data_chain *datapath_defrag_get_frag_chain(
@@ -38,41 +36,50 @@ static bool datapath_defrag_is_in_frag_chain(struct datapath_defrag_data_chain *
             dot11_sequence_control_get_sequence_number(sequence_control));
 }
 
+
+static void datapath_defrag_clear_chain(struct datapath_defrag_data_chain *frag_chain)
+{
+    mmpkt_list_clear(&frag_chain->frags);
+    frag_chain->length = 0;
+    frag_chain->next_fragment_number = 0;
+}
+
 void datapath_defrag_timeout(void *arg1, void *arg2)
 {
     struct datapath_defrag_data_chain *frag_chain = (struct datapath_defrag_data_chain *)arg1;
 
     MM_UNUSED(arg2);
 
-    MMOSAL_DEV_ASSERT(frag_chain->buf != NULL);
+    MMOSAL_DEV_ASSERT(!mmpkt_list_is_empty(&frag_chain->frags));
     MMLOG_INF("Frag chain timed out %p\n", frag_chain);
 
 
-    mmpkt_release(frag_chain->buf);
-    frag_chain->buf = NULL;
+    datapath_defrag_clear_chain(frag_chain);
 }
 
 
-static void datapath_defrag_init_buffer(struct umac_data *umacd,
-                                        struct datapath_defrag_data_chain *frag_chain)
+static void datapath_defrag_drop_chain(struct umac_data *umacd,
+                                       struct datapath_defrag_data_chain *frag_chain)
 {
-    if (frag_chain->buf != NULL)
-    {
-        MMLOG_WRN("Dropping existing frag_chain_buffer as new chain has begun.\n");
-        mmpkt_release(frag_chain->buf);
-        frag_chain->buf = NULL;
-    }
-
+    datapath_defrag_clear_chain(frag_chain);
     (void)umac_core_cancel_timeout(umacd, datapath_defrag_timeout, frag_chain, NULL);
+}
+
 
-    frag_chain->buf =
-        mmdrv_alloc_mmpkt_for_defrag(FRAG_CHAIN_MIN_ALLOC_LENGTH, FRAG_CHAIN_MAX_ALLOC_LENGTH);
-    if (frag_chain->buf == NULL)
+static void datapath_defrag_init_chain(struct umac_data *umacd,
+                                       struct datapath_defrag_data_chain *frag_chain,
+                                       const struct dot11_hdr *header)
+{
+    if (!mmpkt_list_is_empty(&frag_chain->frags))
     {
-        MMLOG_WRN("Failed to allocate a frag chain buffer\n");
-        return;
+        MMLOG_WRN("Dropping existing frag chain as new chain has begun.\n");
     }
-    mmpkt_adjust_start_offset(frag_chain->buf, sizeof(struct dot11_data_hdr));
+
+    datapath_defrag_drop_chain(umacd, frag_chain);
+
+    frag_chain->sequence_number =
+        dot11_sequence_control_get_sequence_number(header->sequence_control);
+    frag_chain->is_protected = dot11_frame_control_get_protected(header->frame_control);
 
     bool ok = umac_core_register_timeout(umacd,
                                          DEFRAG_TIMEOUT_MS,
@@ -88,24 +95,55 @@ static void datapath_defrag_init_buffer(struct umac_data *umacd,
 }
 
 
-static bool datapath_defrag_add_fragment(struct datapath_defrag_data_chain *frag_chain,
-                                         struct mmpktview *rxbufview)
+static struct mmpkt *datapath_defrag_reassemble(struct datapath_defrag_data_chain *frag_chain,
+                                                const struct dot11_data_hdr *data_hdr,
+                                                size_t data_hdr_len)
 {
-    struct mmpktview *frag_chain_view = mmpkt_open(frag_chain->buf);
+    struct mmpkt *first = mmpkt_list_peek(&frag_chain->frags);
+    struct mmpkt *reassembled = first;
+    struct mmpkt *walk;
+    struct mmpkt *next;
+
+    struct mmpktview *view = mmpkt_open(first);
+    uint32_t remaining = frag_chain->length - mmpkt_get_data_length(view);
+    if (mmpkt_available_space_at_end(view) < remaining ||
+        mmpkt_available_space_at_start(view) < data_hdr_len)
+    {
+
+        mmpkt_close(&view);
+        reassembled = mmdrv_alloc_mmpkt_for_defrag(data_hdr_len + frag_chain->length,
+                                                   data_hdr_len + frag_chain->length);
+        if (reassembled == NULL)
+        {
+            MMLOG_WRN("Failed to allocate a defrag buffer\n");
+            return NULL;
+        }
+        mmpkt_adjust_start_offset(reassembled, data_hdr_len);
+        view = mmpkt_open(reassembled);
+    }
 
-    if (mmpkt_available_space_at_end(frag_chain_view) < mmpkt_get_data_length(rxbufview))
+    MMPKT_LIST_WALK(&frag_chain->frags, walk, next)
     {
-        MMLOG_WRN("Fragment buffer space exceeded.\n");
-        mmpkt_close(&frag_chain_view);
-        return false;
+        if (walk == reassembled)
+        {
+            continue;
+        }
+
+        struct mmpktview *frag_view = mmpkt_open(walk);
+        mmpkt_append_data(view, mmpkt_get_data_start(frag_view), mmpkt_get_data_length(frag_view));
+        mmpkt_close(&frag_view);
     }
 
-    mmpkt_append_data(frag_chain_view,
-                      mmpkt_get_data_start(rxbufview),
-                      mmpkt_get_data_length(rxbufview));
 
-    mmpkt_close(&frag_chain_view);
-    return true;
+    mmpkt_prepend_data(view, (const uint8_t *)data_hdr, data_hdr_len);
+    mmpkt_close(&view);
+
+    if (reassembled == first)
+    {
+        (void)mmpkt_list_dequeue(&frag_chain->frags);
+    }
+
+    return reassembled;
 }
 
 
@@ -143,38 +181,57 @@ struct mmpkt *datapath_defrag(struct umac_data *umacd,
         goto exit;
     }
 
+    uint8_t fragment_number =
+        dot11_sequence_control_get_fragment_number(header->sequence_control);
+
 
     if (datapath_defrag_is_first_fragment(header))
     {
-        datapath_defrag_init_buffer(umacd, frag_chain);
-        frag_chain->sequence_number =
-            dot11_sequence_control_get_sequence_number(header->sequence_control);
-        frag_chain->is_protected = dot11_frame_control_get_protected(header->frame_control);
+        datapath_defrag_init_chain(umacd, frag_chain, header);
     }
 
     if (!datapath_defrag_is_in_frag_chain(frag_chain, header->sequence_control) ||
-        frag_chain->buf == NULL)
+        (fragment_number != 0 && mmpkt_list_is_empty(&frag_chain->frags)))
     {
         MMLOG_INF("Missed the first fragment for this chain.\n");
         goto exit;
     }
 
-    if (frag_chain->is_protected != dot11_frame_control_get_protected(header->frame_control))
+    if (fragment_number < frag_chain->next_fragment_number)
     {
-        MMLOG_WRN("Fragment does not match the current chain's protection status.\n");
+
+        MMLOG_DBG("Dropping duplicate fragment %u\n", fragment_number);
         goto exit;
     }
 
-    if (!datapath_defrag_add_fragment(frag_chain, *rxbufview))
+    if (fragment_number > frag_chain->next_fragment_number)
     {
+        MMLOG_INF("Missed fragment %u of chain, dropping.\n", frag_chain->next_fragment_number);
+        datapath_defrag_drop_chain(umacd, frag_chain);
+        goto exit;
+    }
 
-        mmpkt_release(frag_chain->buf);
-        frag_chain->buf = NULL;
+    if (frag_chain->is_protected != dot11_frame_control_get_protected(header->frame_control))
+    {
+        MMLOG_WRN("Fragment does not match the current chain's protection status.\n");
+        goto exit;
+    }
 
-        (void)umac_core_cancel_timeout(umacd, datapath_defrag_timeout, frag_chain, NULL);
+    uint32_t fragment_len = mmpkt_get_data_length(*rxbufview);
+    if (frag_chain->length + fragment_len > FRAG_CHAIN_MAX_LENGTH)
+    {
+        MMLOG_WRN("Fragment buffer space exceeded.\n");
+        datapath_defrag_drop_chain(umacd, frag_chain);
         goto exit;
     }
 
+
+    mmpkt_close(rxbufview);
+    mmpkt_list_append(&frag_chain->frags, rxbuf);
+    frag_chain->length += fragment_len;
+    frag_chain->next_fragment_number++;
+    rxbuf = NULL;
+
     if (dot11_frame_control_get_more_fragments(header->frame_control))
     {
 
@@ -182,16 +239,16 @@ struct mmpkt *datapath_defrag(struct umac_data *umacd,
     }
 
 
-    return_buffer = frag_chain->buf;
-    frag_chain->buf = NULL;
+    return_buffer = datapath_defrag_reassemble(frag_chain, *data_hdr, data_hdr_len);
+    datapath_defrag_drop_chain(umacd, frag_chain);
+    if (return_buffer == NULL)
+    {
+        goto exit;
+    }
 
     return_view = mmpkt_open(return_buffer);
-    mmpkt_prepend_data(return_view, (const uint8_t *)(*data_hdr), data_hdr_len);
     *data_hdr = (const struct dot11_data_hdr *)mmpkt_remove_from_start(return_view, data_hdr_len);
 
-
-    (void)umac_core_cancel_timeout(umacd, datapath_defrag_timeout, frag_chain, NULL);
-
 exit:
     mmpkt_close(rxbufview);
     *rxbufview = return_view;
@@ -205,11 +262,6 @@ void datapath_defrag_deinit(struct umac_data *umacd, struct datapath_defrag_data
     for (i = 0; i < MAX_FRAG_CHAINS; i++)
     {
         struct datapath_defrag_data_chain *frag_chain = datapath_defrag_get_frag_chain(data, i);
-        if (frag_chain->buf != NULL)
-        {
-            mmpkt_release(frag_chain->buf);
-            frag_chain->buf = NULL;
-        }
-        (void)umac_core_cancel_timeout(umacd, datapath_defrag_timeout, frag_chain, NULL);
+        datapath_defrag_drop_chain(umacd, frag_chain);
     }
 }
@@ -55,6 +55,9 @@ static const uint8_t snap_802_1h[] = { 0xAA, 0xAA, 0x03, 0x00, 0x00, 0x00 };
 
 #define RX_REORDER_TIMER_PERIOD_MS (RX_REORDER_TIMEOUT_MS / 4)
 
+
+#define AMSDU_SUBFRAME_ALIGN (4)
+
 #ifdef ENABLE_DATAPATH_TRACE
 #include "mmtrace.h"
 static mmtrace_channel datapath_channel_handle;
@@ -391,6 +394,194 @@ static void umac_datapath_process_rx_eapol_frame(struct umac_data *umacd,
 }
 
 
+static void umac_datapath_deliver_rx_msdu(struct umac_data *umacd,
+                                          struct umac_sta_data *stad,
+                                          enum mmwlan_vif vif,
+                                          uint8_t tid_index,
+                                          const struct dot11_data_hdr *data_hdr,
+                                          struct mmpkt *rxbuf,
+                                          struct mmpktview *rxbufview)
+{
+    struct umac_datapath_data *data = umac_data_get_datapath(umacd);
+    const struct dot11_hdr *header = &data_hdr->base;
+
+    uint16_t llc_ethertype = umac_datapath_get_llc_ethertype(rxbufview);
+    if (!llc_ethertype)
+    {
+        goto drop;
+    }
+
+
+    mmpkt_remove_from_start(rxbufview, UMAC_802_1_HEADER_LEN);
+
+    umac_relay_process_data_frame(stad, vif, tid_index, data_hdr, llc_ethertype, &rxbufview);
+    if (rxbufview == NULL)
+    {
+
+        return;
+    }
+
+
+    struct umac_8023_hdr header_8023 = { 0 };
+    umac_datapath_generate_8023_header(dot11_get_da(header),
+                                       dot11_get_sa_data(data_hdr),
+                                       llc_ethertype,
+                                       &header_8023);
+
+    mmwlan_rx_pkt_ext_cb_t rx_pkt_cb;
+    void *arg = NULL;
+
+    if (umac_interface_has_rx_pkt_batch_cb(umacd, vif))
+    {
+        mmpkt_prepend_data(rxbufview, (const uint8_t *)&header_8023, sizeof(header_8023));
+        mmpkt_close(&rxbufview);
+        umac_interface_queue_rx_pkt_batch(umacd, vif, rxbuf);
+
+        return;
+    }
+
+    rx_pkt_cb = umac_interface_get_rx_pkt_ext_cb(umacd, vif, &arg);
+    if (rx_pkt_cb != NULL)
+    {
+        struct mmwlan_rx_metadata metadata = {
+            .vif = vif,
+            .tid = tid_index,
+            .ta = dot11_get_ta(&data_hdr->base),
+        };
+
+        mmpkt_prepend_data(rxbufview, (const uint8_t *)&header_8023, sizeof(header_8023));
+        mmpkt_close(&rxbufview);
+        rx_pkt_cb(rxbuf, &metadata, arg);
+
+        return;
+    }
+    if (data->rx_pkt_callback != NULL)
+    {
+        mmpkt_prepend_data(rxbufview, (const uint8_t *)&header_8023, sizeof(header_8023));
+        mmpkt_close(&rxbufview);
+        data->rx_pkt_callback(rxbuf, data->rx_arg);
+
+        return;
+    }
+    if (data->rx_callback != NULL)
+    {
+        data->rx_callback((uint8_t *)&header_8023,
+                          sizeof(header_8023),
+                          mmpkt_get_data_start(rxbufview),
+                          mmpkt_get_data_length(rxbufview),
+                          data->rx_arg);
+        goto drop;
+    }
+    MMLOG_WRN("No RX callback registered by the network stack.\n");
+    goto drop;
+
+drop:
+    mmpkt_close(&rxbufview);
+    mmpkt_release(rxbuf);
+}
+
+
+static void umac_datapath_process_rx_amsdu(struct umac_data *umacd,
+                                           struct umac_sta_data *stad,
+                                           enum mmwlan_vif vif,
+                                           uint8_t tid_index,
+                                           const struct dot11_data_hdr *data_hdr,
+                                           struct mmpkt *rxbuf,
+                                           struct mmpktview *rxbufview)
+{
+    struct dot11_data_hdr subframe_data_hdr = { 0 };
+    memcpy(&subframe_data_hdr, data_hdr, dot11_data_hdr_get_len(data_hdr));
+    uint8_t *subframe_da = (uint8_t *)dot11_get_da(&subframe_data_hdr.base);
+    uint8_t *subframe_sa = (uint8_t *)dot11_get_sa_data(&subframe_data_hdr);
+    bool sa_is_ta = (subframe_sa == subframe_data_hdr.base.addr2);
+    bool first = true;
+
+    while (mmpkt_get_data_length(rxbufview) != 0)
+    {
+        uint32_t remaining = mmpkt_get_data_length(rxbufview);
+        const struct umac_8023_hdr *subframe_hdr =
+            (const struct umac_8023_hdr *)mmpkt_get_data_start(rxbufview);
+        if (remaining < sizeof(*subframe_hdr))
+        {
+            MMLOG_INF("Truncated A-MSDU subframe header\n");
+            break;
+        }
+
+        uint32_t msdu_len = be16toh(subframe_hdr->ethertype_be);
+        uint32_t subframe_len = sizeof(*subframe_hdr) + msdu_len;
+        if (subframe_len > remaining)
+        {
+            MMLOG_INF("Truncated A-MSDU subframe (%lu > %lu)\n", subframe_len, remaining);
+            break;
+        }
+
+
+        if (first && memcmp(subframe_hdr->dest_addr, snap_802_1h, sizeof(snap_802_1h)) == 0)
+        {
+            MMLOG_INF("Dropping A-MSDU with LLC/SNAP header in place of DA\n");
+            break;
+        }
+        first = false;
+
+        bool valid = !sa_is_ta || umac_sta_data_matches_peer_addr(stad, subframe_hdr->src_addr);
+        bool last = (FAST_ROUND_UP(subframe_len, AMSDU_SUBFRAME_ALIGN) >= remaining);
+        mac_addr_copy(subframe_da, subframe_hdr->dest_addr);
+        mac_addr_copy(subframe_sa, subframe_hdr->src_addr);
+
+        if (!valid)
+        {
+            MMLOG_INF("Dropping A-MSDU subframe with SA " MM_MAC_ADDR_FMT " not matching TA\n",
+                      MM_MAC_ADDR_VAL(subframe_hdr->src_addr));
+        }
+        else if (last)
+        {
+
+            mmpkt_remove_from_start(rxbufview, sizeof(*subframe_hdr));
+            mmpkt_remove_from_end(rxbufview, remaining - subframe_len);
+            umac_datapath_deliver_rx_msdu(umacd,
+                                          stad,
+                                          vif,
+                                          tid_index,
+                                          &subframe_data_hdr,
+                                          rxbuf,
+                                          rxbufview);
+            return;
+        }
+        else
+        {
+            struct mmpkt *msdu = mmdrv_alloc_mmpkt_for_defrag(
+                sizeof(struct umac_8023_hdr) + msdu_len,
+                sizeof(struct umac_8023_hdr) + msdu_len);
+            if (msdu != NULL)
+            {
+                mmpkt_adjust_start_offset(msdu, sizeof(struct umac_8023_hdr));
+                struct mmpktview *msduview = mmpkt_open(msdu);
+                mmpkt_append_data(msduview, (const uint8_t *)(subframe_hdr + 1), msdu_len);
+                umac_datapath_deliver_rx_msdu(umacd,
+                                              stad,
+                                              vif,
+                                              tid_index,
+                                              &subframe_data_hdr,
+                                              msdu,
+                                              msduview);
+            }
+            else
+            {
+                MMLOG_WRN("Failed to allocate buffer for A-MSDU subframe\n");
+            }
+        }
+
+        if (last)
+        {
+            break;
+        }
+        mmpkt_remove_from_start(rxbufview, FAST_ROUND_UP(subframe_len, AMSDU_SUBFRAME_ALIGN));
+    }
+
+    mmpkt_close(&rxbufview);
+    mmpkt_release(rxbuf);
+}
+
 static void umac_datapath_process_rx_data_frame_after_reorder(
     struct umac_sta_data *stad,
     struct umac_datapath_sta_data *sta_data,
@@ -398,7 +589,6 @@ static void umac_datapath_process_rx_data_frame_after_reorder(
     struct mmpktview *rxbufview)
 {
     struct umac_data *umacd = umac_sta_data_get_umacd(stad);
-    struct umac_datapath_data *data = umac_data_get_datapath(umacd);
 
 
     const struct dot11_data_hdr *data_hdr =
@@ -412,6 +602,7 @@ static void umac_datapath_process_rx_data_frame_after_reorder(
     const struct dot11_hdr *header = &data_hdr->base;
 
     uint8_t tid_index = MMDRV_SEQ_NUM_BASELINE;
+    bool amsdu_present = false;
     const struct mmdrv_rx_metadata *rx_metadata = mmdrv_get_rx_metadata(rxbuf);
     uint16_t vif_id = umac_interface_get_vif_id_from_rx_metadata(rx_metadata);
 
@@ -426,6 +617,8 @@ static void umac_datapath_process_rx_data_frame_after_reorder(
         {
             tid_index = dot11_qos_control_get_tid(qos_control->field);
         }
+
+        amsdu_present = dot11_qos_control_get_amsdu_present(qos_control->field);
     }
 
 
@@ -546,118 +739,112 @@ static void umac_datapath_process_rx_data_frame_after_reorder(
         goto drop;
     }
 
-    uint16_t llc_ethertype = umac_datapath_get_llc_ethertype(rxbufview);
-    if (!llc_ethertype)
+    if (amsdu_present)
     {
-        goto drop;
+        umac_datapath_process_rx_amsdu(umacd, stad, vif, tid_index, data_hdr, rxbuf, rxbufview);
+        return;
     }
 
+    umac_datapath_deliver_rx_msdu(umacd, stad, vif, tid_index, data_hdr, rxbuf, rxbufview);
+    return;
 
-    mmpkt_remove_from_start(rxbufview, UMAC_802_1_HEADER_LEN);
+drop:
+    mmpkt_close(&rxbufview);
+    mmpkt_release(rxbuf);
+}
 
-    umac_relay_process_data_frame(stad, vif, tid_index, data_hdr, llc_ethertype, &rxbufview);
-    if (rxbufview == NULL)
+
+static void umac_datapath_rx_reorder_timeout_handler(void *arg1, void *arg2);
+
+
+static void umac_datapath_flush_rx_reorder_list(struct umac_sta_data *stad,
+                                                struct umac_datapath_sta_data *sta_data,
+                                                struct umac_datapath_rx_reorder *reorder)
+{
+    struct mmpkt *pkt;
+    while ((pkt = mmpkt_list_dequeue(&reorder->list)) != NULL)
     {
+        struct mmpktview *view = mmpkt_open(pkt);
+        umac_datapath_process_rx_data_frame_after_reorder(stad, sta_data, pkt, view);
+    }
+}
 
+
+static void umac_datapath_free_rx_reorder_list(struct umac_sta_data *stad,
+                                               struct umac_datapath_sta_data *sta_data,
+                                               uint16_t tid)
+{
+    struct umac_datapath_rx_reorder *reorder = sta_data->rx_reorder[tid];
+    if (reorder == NULL)
+    {
         return;
     }
 
+    umac_datapath_flush_rx_reorder_list(stad, sta_data, reorder);
 
-    struct umac_8023_hdr header_8023 = { 0 };
-    umac_datapath_generate_8023_header(dot11_get_da(header),
-                                       dot11_get_sa_data(data_hdr),
-                                       llc_ethertype,
-                                       &header_8023);
-
-    mmwlan_rx_pkt_ext_cb_t rx_pkt_cb;
-    void *arg = NULL;
+    struct umac_data *umacd = umac_sta_data_get_umacd(stad);
+    umac_core_cancel_timeout(umacd, umac_datapath_rx_reorder_timeout_handler, stad, reorder);
 
-    rx_pkt_cb = umac_interface_get_rx_pkt_ext_cb(umacd, vif, &arg);
-    if (rx_pkt_cb != NULL)
-    {
-        struct mmwlan_rx_metadata metadata = {
-            .vif = vif,
-            .tid = tid_index,
-            .ta = dot11_get_ta(&data_hdr->base),
-        };
+    sta_data->rx_reorder[tid] = NULL;
+    mmosal_free(reorder);
+}
 
-        mmpkt_prepend_data(rxbufview, (const uint8_t *)&header_8023, sizeof(header_8023));
-        mmpkt_close(&rxbufview);
-        rx_pkt_cb(rxbuf, &metadata, arg);
+bool umac_datapath_alloc_rx_reorder_list_for_tid(struct umac_sta_data *stad, uint16_t tid)
+{
+    struct umac_datapath_sta_data *sta_data = umac_sta_data_get_datapath(stad);
 
-        return;
-    }
-    if (data->rx_pkt_callback != NULL)
+    if (tid >= MM_ARRAY_COUNT(sta_data->rx_reorder))
     {
-        mmpkt_prepend_data(rxbufview, (const uint8_t *)&header_8023, sizeof(header_8023));
-        mmpkt_close(&rxbufview);
-        data->rx_pkt_callback(rxbuf, data->rx_arg);
-
-        return;
+        return false;
     }
-    if (data->rx_callback != NULL)
+
+    if (sta_data->rx_reorder[tid] != NULL)
     {
-        data->rx_callback((uint8_t *)&header_8023,
-                          sizeof(header_8023),
-                          mmpkt_get_data_start(rxbufview),
-                          mmpkt_get_data_length(rxbufview),
-                          data->rx_arg);
-        goto drop;
+        return true;
     }
-    MMLOG_WRN("No RX callback registered by the network stack.\n");
-    goto drop;
 
-drop:
-    mmpkt_close(&rxbufview);
-    mmpkt_release(rxbuf);
-}
-
-
-static void umac_datapath_flush_rx_reorder_list(struct umac_sta_data *stad,
-                                                struct umac_datapath_sta_data *sta_data)
-{
-    struct mmpkt *pkt;
-    while ((pkt = mmpkt_list_dequeue(&sta_data->rx_reorder_list)) != NULL)
+    struct umac_datapath_rx_reorder *reorder =
+        (struct umac_datapath_rx_reorder *)mmosal_malloc(sizeof(*reorder));
+    if (reorder == NULL)
     {
-        struct mmpktview *view = mmpkt_open(pkt);
-        umac_datapath_process_rx_data_frame_after_reorder(stad, sta_data, pkt, view);
+        MMLOG_WRN("Failed to allocate RX reorder list for TID %u\n", tid);
+        return false;
     }
+
+    mmpkt_list_init(&reorder->list);
+    reorder->tid = (uint8_t)tid;
+    sta_data->rx_reorder[tid] = reorder;
+    return true;
 }
 
 void umac_datapath_flush_rx_reorder_list_for_tid(struct umac_sta_data *stad, uint16_t tid)
 {
-    struct mmpkt *pkt;
     struct umac_datapath_sta_data *sta_data = umac_sta_data_get_datapath(stad);
 
-    if (sta_data->rx_reorder_tid != tid)
+    if (tid >= MM_ARRAY_COUNT(sta_data->rx_reorder))
     {
         return;
     }
 
-    umac_datapath_flush_rx_reorder_list(stad, sta_data);
-
-    while ((pkt = mmpkt_list_dequeue(&sta_data->rx_reorder_list)) != NULL)
-    {
-        struct mmpktview *view = mmpkt_open(pkt);
-        umac_datapath_process_rx_data_frame_after_reorder(stad, sta_data, pkt, view);
-    }
+    umac_datapath_free_rx_reorder_list(stad, sta_data, tid);
 }
 
 
 static void umac_datapath_evaluate_rx_reorder_list(struct umac_data *umacd,
                                                    struct umac_sta_data *stad,
-                                                   struct umac_datapath_sta_data *sta_data)
+                                                   struct umac_datapath_sta_data *sta_data,
+                                                   struct umac_datapath_rx_reorder *reorder)
 {
-    while (!mmpkt_list_is_empty(&sta_data->rx_reorder_list))
+    while (!mmpkt_list_is_empty(&reorder->list))
     {
         bool dequeue = false;
-        struct mmpkt *pkt = mmpkt_list_peek(&sta_data->rx_reorder_list);
+        struct mmpkt *pkt = mmpkt_list_peek(&reorder->list);
         struct mmpktview *view = mmpkt_open(pkt);
         const struct dot11_hdr *header = (struct dot11_hdr *)mmpkt_get_data_start(view);
         uint16_t seq_ctrl = le16toh(header->sequence_control);
         int32_t ret;
 
-        ret = umac_ba_get_expected_rx_seq_num(stad, sta_data->rx_reorder_tid);
+        ret = umac_ba_get_expected_rx_seq_num(stad, reorder->tid);
         if (ret < 0 || seq_ctrl == (uint16_t)ret)
         {
             dequeue = true;
@@ -671,7 +858,7 @@ static void umac_datapath_evaluate_rx_reorder_list(struct umac_data *umacd,
 
         if (dequeue)
         {
-            mmpkt_list_remove(&sta_data->rx_reorder_list, pkt);
+            mmpkt_list_remove(&reorder->list, pkt);
             umac_datapath_process_rx_data_frame_after_reorder(stad, sta_data, pkt, view);
         }
         else
@@ -684,18 +871,19 @@ static void umac_datapath_evaluate_rx_reorder_list(struct umac_data *umacd,
 
 static void umac_datapath_rx_reorder_timeout_handler(void *arg1, void *arg2)
 {
-    struct umac_data *umacd = (struct umac_data *)arg1;
-    struct umac_sta_data *stad = (struct umac_sta_data *)arg2;
+    struct umac_sta_data *stad = (struct umac_sta_data *)arg1;
+    struct umac_datapath_rx_reorder *reorder = (struct umac_datapath_rx_reorder *)arg2;
+    struct umac_data *umacd = umac_sta_data_get_umacd(stad);
     struct umac_datapath_sta_data *sta_data = umac_sta_data_get_datapath(stad);
 
-    umac_datapath_evaluate_rx_reorder_list(umacd, stad, sta_data);
-    if (!mmpkt_list_is_empty(&sta_data->rx_reorder_list))
+    umac_datapath_evaluate_rx_reorder_list(umacd, stad, sta_data, reorder);
+    if (!mmpkt_list_is_empty(&reorder->list))
     {
         bool ok = umac_core_register_timeout(umacd,
                                              RX_REORDER_TIMER_PERIOD_MS,
                                              umac_datapath_rx_reorder_timeout_handler,
-                                             umacd,
-                                             stad);
+                                             stad,
+                                             reorder);
         if (!ok)
         {
             MMLOG_WRN("Failed to schedule RX reorder timeout\n");
@@ -707,6 +895,7 @@ static void umac_datapath_rx_reorder_timeout_handler(void *arg1, void *arg2)
 static void umac_datapath_add_rx_mpdu_to_reorder_list(struct umac_data *umacd,
                                                       struct umac_sta_data *stad,
                                                       struct umac_datapath_sta_data *sta_data,
+                                                      struct umac_datapath_rx_reorder *reorder,
                                                       struct mmpkt *rxbuf,
                                                       uint16_t seq_ctrl,
                                                       uint8_t reorder_list_maxlen)
@@ -719,27 +908,27 @@ static void umac_datapath_add_rx_mpdu_to_reorder_list(struct umac_data *umacd,
     uint16_t head_seq_ctrl;
     bool reorder_list_full;
 
-    if (mmpkt_list_is_empty(&sta_data->rx_reorder_list))
+    if (mmpkt_list_is_empty(&reorder->list))
     {
         bool ok = umac_core_register_timeout(umacd,
                                              RX_REORDER_TIMER_PERIOD_MS,
                                              umac_datapath_rx_reorder_timeout_handler,
-                                             umacd,
-                                             stad);
+                                             stad,
+                                             reorder);
         if (!ok)
         {
             MMLOG_WRN("Failed to schedule RX reorder timeout\n");
         }
 
-        mmpkt_list_append(&sta_data->rx_reorder_list, rxbuf);
+        mmpkt_list_append(&reorder->list, rxbuf);
         umac_stats_increment_datapath_rx_reorder_total(umacd);
         umac_stats_update_datapath_rx_reorder_list_high_water_mark(
             umacd,
-            mmpkt_list_length(&sta_data->rx_reorder_list));
+            mmpkt_list_length(&reorder->list));
         return;
     }
 
-    head = mmpkt_list_peek(&sta_data->rx_reorder_list);
+    head = mmpkt_list_peek(&reorder->list);
     headview = mmpkt_open(head);
     head_header = (struct dot11_hdr *)mmpkt_get_data_start(headview);
     head_seq_ctrl = le16toh(head_header->sequence_control);
@@ -754,7 +943,7 @@ static void umac_datapath_add_rx_mpdu_to_reorder_list(struct umac_data *umacd,
         return;
     }
 
-    reorder_list_full = mmpkt_list_length(&sta_data->rx_reorder_list) >= reorder_list_maxlen;
+    reorder_list_full = mmpkt_list_length(&reorder->list) >= reorder_list_maxlen;
 
 
     if (dot11_sequence_control_lt(seq_ctrl, head_seq_ctrl))
@@ -767,11 +956,11 @@ static void umac_datapath_add_rx_mpdu_to_reorder_list(struct umac_data *umacd,
         }
         else
         {
-            mmpkt_list_prepend(&sta_data->rx_reorder_list, rxbuf);
+            mmpkt_list_prepend(&reorder->list, rxbuf);
             umac_stats_increment_datapath_rx_reorder_total(umacd);
             umac_stats_update_datapath_rx_reorder_list_high_water_mark(
                 umacd,
-                mmpkt_list_length(&sta_data->rx_reorder_list));
+                mmpkt_list_length(&reorder->list));
         }
         return;
     }
@@ -782,7 +971,7 @@ static void umac_datapath_add_rx_mpdu_to_reorder_list(struct umac_data *umacd,
         struct mmpktview *deqview;
 
 
-        deq = mmpkt_list_dequeue(&sta_data->rx_reorder_list);
+        deq = mmpkt_list_dequeue(&reorder->list);
         deqview = mmpkt_open(deq);
         umac_datapath_process_rx_data_frame_after_reorder(stad, sta_data, deq, deqview);
         umac_stats_increment_datapath_rx_reorder_overflow(umacd);
@@ -790,7 +979,7 @@ static void umac_datapath_add_rx_mpdu_to_reorder_list(struct umac_data *umacd,
 
 
 
-    MMPKT_LIST_WALK(&sta_data->rx_reorder_list, walk, next)
+    MMPKT_LIST_WALK(&reorder->list, walk, next)
     {
         struct mmpktview *nextview;
         const struct dot11_hdr *next_header;
@@ -822,14 +1011,14 @@ static void umac_datapath_add_rx_mpdu_to_reorder_list(struct umac_data *umacd,
     }
 
     MMOSAL_ASSERT(walk != NULL);
-    mmpkt_list_insert_after(&sta_data->rx_reorder_list, walk, rxbuf);
+    mmpkt_list_insert_after(&reorder->list, walk, rxbuf);
     umac_stats_increment_datapath_rx_reorder_total(umacd);
     umac_stats_update_datapath_rx_reorder_list_high_water_mark(
         umacd,
-        mmpkt_list_length(&sta_data->rx_reorder_list));
+        mmpkt_list_length(&reorder->list));
 
 
-    umac_datapath_evaluate_rx_reorder_list(umacd, stad, sta_data);
+    umac_datapath_evaluate_rx_reorder_list(umacd, stad, sta_data, reorder);
 }
 
 
@@ -878,18 +1067,14 @@ static void umac_datapath_process_rx_data_frame(struct umac_data *umacd,
 
     reorder_buf_size = umac_ba_get_reorder_buffer_size(stad, tid_index);
 
-    if (tid_index > MMWLAN_MAX_QOS_TID || reorder_buf_size == 0)
+    if (tid_index > MMWLAN_MAX_QOS_TID || reorder_buf_size == 0 ||
+        sta_data->rx_reorder[tid_index] == NULL)
     {
         umac_datapath_process_rx_data_frame_after_reorder(stad, sta_data, rxbuf, rxbufview);
         return;
     }
 
-
-    if (sta_data->rx_reorder_tid != tid_index)
-    {
-        umac_datapath_flush_rx_reorder_list(stad, sta_data);
-        sta_data->rx_reorder_tid = tid_index;
-    }
+    struct umac_datapath_rx_reorder *reorder = sta_data->rx_reorder[tid_index];
 
     ret = umac_ba_get_expected_rx_seq_num(stad, tid_index);
     if (ret < 0)
@@ -909,7 +1094,7 @@ static void umac_datapath_process_rx_data_frame(struct umac_data *umacd,
         umac_datapath_process_rx_data_frame_after_reorder(stad, sta_data, rxbuf, rxbufview);
         rxbuf = NULL;
         rxbufview = NULL;
-        umac_datapath_evaluate_rx_reorder_list(umacd, stad, sta_data);
+        umac_datapath_evaluate_rx_reorder_list(umacd, stad, sta_data, reorder);
         return;
     }
     else
@@ -930,6 +1115,7 @@ static void umac_datapath_process_rx_data_frame(struct umac_data *umacd,
             umac_datapath_add_rx_mpdu_to_reorder_list(umacd,
                                                       stad,
                                                       sta_data,
+                                                      reorder,
                                                       rxbuf,
                                                       seq_ctrl,
                                                       reorder_buf_size);
@@ -1373,14 +1559,42 @@ void umac_datapath_stad_init(struct umac_sta_data *stad)
     memset(sta_data->rx_seq_num_spaces, 0xff, sizeof(sta_data->rx_seq_num_spaces));
 }
 
+static void umac_datapath_purge_tx_mgmt_q(struct umac_data *umacd, uint16_t vif_id, uint16_t aid)
+{
+    struct umac_datapath_data *data = umac_data_get_datapath(umacd);
+    struct mmpkt_list purged = MMPKT_LIST_INIT;
+    struct mmpkt *walk;
+    struct mmpkt *next;
+
+    MMOSAL_TASK_ENTER_CRITICAL();
+    MMPKT_LIST_WALK(&data->tx_mgmt_q, walk, next)
+    {
+        const struct mmdrv_tx_metadata *tx_metadata = mmdrv_get_tx_metadata(walk);
+        if (tx_metadata->vif_id == vif_id && tx_metadata->aid == aid)
+        {
+            mmpkt_list_remove(&data->tx_mgmt_q, walk);
+            mmpkt_list_append(&purged, walk);
+        }
+    }
+    MMOSAL_TASK_EXIT_CRITICAL();
+
+    while ((walk = mmpkt_list_dequeue(&purged)) != NULL)
+    {
+        mmpkt_release(walk);
+        umac_stats_increment_datapath_txq_frames_dropped(umacd);
+        MMLOG_VRB("Dropped queued mgmt frame for VIF %u AID=%d\n", vif_id, aid);
+    }
+}
+
 void umac_datapath_stad_flush_txq(struct umac_data *umacd, struct umac_sta_data *stad)
 {
     MMOSAL_ASSERT(stad != NULL);
     const uint16_t aid = umac_sta_data_get_aid(stad);
+    umac_datapath_purge_tx_mgmt_q(umacd, umac_sta_data_get_vif_id(stad), aid);
     MMLOG_DBG("Flushing %d frames for STA AID=%d\n", umac_sta_data_get_queued_len(stad), aid);
     while (umac_sta_data_get_queued_len(stad))
     {
-        struct mmpkt *mmpkt = umac_sta_data_pop_pkt(stad);
+        struct mmpkt *mmpkt = umac_sta_data_pop_pkt(stad, NULL);
         MMOSAL_DEV_ASSERT(mmpkt);
         mmpkt_release(mmpkt);
         umac_stats_increment_datapath_txq_frames_dropped(umacd);
@@ -1392,7 +1606,10 @@ void umac_datapath_stad_flush(struct umac_data *umacd, struct umac_sta_data *sta
 {
     MMOSAL_ASSERT(stad != NULL);
     struct umac_datapath_sta_data *sta_data = umac_sta_data_get_datapath(stad);
-    umac_datapath_flush_rx_reorder_list(stad, sta_data);
+    for (uint16_t tid = 0; tid < MM_ARRAY_COUNT(sta_data->rx_reorder); tid++)
+    {
+        umac_datapath_free_rx_reorder_list(stad, sta_data, tid);
+    }
     datapath_defrag_deinit(umacd, &sta_data->defrag_data);
     umac_datapath_stad_flush_txq(umacd, stad);
 }
@@ -1478,6 +1695,25 @@ enum mmwlan_status umac_datapath_register_rx_pkt_ext_cb(struct umac_data *umacd,
     return umac_interface_register_rx_pkt_ext_cb(umacd, vif, callback, arg);
 }
 
+enum mmwlan_status umac_datapath_register_rx_pkt_batch_cb(struct umac_data *umacd,
+                                                          enum mmwlan_vif vif,
+                                                          mmwlan_rx_pkt_batch_cb_t callback,
+                                                          void *arg)
+{
+    struct umac_datapath_data *data = umac_data_get_datapath(umacd);
+
+    data->rx_callback = NULL;
+    data->rx_pkt_callback = NULL;
+    data->rx_arg = NULL;
+
+    return umac_interface_register_rx_pkt_batch_cb(umacd, vif, callback, arg);
+}
+
+void umac_datapath_deliver_rx_batches(struct umac_data *umacd)
+{
+    umac_interface_deliver_rx_pkt_batches(umacd);
+}
+
 
 static void umac_datapath_process_rx_frame(struct umac_data *umacd,
                                            struct umac_datapath_data *data,
@@ -1700,22 +1936,131 @@ static void umac_datapath_aggr_check(struct umac_data *umacd,
     umac_ba_session_init(stad, tid, ssc, DOT11_BLOCK_ACK_TIMEOUT_DISABLED);
 }
 
-enum mmwlan_status umac_datapath_process_tx_frame(struct umac_data *umacd,
-                                                  struct umac_sta_data *stad,
-                                                  struct mmpktview *txbufview)
+static enum mmwlan_status umac_datapath_build_tx_template(
+    struct umac_sta_data *stad,
+    const struct umac_datapath_ops *datapath_ops,
+    const struct umac_8023_hdr *header_8023,
+    uint8_t enc,
+    struct umac_datapath_tx_template *tmpl)
 {
-    struct mmpkt *txbuf = mmpkt_from_view(txbufview);
-    struct mmdrv_tx_metadata *tx_metadata = mmdrv_get_tx_metadata(txbuf);
-    uint16_t tid = tx_metadata->tid;
-    uint8_t enc = tx_metadata->enc;
-    const struct umac_8023_hdr *header_8023 =
+    struct dot11_hdr *header = &tmpl->data_hdr.base;
+    int key_len = 0;
+
+    memset(tmpl, 0, sizeof(*tmpl));
+    tmpl->key_id = -1;
+    memcpy(tmpl->dest_addr, header_8023->dest_addr, sizeof(tmpl->dest_addr));
+    memcpy(tmpl->src_addr, header_8023->src_addr, sizeof(tmpl->src_addr));
+
+    datapath_ops->construct_80211_data_header(stad, header_8023, &tmpl->data_hdr);
+
+    const uint8_t *ra = dot11_get_ra(header);
+    if (mm_mac_addr_is_zero(ra))
+    {
+        MMLOG_WRN("Dropping tx data frame with zero RA.\n");
+        return MMWLAN_ERROR;
+    }
+    bool is_multicast = mm_mac_addr_is_multicast(ra);
+
+    MMOSAL_DEV_ASSERT(!mm_mac_addr_is_zero(dot11_get_ta(header)));
+    MMOSAL_DEV_ASSERT(!mm_mac_addr_is_zero(dot11_get_da(header)));
+    MMOSAL_DEV_ASSERT(!mm_mac_addr_is_zero(dot11_get_sa_data(&tmpl->data_hdr)));
+
+    if (umac_sta_data_get_security_type(stad) != MMWLAN_OPEN && enc != ENCRYPTION_DISABLED)
+    {
+        enum umac_key_type key_type = is_multicast ? UMAC_KEY_TYPE_GROUP : UMAC_KEY_TYPE_PAIRWISE;
+
+        tmpl->key_id = umac_keys_get_active_key_id(stad, key_type);
+        if (tmpl->key_id >= 0)
+        {
+            key_len = umac_keys_get_key_len(stad, tmpl->key_id);
+            header->frame_control |= htole16(DOT11_MASK_FC_PROTECTED);
+        }
+        else if (enc == ENCRYPTION_ENABLED)
+        {
+            MMLOG_WRN("Could not find key for type %u.\n", key_type);
+            return MMWLAN_ERROR;
+        }
+        MMLOG_DBG("Using %s key index %d\n",
+                  (key_type == UMAC_KEY_TYPE_GROUP)    ? "GROUP" :
+                  (key_type == UMAC_KEY_TYPE_PAIRWISE) ? "PAIR" :
+                                                         "??",
+                  tmpl->key_id);
+    }
+
+    if (key_len == UMAC_KEY_AES_256_LEN)
+    {
+        tmpl->ccmp_len = DOT11_CCMP_HEADER_LEN + DOT11_CCMP_256_MIC_LEN;
+    }
+    else if (key_len == UMAC_KEY_AES_128_LEN)
+    {
+        tmpl->ccmp_len = DOT11_CCMP_HEADER_LEN + DOT11_CCMP_128_MIC_LEN;
+    }
+
+    return MMWLAN_SUCCESS;
+}
+
+
+static const struct umac_datapath_tx_template *umac_datapath_get_tx_template(
+    struct umac_sta_data *stad,
+    const struct umac_datapath_ops *datapath_ops,
+    const struct umac_8023_hdr *header_8023,
+    uint16_t tid,
+    uint8_t enc,
+    bool is_eapol,
+    struct umac_datapath_tx_template *scratch)
+{
+    struct umac_datapath_sta_data *sta_data = umac_sta_data_get_datapath(stad);
+    struct umac_datapath_tx_template *tmpl = scratch;
+
+    if (!is_eapol && enc == ENCRYPTION_ENABLED && tid < MM_ARRAY_COUNT(sta_data->tx_templates))
+    {
+        tmpl = &sta_data->tx_templates[tid];
+        if (tmpl->valid &&
+            mm_mac_addr_is_equal(tmpl->dest_addr, header_8023->dest_addr) &&
+            mm_mac_addr_is_equal(tmpl->src_addr, header_8023->src_addr))
+        {
+            return tmpl;
+        }
+    }
+
+    if (umac_datapath_build_tx_template(stad, datapath_ops, header_8023, enc, tmpl) !=
+        MMWLAN_SUCCESS)
+    {
+        tmpl->valid = false;
+        return NULL;
+    }
+
+    tmpl->valid = (tmpl != scratch);
+    return tmpl;
+}
+
+void umac_datapath_invalidate_tx_templates(struct umac_sta_data *stad)
+{
+    struct umac_datapath_sta_data *sta_data = umac_sta_data_get_datapath(stad);
+
+    for (unsigned ii = 0; ii < MM_ARRAY_COUNT(sta_data->tx_templates); ii++)
+    {
+        sta_data->tx_templates[ii].valid = false;
+    }
+}
+
+enum mmwlan_status umac_datapath_process_tx_frame(struct umac_data *umacd,
+                                                  struct umac_sta_data *stad,
+                                                  struct mmpktview *txbufview,
+                                                  bool is_amsdu)
+{
+    struct mmpkt *txbuf = mmpkt_from_view(txbufview);
+    struct mmdrv_tx_metadata *tx_metadata = mmdrv_get_tx_metadata(txbuf);
+    uint16_t tid = tx_metadata->tid;
+    uint8_t enc = tx_metadata->enc;
+    const struct umac_8023_hdr *header_8023 =
         (const struct umac_8023_hdr *)mmpkt_get_data_start(txbufview);
     const uint16_t ethertype = be16toh(header_8023->ethertype_be);
-    struct dot11_data_hdr data_hdr = { 0 };
+    struct dot11_data_hdr data_hdr;
     struct dot11_hdr *header = &data_hdr.base;
-    int key_id = -1;
-    int key_len = 0;
-    int ccmp_len = 0;
+    struct umac_datapath_tx_template scratch_tmpl;
+    const struct umac_datapath_tx_template *tmpl;
+    int key_id;
     uint32_t rts_threshold = 0;
     bool rts_required = false;
     struct dot11_qos_ctrl qos_ctrl = {};
@@ -1724,7 +2069,7 @@ enum mmwlan_status umac_datapath_process_tx_frame(struct umac_data *umacd,
     struct umac_datapath_sta_data *sta_data = umac_sta_data_get_datapath(stad);
 
 
-    bool is_eapol = (ethertype == ETHERTYPE_EAPOL);
+    bool is_eapol = !is_amsdu && (ethertype == ETHERTYPE_EAPOL);
 
     MMLOG_DBG("Dequeued frame for TX (%p, ethertype=0x%04x, tid=%u, %s port)\n",
               txbuf,
@@ -1741,58 +2086,48 @@ enum mmwlan_status umac_datapath_process_tx_frame(struct umac_data *umacd,
         goto error;
     }
 
-    datapath_ops->construct_80211_data_header(stad, header_8023, &data_hdr);
-    const uint32_t data_hdr_len = dot11_data_hdr_get_len(&data_hdr);
-
-
-    mmpkt_remove_from_start(txbufview, 2 * DOT11_MAC_ADDR_LEN);
-    MM_STATIC_ASSERT(2 * DOT11_MAC_ADDR_LEN == offsetof(struct umac_8023_hdr, ethertype_be), "");
-
-    if (ethertype >= ETHERTYPE_THRESHOLD)
-    {
+    MMOSAL_DEV_ASSERT(is_eapol || enc == ENCRYPTION_ENABLED);
 
-        mmpkt_prepend_data(txbufview, snap_802_1h, sizeof(snap_802_1h));
-    }
 
-    const uint8_t *ra = dot11_get_ra(&(data_hdr.base));
-    if (mm_mac_addr_is_zero(ra))
+    tmpl = umac_datapath_get_tx_template(stad,
+                                         datapath_ops,
+                                         header_8023,
+                                         tid,
+                                         enc,
+                                         is_eapol,
+                                         &scratch_tmpl);
+    if (tmpl == NULL)
     {
-        MMLOG_WRN("Dropping tx data frame with zero RA.\n");
         status = MMWLAN_ERROR;
         goto error;
     }
-    bool is_multicast = mm_mac_addr_is_multicast(ra);
 
-    MMOSAL_DEV_ASSERT(!mm_mac_addr_is_zero(dot11_get_ta(&(data_hdr.base))));
-    MMOSAL_DEV_ASSERT(!mm_mac_addr_is_zero(dot11_get_da(&(data_hdr.base))));
-    MMOSAL_DEV_ASSERT(!mm_mac_addr_is_zero(dot11_get_sa_data(&data_hdr)));
+    data_hdr = tmpl->data_hdr;
+    key_id = tmpl->key_id;
+    const uint32_t data_hdr_len = dot11_data_hdr_get_len(&data_hdr);
 
 
-    MMOSAL_DEV_ASSERT(is_eapol || enc == ENCRYPTION_ENABLED);
+    if (is_amsdu)
+    {
 
-    if (umac_sta_data_get_security_type(stad) != MMWLAN_OPEN && enc != ENCRYPTION_DISABLED)
+        mmpkt_remove_from_start(txbufview, sizeof(*header_8023));
+        mac_addr_copy(header->addr3, umac_sta_data_peek_bssid(stad));
+    }
+    else
     {
-        enum umac_key_type key_type = is_multicast ? UMAC_KEY_TYPE_GROUP : UMAC_KEY_TYPE_PAIRWISE;
+        mmpkt_remove_from_start(txbufview, 2 * DOT11_MAC_ADDR_LEN);
+        MM_STATIC_ASSERT(2 * DOT11_MAC_ADDR_LEN == offsetof(struct umac_8023_hdr, ethertype_be),
+                         "");
 
-        key_id = umac_keys_get_active_key_id(stad, key_type);
-        if (key_id >= 0)
+        if (ethertype >= ETHERTYPE_THRESHOLD)
         {
-            key_len = umac_keys_get_key_len(stad, key_id);
-            header->frame_control |= htole16(DOT11_MASK_FC_PROTECTED);
-        }
-        else if (enc == ENCRYPTION_ENABLED)
-        {
-            MMLOG_WRN("Could not find key for type %u.\n", key_type);
-            status = MMWLAN_ERROR;
-            goto error;
+
+            mmpkt_prepend_data(txbufview, snap_802_1h, sizeof(snap_802_1h));
         }
-        MMLOG_DBG("Using %s key index %d\n",
-                  (key_type == UMAC_KEY_TYPE_GROUP)    ? "GROUP" :
-                  (key_type == UMAC_KEY_TYPE_PAIRWISE) ? "PAIR" :
-                                                         "??",
-                  key_id);
     }
 
+    bool is_multicast = mm_mac_addr_is_multicast(dot11_get_ra(header));
+
     size_t seq_num_idx = is_multicast ? MMDRV_SEQ_NUM_BASELINE : tid;
     DOT11_SEQUENCE_CONTROL_SET_SEQUENCE_NUMBER(header->sequence_control,
                                                sta_data->tx_seq_num_spaces[seq_num_idx]++);
@@ -1807,21 +2142,16 @@ enum mmwlan_status umac_datapath_process_tx_frame(struct umac_data *umacd,
 
 
     qos_ctrl.field = (uint16_t)(tid & DOT11_MASK_QC_TID);
-
-    if (key_len == UMAC_KEY_AES_256_LEN)
-    {
-        ccmp_len = DOT11_CCMP_HEADER_LEN + DOT11_CCMP_256_MIC_LEN;
-    }
-    else if (key_len == UMAC_KEY_AES_128_LEN)
+    if (is_amsdu)
     {
-        ccmp_len = DOT11_CCMP_HEADER_LEN + DOT11_CCMP_128_MIC_LEN;
+        DOT11_QOS_CONTROL_SET_AMSDU_PRESENT(qos_ctrl.field, 1);
     }
 
     rts_required = (rts_threshold && ((mmpkt_get_data_length(txbufview) +
                                        data_hdr_len +
                                        sizeof(qos_ctrl) +
                                        DOT11_FCS_FIELD_LEN +
-                                       ccmp_len) > rts_threshold));
+                                       tmpl->ccmp_len) > rts_threshold));
 
 
     MMLOG_VRB("Add QOS CNTL bytes\n");
@@ -1844,6 +2174,10 @@ enum mmwlan_status umac_datapath_process_tx_frame(struct umac_data *umacd,
         {
             tx_metadata->flags |= MMDRV_TX_FLAG_AMPDU_ENABLED;
         }
+        if (umac_ba_is_amsdu_permitted(stad, tid))
+        {
+            tx_metadata->flags |= MMDRV_TX_FLAG_AMSDU_SUPPORTED;
+        }
     }
 
     umac_connection_populate_tx_metadata(umacd, tx_metadata);
@@ -1909,16 +2243,29 @@ static uint32_t umac_datapath_calculate_tx_timeout_ms(struct umac_data *umacd, b
     }
 }
 
-enum mmwlan_status umac_datapath_tx_frame(struct umac_data *umacd,
-                                          struct mmpkt *txbuf,
-                                          enum umac_datapath_frame_encryption enc,
-                                          const uint8_t *ra)
+struct umac_datapath_tx_lookup
+{
+    const struct umac_datapath_ops *datapath_ops;
+    struct umac_sta_data *stad;
+    uint16_t vif_id;
+    uint8_t dest_addr[MMWLAN_MAC_ADDR_LEN];
+};
+
+
+static enum mmwlan_status umac_datapath_tx_frame_prepare(struct umac_data *umacd,
+                                                         struct mmpkt *txbuf,
+                                                         enum umac_datapath_frame_encryption enc,
+                                                         const uint8_t *ra,
+                                                         struct umac_datapath_tx_lookup *lookup,
+                                                         bool *queue)
 {
     enum mmwlan_status status = MMWLAN_ERROR;
     struct mmpktview *txbufview = mmpkt_open(txbuf);
     const struct umac_8023_hdr *header_8023 =
         (const struct umac_8023_hdr *)mmpkt_get_data_start(txbufview);
 
+    *queue = false;
+
     if (mmpkt_get_data_length(txbufview) < sizeof(*header_8023))
     {
         MMLOG_WRN("Tx len is too small %lu\n", mmpkt_get_data_length(txbufview));
@@ -1934,8 +2281,15 @@ enum mmwlan_status umac_datapath_tx_frame(struct umac_data *umacd,
     }
 
     struct mmdrv_tx_metadata *tx_metadata = mmdrv_get_tx_metadata(txbuf);
-    const struct umac_datapath_ops *datapath_ops =
-        umac_interface_get_datapath_ops_by_vif_id(umacd, tx_metadata->vif_id);
+    if (lookup->datapath_ops == NULL || lookup->vif_id != tx_metadata->vif_id)
+    {
+        lookup->datapath_ops =
+            umac_interface_get_datapath_ops_by_vif_id(umacd, tx_metadata->vif_id);
+        lookup->vif_id = tx_metadata->vif_id;
+        lookup->stad = NULL;
+    }
+
+    const struct umac_datapath_ops *datapath_ops = lookup->datapath_ops;
     if (datapath_ops == NULL)
     {
         MMLOG_WRN("Invalid datapath_ops for vif_id %u\n", tx_metadata->vif_id);
@@ -1943,22 +2297,31 @@ enum mmwlan_status umac_datapath_tx_frame(struct umac_data *umacd,
         goto drop;
     }
 
-    struct umac_sta_data *stad = NULL;
     const char *addr_type;
     const uint8_t *addr;
     if (ra == NULL)
     {
-        stad = datapath_ops->lookup_stad_by_tx_dest_addr(umacd, header_8023->dest_addr);
+        if (lookup->stad == NULL ||
+            !mm_mac_addr_is_equal(lookup->dest_addr, header_8023->dest_addr))
+        {
+            lookup->stad =
+                datapath_ops->lookup_stad_by_tx_dest_addr(umacd, header_8023->dest_addr);
+            memcpy(lookup->dest_addr, header_8023->dest_addr, sizeof(lookup->dest_addr));
+        }
         addr_type = "DA";
         addr = header_8023->dest_addr;
     }
     else
     {
-        stad = datapath_ops->lookup_stad_by_peer_addr(umacd, ra);
+        if (lookup->stad == NULL)
+        {
+            lookup->stad = datapath_ops->lookup_stad_by_peer_addr(umacd, ra);
+        }
         addr_type = "RA";
         addr = ra;
     }
 
+    struct umac_sta_data *stad = lookup->stad;
     if (stad == NULL)
     {
         MMLOG_WRN("No STA record for %s " MM_MAC_ADDR_FMT "\n", addr_type, MM_MAC_ADDR_VAL(addr));
@@ -1989,7 +2352,7 @@ enum mmwlan_status umac_datapath_tx_frame(struct umac_data *umacd,
     if (is_eapol && !datapath_ops->is_stad_tx_paused(stad))
     {
 
-        return umac_datapath_process_tx_frame(umacd, stad, txbufview);
+        return umac_datapath_process_tx_frame(umacd, stad, txbufview, false);
     }
 
     enum mmwlan_sta_state sta_state = datapath_ops->get_sta_state(stad);
@@ -2004,9 +2367,8 @@ enum mmwlan_status umac_datapath_tx_frame(struct umac_data *umacd,
     }
 
     mmpkt_close(&txbufview);
-    datapath_ops->enqueue_tx_frame(umacd, stad, txbuf);
     MMLOG_DBG("Queued frame for TX (%p, ethertype=0x%04x, enc=0x%x)\n", txbuf, ethertype, enc);
-    umac_core_evt_wake(umacd);
+    *queue = true;
     return MMWLAN_SUCCESS;
 
 drop:
@@ -2015,6 +2377,76 @@ drop:
     return status;
 }
 
+enum mmwlan_status umac_datapath_tx_frame(struct umac_data *umacd,
+                                          struct mmpkt *txbuf,
+                                          enum umac_datapath_frame_encryption enc,
+                                          const uint8_t *ra)
+{
+    struct umac_datapath_tx_lookup lookup = { 0 };
+    bool queue = false;
+
+    enum mmwlan_status status =
+        umac_datapath_tx_frame_prepare(umacd, txbuf, enc, ra, &lookup, &queue);
+    if (queue)
+    {
+        struct mmpkt_list txbufs = MMPKT_LIST_INIT;
+        mmpkt_list_append(&txbufs, txbuf);
+        lookup.datapath_ops->enqueue_tx_frames(umacd, lookup.stad, &txbufs);
+        umac_core_evt_wake(umacd);
+    }
+    return status;
+}
+
+enum mmwlan_status umac_datapath_tx_frames(struct umac_data *umacd,
+                                           struct mmpkt_list *txbufs,
+                                           enum umac_datapath_frame_encryption enc,
+                                           const uint8_t *ra)
+{
+    enum mmwlan_status status = MMWLAN_SUCCESS;
+    struct umac_datapath_tx_lookup lookup = { 0 };
+    struct mmpkt_list run = MMPKT_LIST_INIT;
+    struct umac_sta_data *run_stad = NULL;
+    const struct umac_datapath_ops *run_datapath_ops = NULL;
+    bool queued = false;
+    struct mmpkt *txbuf;
+
+    while ((txbuf = mmpkt_list_dequeue(txbufs)) != NULL)
+    {
+        bool queue = false;
+        enum mmwlan_status pkt_status =
+            umac_datapath_tx_frame_prepare(umacd, txbuf, enc, ra, &lookup, &queue);
+        if (status == MMWLAN_SUCCESS)
+        {
+            status = pkt_status;
+        }
+        if (!queue)
+        {
+            continue;
+        }
+
+
+        if (lookup.stad != run_stad && !mmpkt_list_is_empty(&run))
+        {
+            run_datapath_ops->enqueue_tx_frames(umacd, run_stad, &run);
+        }
+        run_stad = lookup.stad;
+        run_datapath_ops = lookup.datapath_ops;
+        mmpkt_list_append(&run, txbuf);
+        queued = true;
+    }
+
+    if (!mmpkt_list_is_empty(&run))
+    {
+        run_datapath_ops->enqueue_tx_frames(umacd, run_stad, &run);
+    }
+
+    if (queued)
+    {
+        umac_core_evt_wake(umacd);
+    }
+    return status;
+}
+
 static bool umac_datapath_dequeue_tx_frame(struct umac_data *umacd,
                                            struct umac_sta_data **stad,
                                            struct mmpkt **txbuf)
@@ -2046,6 +2478,223 @@ static bool umac_datapath_dequeue_tx_frame(struct umac_data *umacd,
 }
 
 
+struct umac_datapath_amsdu_match_args
+{
+    uint8_t vif_id;
+    uint8_t tid;
+    uint32_t len;
+    uint32_t max_len;
+};
+
+
+static uint32_t umac_datapath_amsdu_subframe_len(struct mmpkt *txbuf)
+{
+    return mmpkt_peek_data_length(txbuf) + UMAC_802_1_HEADER_LEN;
+}
+
+
+static bool umac_datapath_amsdu_is_eligible(struct mmpkt *txbuf)
+{
+    const struct mmdrv_tx_metadata *tx_metadata = mmdrv_get_tx_metadata(txbuf);
+    if (tx_metadata->enc != ENCRYPTION_ENABLED)
+    {
+        return false;
+    }
+
+    struct mmpktview *txbufview = mmpkt_open(txbuf);
+    bool eligible = false;
+    if (mmpkt_get_data_length(txbufview) >= sizeof(struct umac_8023_hdr))
+    {
+        const struct umac_8023_hdr *header_8023 =
+            (const struct umac_8023_hdr *)mmpkt_get_data_start(txbufview);
+        uint16_t ethertype = be16toh(header_8023->ethertype_be);
+        eligible = (ethertype >= ETHERTYPE_THRESHOLD && ethertype != ETHERTYPE_EAPOL);
+    }
+    mmpkt_close(&txbufview);
+    return eligible;
+}
+
+
+static bool umac_datapath_amsdu_match(struct mmpkt *txbuf, void *arg)
+{
+    struct umac_datapath_amsdu_match_args *args = (struct umac_datapath_amsdu_match_args *)arg;
+    const struct mmdrv_tx_metadata *tx_metadata = mmdrv_get_tx_metadata(txbuf);
+
+    if (tx_metadata->vif_id != args->vif_id || tx_metadata->tid != args->tid)
+    {
+        return false;
+    }
+
+    uint32_t len = FAST_ROUND_UP(args->len, AMSDU_SUBFRAME_ALIGN) +
+                   umac_datapath_amsdu_subframe_len(txbuf);
+    if (len > args->max_len || !umac_datapath_amsdu_is_eligible(txbuf))
+    {
+        return false;
+    }
+
+    args->len = len;
+    return true;
+}
+
+
+static uint32_t umac_datapath_amsdu_collect(struct umac_data *umacd,
+                                            struct umac_sta_data *stad,
+                                            struct mmpkt *txbuf,
+                                            struct mmpkt_list *subframes)
+{
+    const struct mmdrv_tx_metadata *tx_metadata = mmdrv_get_tx_metadata(txbuf);
+    struct umac_datapath_amsdu_match_args args = {
+        .vif_id = tx_metadata->vif_id,
+        .tid = tx_metadata->tid,
+        .len = umac_datapath_amsdu_subframe_len(txbuf),
+        .max_len = umac_config_get_amsdu_max_len(umacd),
+    };
+    uint8_t max_subframes = umac_config_get_amsdu_max_subframes(umacd);
+    uint32_t frag_threshold = umac_config_get_frag_threshold(umacd);
+
+    mmpkt_list_append(subframes, txbuf);
+
+    if (!umac_config_is_amsdu_enabled(umacd) || max_subframes < 2 ||
+        !umac_ba_is_amsdu_permitted(stad, args.tid) || !umac_datapath_amsdu_is_eligible(txbuf))
+    {
+        return 1;
+    }
+
+
+    if (frag_threshold != 0 && frag_threshold < args.max_len)
+    {
+        args.max_len = frag_threshold;
+    }
+
+    if (args.len > args.max_len)
+    {
+        return 1;
+    }
+
+    const struct umac_datapath_ops *datapath_ops =
+        umac_interface_get_datapath_ops_by_vif_id(umacd, args.vif_id);
+    if (datapath_ops == NULL || datapath_ops->dequeue_tx_frame_if == NULL)
+    {
+        return 1;
+    }
+
+
+    struct mmpktview *txbufview = mmpkt_open(txbuf);
+    struct dot11_data_hdr data_hdr = { 0 };
+    datapath_ops->construct_80211_data_header(
+        stad,
+        (const struct umac_8023_hdr *)mmpkt_get_data_start(txbufview),
+        &data_hdr);
+    mmpkt_close(&txbufview);
+    if (dot11_is_4addr_hdr(data_hdr.base.frame_control))
+    {
+        return 1;
+    }
+
+    while (mmpkt_list_length(subframes) < max_subframes)
+    {
+        struct mmpkt *next =
+            datapath_ops->dequeue_tx_frame_if(umacd, stad, umac_datapath_amsdu_match, &args);
+        if (next == NULL)
+        {
+            break;
+        }
+        mmpkt_list_append(subframes, next);
+    }
+
+    return mmpkt_list_length(subframes);
+}
+
+
+static struct mmpkt *umac_datapath_amsdu_build(struct mmpkt_list *subframes)
+{
+    struct mmpkt *head = mmpkt_list_peek(subframes);
+    const struct mmdrv_tx_metadata *tx_metadata = mmdrv_get_tx_metadata(head);
+    struct mmpkt *walk;
+    struct mmpkt *next;
+    uint32_t amsdu_len = 0;
+
+    MMPKT_LIST_WALK(subframes, walk, next)
+    {
+        amsdu_len = FAST_ROUND_UP(amsdu_len, AMSDU_SUBFRAME_ALIGN) +
+                    umac_datapath_amsdu_subframe_len(walk);
+    }
+
+    struct mmpkt *amsdu =
+        umac_datapath_alloc_mmpkt_for_qos_data_tx(sizeof(struct umac_8023_hdr) + amsdu_len,
+                                                  MMDRV_PKT_CLASS_DATA_TID0 + tx_metadata->tid);
+    if (amsdu == NULL)
+    {
+        return NULL;
+    }
+    *(mmpkt_get_metadata(amsdu).tx) = *tx_metadata;
+
+    struct mmpktview *amsduview = mmpkt_open(amsdu);
+    bool first = true;
+    MMPKT_LIST_WALK(subframes, walk, next)
+    {
+        struct mmpktview *view = mmpkt_open(walk);
+        const struct umac_8023_hdr *header_8023 =
+            (const struct umac_8023_hdr *)mmpkt_get_data_start(view);
+        uint32_t payload_len = mmpkt_get_data_length(view) - sizeof(*header_8023);
+        struct umac_8023_hdr subframe_hdr = *header_8023;
+
+        if (first)
+        {
+
+            mmpkt_append_data(amsduview, (const uint8_t *)header_8023, sizeof(*header_8023));
+            first = false;
+        }
+        else
+        {
+            uint32_t body_len = mmpkt_get_data_length(amsduview) - sizeof(*header_8023);
+            uint32_t pad_len = FAST_ROUND_UP(body_len, AMSDU_SUBFRAME_ALIGN) - body_len;
+            memset(mmpkt_append(amsduview, pad_len), 0, pad_len);
+        }
+
+        subframe_hdr.ethertype_be = htobe16(UMAC_802_1_HEADER_LEN + payload_len);
+        mmpkt_append_data(amsduview, (const uint8_t *)&subframe_hdr, sizeof(subframe_hdr));
+        mmpkt_append_data(amsduview, snap_802_1h, sizeof(snap_802_1h));
+        mmpkt_append_data(amsduview,
+                          (const uint8_t *)&header_8023->ethertype_be,
+                          sizeof(header_8023->ethertype_be));
+        mmpkt_append_data(amsduview, (const uint8_t *)(header_8023 + 1), payload_len);
+        mmpkt_close(&view);
+    }
+    mmpkt_close(&amsduview);
+
+    return amsdu;
+}
+
+
+static void umac_datapath_process_tx_data(struct umac_data *umacd,
+                                          struct umac_sta_data *stad,
+                                          struct mmpkt *txbuf)
+{
+    struct mmpkt_list subframes = MMPKT_LIST_INIT;
+    struct mmpkt *amsdu = NULL;
+
+    if (umac_datapath_amsdu_collect(umacd, stad, txbuf, &subframes) > 1)
+    {
+        amsdu = umac_datapath_amsdu_build(&subframes);
+    }
+
+    if (amsdu != NULL)
+    {
+        MMLOG_VRB("TX A-MSDU %p of %lu MSDUs\n", amsdu, mmpkt_list_length(&subframes));
+        mmpkt_list_clear(&subframes);
+        umac_datapath_process_tx_frame(umacd, stad, mmpkt_open(amsdu), true);
+        return;
+    }
+
+
+    while ((txbuf = mmpkt_list_dequeue(&subframes)) != NULL)
+    {
+        umac_datapath_process_tx_frame(umacd, stad, mmpkt_open(txbuf), false);
+    }
+}
+
+
 static inline bool umac_datapath_process_tx(struct umac_data *umacd,
                                             struct umac_datapath_data *data)
 {
@@ -2077,11 +2726,13 @@ static inline bool umac_datapath_process_tx(struct umac_data *umacd,
                   umac_sta_data_get_aid(stad),
                   tx_metadata->vif_id);
 
-        umac_datapath_process_tx_frame(umacd, stad, mmpkt_open(mmpkt));
+        umac_datapath_process_tx_data(umacd, stad, mmpkt);
     }
     return has_more;
 }
 
+static void umac_datapath_tx_mgmt_timeout_handler(void *arg1, void *arg2);
+
 static void umac_datapath_flush_txq(struct umac_data *umacd)
 {
     struct umac_datapath_data *data = umac_data_get_datapath(umacd);
@@ -2091,21 +2742,217 @@ static void umac_datapath_flush_txq(struct umac_data *umacd)
         more = umac_datapath_process_tx(umacd, data);
     } while (more);
 
+    struct mmpkt_list tx_mgmt_q = MMPKT_LIST_INIT;
+    MMOSAL_TASK_ENTER_CRITICAL();
+    mmpkt_list_append_list(&tx_mgmt_q, &data->tx_mgmt_q);
+    MMOSAL_TASK_EXIT_CRITICAL();
+    mmpkt_list_clear(&tx_mgmt_q);
+    umac_core_cancel_timeout(umacd, umac_datapath_tx_mgmt_timeout_handler, umacd, NULL);
+    data->tx_mgmt_timer_armed = false;
+
     umac_stats_clear_datapath_txq_high_water_mark(umacd);
     umac_stats_clear_datapath_txq_frames_dropped(umacd);
+    umac_stats_clear_datapath_txq_ac_high_water_marks(umacd);
+    umac_stats_clear_datapath_txq_ac_sojourn(umacd);
+    umac_stats_clear_datapath_txq_ac_aqm_drops(umacd);
+}
+
+static uint16_t umac_datapath_mgmt_frame_pause_mask(struct mmpkt *txbuf)
+{
+    struct mmpktview *txbufview = mmpkt_open(txbuf);
+    const struct dot11_hdr *header = (const struct dot11_hdr *)mmpkt_get_data_start(txbufview);
+    uint16_t pause_mask = ~MMDRV_PAUSE_SOURCE_MASK_PKTMEM;
+
+
+    if ((dot11_frame_control_get_type(header->frame_control) == DOT11_FC_TYPE_MGMT) &&
+        (dot11_frame_control_get_subtype(header->frame_control) == DOT11_FC_SUBTYPE_PROBE_REQ))
+    {
+        pause_mask &= ~UMAC_DATAPATH_PAUSE_SOURCE_SCAN;
+    }
+
+    mmpkt_close(&txbufview);
+    return pause_mask;
+}
+
+static enum mmwlan_status umac_datapath_send_mgmt_frame(struct umac_data *umacd,
+                                                        struct mmpkt *txbuf)
+{
+    umac_stats_update_last_tx_time(umacd);
+
+    enum mmwlan_status status = mmdrv_tx_frame(txbuf, true);
+    if (status != MMWLAN_SUCCESS)
+    {
+        MMLOG_WRN("Tx Error (%u)\n", status);
+    }
+    return status;
+}
+
+enum mmwlan_status umac_datapath_queue_mgmt_frame_tx(struct umac_data *umacd,
+                                                     struct mmpkt *txbuf,
+                                                     uint32_t timeout_ms)
+{
+    struct umac_datapath_data *data = umac_data_get_datapath(umacd);
+    uint16_t pause_mask = umac_datapath_mgmt_frame_pause_mask(txbuf);
+    bool queued = false;
+    bool queue_full = false;
+
+    mmdrv_get_tx_metadata(txbuf)->timeout_abs_ms = mmosal_get_time_ms() + timeout_ms;
+
+
+    MMOSAL_TASK_ENTER_CRITICAL();
+    if (!mmpkt_list_is_empty(&data->tx_mgmt_q) || umac_datapath_tx_is_paused(data, pause_mask))
+    {
+        if (mmpkt_list_length(&data->tx_mgmt_q) < UMAC_DATAPATH_DEFAULT_TX_MGMT_Q_MAXLEN)
+        {
+            mmpkt_list_append(&data->tx_mgmt_q, txbuf);
+            queued = true;
+        }
+        else
+        {
+            queue_full = true;
+        }
+    }
+    MMOSAL_TASK_EXIT_CRITICAL();
+
+    if (queue_full)
+    {
+        MMLOG_WRN("Tx Datapath Blocked (mgmt queue full)\n");
+        mmpkt_release(txbuf);
+        umac_stats_increment_datapath_txq_frames_dropped(umacd);
+        return MMWLAN_UNAVAILABLE;
+    }
+
+    if (queued)
+    {
+        MMLOG_DBG("Queued mgmt frame %p until TX resumes\n", txbuf);
+        umac_core_evt_wake(umacd);
+        return MMWLAN_SUCCESS;
+    }
+
+    return umac_datapath_send_mgmt_frame(umacd, txbuf);
+}
+
+
+static struct umac_sta_data *umac_datapath_lookup_tx_mgmt_stad(struct umac_data *umacd,
+                                                               struct mmpkt *txbuf)
+{
+    const struct mmdrv_tx_metadata *tx_metadata = mmdrv_get_tx_metadata(txbuf);
+    const struct umac_datapath_ops *datapath_ops =
+        umac_interface_get_datapath_ops_by_vif_id(umacd, tx_metadata->vif_id);
+    if (datapath_ops == NULL)
+    {
+        MMLOG_WRN("No ops for VIF %u. Dropping queued mgmt frame\n", tx_metadata->vif_id);
+        return NULL;
+    }
+
+    return datapath_ops->lookup_stad_by_aid(umacd, tx_metadata->aid);
+}
+
+static void umac_datapath_arm_tx_mgmt_timer(struct umac_data *umacd,
+                                            struct umac_datapath_data *data,
+                                            struct mmpkt *head)
+{
+    if (head == NULL)
+    {
+        if (data->tx_mgmt_timer_armed)
+        {
+            umac_core_cancel_timeout(umacd, umac_datapath_tx_mgmt_timeout_handler, umacd, NULL);
+            data->tx_mgmt_timer_armed = false;
+        }
+        return;
+    }
+
+    uint32_t timeout_abs_ms = mmdrv_get_tx_metadata(head)->timeout_abs_ms;
+    if (data->tx_mgmt_timer_armed && data->tx_mgmt_timer_abs_ms == timeout_abs_ms)
+    {
+        return;
+    }
+
+    umac_core_cancel_timeout(umacd, umac_datapath_tx_mgmt_timeout_handler, umacd, NULL);
+
+    uint32_t now = mmosal_get_time_ms();
+    uint32_t delta_ms = mmosal_time_lt(now, timeout_abs_ms) ? (timeout_abs_ms - now) : 0;
+    bool ok = umac_core_register_timeout(umacd,
+                                         delta_ms,
+                                         umac_datapath_tx_mgmt_timeout_handler,
+                                         umacd,
+                                         NULL);
+    if (!ok)
+    {
+        MMLOG_WRN("Failed to schedule mgmt frame timeout\n");
+    }
+
+    data->tx_mgmt_timer_armed = true;
+    data->tx_mgmt_timer_abs_ms = timeout_abs_ms;
+}
+
+static void umac_datapath_process_tx_mgmt_queue(struct umac_data *umacd,
+                                                struct umac_datapath_data *data)
+{
+    struct mmpkt *txbuf;
+
+    while (true)
+    {
+        MMOSAL_TASK_ENTER_CRITICAL();
+        txbuf = mmpkt_list_peek(&data->tx_mgmt_q);
+        MMOSAL_TASK_EXIT_CRITICAL();
+
+        if (txbuf == NULL)
+        {
+            break;
+        }
+
+        bool paused =
+            umac_datapath_tx_is_paused(data, umac_datapath_mgmt_frame_pause_mask(txbuf));
+        if (paused && !mmosal_time_has_passed(mmdrv_get_tx_metadata(txbuf)->timeout_abs_ms))
+        {
+            break;
+        }
+
+        MMOSAL_TASK_ENTER_CRITICAL();
+        mmpkt_list_dequeue(&data->tx_mgmt_q);
+        MMOSAL_TASK_EXIT_CRITICAL();
+
+        if (umac_datapath_lookup_tx_mgmt_stad(umacd, txbuf) == NULL)
+        {
+            MMLOG_INF("No STA data for queued mgmt frame - link down\n");
+            mmpkt_release(txbuf);
+            umac_stats_increment_datapath_txq_frames_dropped(umacd);
+            continue;
+        }
+
+        if (paused)
+        {
+            MMLOG_WRN("Tx Datapath Blocked, dropping queued mgmt frame\n");
+            umac_supp_tx_status(umacd, txbuf, false);
+            mmpkt_release(txbuf);
+            umac_stats_increment_datapath_txq_frames_dropped(umacd);
+            continue;
+        }
+
+        umac_datapath_send_mgmt_frame(umacd, txbuf);
+    }
+
+    umac_datapath_arm_tx_mgmt_timer(umacd, data, txbuf);
+}
+
+static void umac_datapath_tx_mgmt_timeout_handler(void *arg1, void *arg2)
+{
+    MM_UNUSED(arg2);
+    struct umac_data *umacd = (struct umac_data *)arg1;
+    struct umac_datapath_data *data = umac_data_get_datapath(umacd);
+
+    data->tx_mgmt_timer_armed = false;
+    umac_datapath_process_tx_mgmt_queue(umacd, data);
 }
 
 enum mmwlan_status umac_datapath_tx_mgmt_frame(struct umac_sta_data *stad, struct mmpkt *txbuf)
 {
-    enum mmwlan_status status;
     struct umac_data *umacd = umac_sta_data_get_umacd(stad);
-    struct umac_datapath_data *data = umac_data_get_datapath(umacd);
     struct umac_datapath_sta_data *sta_data = umac_sta_data_get_datapath(stad);
     struct mmpktview *txbufview = mmpkt_open(txbuf);
     struct dot11_hdr *header = (struct dot11_hdr *)mmpkt_get_data_start(txbufview);
     struct mmdrv_tx_metadata *tx_metadata = mmdrv_get_tx_metadata(txbuf);
-    uint32_t timeout_ms;
-    uint16_t pause_mask;
 
     uint8_t seq_num_space = MMDRV_SEQ_NUM_BASELINE;
 
@@ -2114,9 +2961,6 @@ enum mmwlan_status umac_datapath_tx_mgmt_frame(struct umac_sta_data *stad, struc
 
     tx_metadata->vif_id = umac_sta_data_get_vif_id(stad);
 
-    bool is_probe_request =
-        (dot11_frame_control_get_type(header->frame_control) == DOT11_FC_TYPE_MGMT) &&
-        (dot11_frame_control_get_subtype(header->frame_control) == DOT11_FC_SUBTYPE_PROBE_REQ);
     DOT11_SEQUENCE_CONTROL_SET_SEQUENCE_NUMBER(header->sequence_control,
                                                sta_data->tx_seq_num_spaces[seq_num_space]++);
 
@@ -2171,33 +3015,10 @@ enum mmwlan_status umac_datapath_tx_mgmt_frame(struct umac_sta_data *stad, struc
     umac_rc_init_rate_table_mgmt(umacd, &tx_metadata->rc_data, false);
 
 
-    pause_mask = ~MMDRV_PAUSE_SOURCE_MASK_PKTMEM;
-    if (is_probe_request)
-    {
-        pause_mask &= ~UMAC_DATAPATH_PAUSE_SOURCE_SCAN;
-    }
-
-    timeout_ms = umac_datapath_calculate_tx_timeout_ms(umacd, true);
-    status = umac_datapath_wait_for_tx_ready_(data, timeout_ms, pause_mask);
-    if (status != MMWLAN_SUCCESS)
-    {
-        MMLOG_WRN("Tx Datapath Blocked (is_probe_request=%d)\n", is_probe_request);
-        mmpkt_close(&txbufview);
-        mmpkt_release(txbuf);
-        umac_stats_increment_datapath_txq_frames_dropped(umacd);
-        return status;
-    }
-
-    umac_stats_update_last_tx_time(umacd);
-
     mmpkt_close(&txbufview);
-    status = mmdrv_tx_frame(txbuf, true);
-    if (status != MMWLAN_SUCCESS)
-    {
-        return status;
-    }
-
-    return MMWLAN_SUCCESS;
+    return umac_datapath_queue_mgmt_frame_tx(umacd,
+                                             txbuf,
+                                             umac_datapath_calculate_tx_timeout_ms(umacd, true));
 }
 
 void umac_datapath_handle_tx_status(struct umac_data *umacd, struct mmpkt *mmpkt)
@@ -2486,6 +3307,7 @@ bool umac_datapath_process(struct umac_data *umacd)
 {
     struct umac_datapath_data *data = umac_data_get_datapath(umacd);
     umac_datapath_process_tx_status_queue(umacd, data);
+    umac_datapath_process_tx_mgmt_queue(umacd, data);
     bool more_rx = umac_datapath_process_rx(umacd, data);
     bool more_tx = umac_datapath_process_tx(umacd, data);
     return more_rx || more_tx;
@@ -2536,6 +3358,7 @@ void umac_datapath_update_tx_paused(struct umac_data *umacd,
 
 
     MMOSAL_TASK_ENTER_CRITICAL();
+    uint16_t old_pause = data->tx_paused;
     bool is_paused = cb();
     if (is_paused)
     {
@@ -2545,6 +3368,9 @@ void umac_datapath_update_tx_paused(struct umac_data *umacd,
     {
         pause_state_changed = umac_datapath_unpause_protected(data, source_mask);
     }
+
+    bool mgmt_unblocked = (old_pause & ~data->tx_paused) != 0 &&
+                          !mmpkt_list_is_empty(&data->tx_mgmt_q);
     MMOSAL_TASK_EXIT_CRITICAL();
 
     MMLOG_DBG("Datapath paused (|= %08x): %d\n", source_mask, data->tx_paused);
@@ -2556,6 +3382,10 @@ void umac_datapath_update_tx_paused(struct umac_data *umacd,
         umac_core_evt_wake(umacd);
         mmosal_semb_give(data->tx_flowcontrol_sem);
     }
+    else if (mgmt_unblocked)
+    {
+        umac_core_evt_wake(umacd);
+    }
 
     if (pause_state_changed && data->tx_flow_control_callback != NULL)
     {
@@ -21,6 +21,21 @@
 #endif
 
 
+#ifndef UMAC_DATAPATH_DEFAULT_AMSDU_MAX_LEN
+#define UMAC_DATAPATH_DEFAULT_AMSDU_MAX_LEN (3839)
+#endif
+
+
+#ifndef UMAC_DATAPATH_DEFAULT_AMSDU_MAX_SUBFRAMES
+#define UMAC_DATAPATH_DEFAULT_AMSDU_MAX_SUBFRAMES (4)
+#endif
+
+
+#ifndef UMAC_DATAPATH_DEFAULT_TX_MGMT_Q_MAXLEN
+#define UMAC_DATAPATH_DEFAULT_TX_MGMT_Q_MAXLEN (8)
+#endif
+
+
 struct umac_datapath_ops;
 
 
@@ -44,6 +59,12 @@ void umac_datapath_stad_flush(struct umac_data *umacd, struct umac_sta_data *sta
 void umac_datapath_stad_flush_txq(struct umac_data *umacd, struct umac_sta_data *stad);
 
 
+void umac_datapath_invalidate_tx_templates(struct umac_sta_data *stad);
+
+
+bool umac_datapath_alloc_rx_reorder_list_for_tid(struct umac_sta_data *stad, uint16_t tid);
+
+
 void umac_datapath_flush_rx_reorder_list_for_tid(struct umac_sta_data *stad, uint16_t tid);
 
 
@@ -63,6 +84,15 @@ enum mmwlan_status umac_datapath_register_rx_pkt_ext_cb(struct umac_data *umacd,
                                                         void *arg);
 
 
+enum mmwlan_status umac_datapath_register_rx_pkt_batch_cb(struct umac_data *umacd,
+                                                          enum mmwlan_vif vif,
+                                                          mmwlan_rx_pkt_batch_cb_t callback,
+                                                          void *arg);
+
+
+void umac_datapath_deliver_rx_batches(struct umac_data *umacd);
+
+
 void umac_datapath_rx_frame(struct umac_data *umacd, struct mmpkt *rxbuf);
 
 
@@ -88,6 +118,12 @@ enum mmwlan_status umac_datapath_tx_frame(struct umac_data *umacd,
                                           const uint8_t *ra);
 
 
+enum mmwlan_status umac_datapath_tx_frames(struct umac_data *umacd,
+                                           struct mmpkt_list *txbufs,
+                                           enum umac_datapath_frame_encryption enc,
+                                           const uint8_t *ra);
+
+
 enum mmwlan_status umac_datapath_wait_for_tx_ready(struct umac_data *umacd, uint32_t timeout_ms);
 
 
@@ -108,14 +108,10 @@ enum mmwlan_status umac_datapath_tx_mgmt_frame_ap(struct umac_data *umacd,
                                                   struct mmpkt *txbuf,
                                                   struct mmrc_rate *mmrc_rate_override)
 {
-    enum mmwlan_status status;
-    struct umac_datapath_data *data = umac_data_get_datapath(umacd);
     struct mmpktview *txbufview = mmpkt_open(txbuf);
     struct dot11_hdr *header = (struct dot11_hdr *)mmpkt_get_data_start(txbufview);
     struct mmdrv_tx_metadata *tx_metadata = mmdrv_get_tx_metadata(txbuf);
 
-    uint32_t timeout_ms;
-    uint16_t pause_mask;
     int key_id = -1;
 
 
@@ -173,30 +169,8 @@ enum mmwlan_status umac_datapath_tx_mgmt_frame_ap(struct umac_data *umacd,
     }
 
 
-    pause_mask = ~MMDRV_PAUSE_SOURCE_MASK_PKTMEM;
-
-    timeout_ms = MMWLAN_TX_DEFAULT_TIMEOUT_MS;
-    status = umac_datapath_wait_for_tx_ready_(data, timeout_ms, pause_mask);
-    if (status != MMWLAN_SUCCESS)
-    {
-        MMLOG_WRN("Tx Datapath Blocked\n");
-        mmpkt_close(&txbufview);
-        mmpkt_release(txbuf);
-        umac_stats_increment_datapath_txq_frames_dropped(umacd);
-        return status;
-    }
-
-    umac_stats_update_last_tx_time(umacd);
-
     mmpkt_close(&txbufview);
-    enum mmwlan_status tx_status = mmdrv_tx_frame(txbuf, true);
-    if (tx_status != MMWLAN_SUCCESS)
-    {
-        MMLOG_WRN("Tx Error\n");
-        return tx_status;
-    }
-
-    return MMWLAN_SUCCESS;
+    return umac_datapath_queue_mgmt_frame_tx(umacd, txbuf, MMWLAN_TX_DEFAULT_TIMEOUT_MS);
 }
 
 static bool umac_datapath_ap_update_stad_state_rx(struct umac_sta_data *stad,
@@ -280,8 +254,9 @@ static const struct umac_datapath_ops datapath_ops_ap = {
     .lookup_stad_by_aid = umac_ap_lookup_sta_by_aid,
     .update_stad_state_rx = umac_datapath_ap_update_stad_state_rx,
     .is_stad_tx_paused = umac_ap_is_stad_paused,
-    .enqueue_tx_frame = umac_ap_queue_pkt,
+    .enqueue_tx_frames = umac_ap_queue_pkts,
     .dequeue_tx_frame = umac_ap_tx_dequeue_frame,
+    .dequeue_tx_frame_if = umac_ap_tx_dequeue_frame_if,
     .construct_80211_data_header = umac_datapath_construct_80211_data_header_ap,
     .get_sta_state = umac_ap_get_sta_state,
     .supp_l2_sock_receive = umac_supp_l2_sock_receive_ap,
@@ -12,6 +12,7 @@
 #include "mmwlan_internal.h"
 #include "umac_datapath.h"
 #include "dot11/dot11.h"
+#include "dot11/dot11_frames.h"
 
 
 struct datapath_defrag_data_chain
@@ -19,9 +20,13 @@ struct datapath_defrag_data_chain
 
     uint16_t sequence_number;
 
+    uint8_t next_fragment_number;
+
     bool is_protected;
 
-    struct mmpkt *buf;
+    uint32_t length;
+
+    struct mmpkt_list frags;
 };
 
 
@@ -34,9 +39,24 @@ struct datapath_defrag_data
 };
 
 
+#define DATAPATH_TXQ_CODEL_MAX_DROP_COUNT (4095)
+
+
 struct datapath_txq_data
 {
     struct mmpkt_list queue;
+
+    uint32_t first_above_time_ms;
+
+    uint32_t drop_next_ms;
+
+    uint16_t drop_count;
+
+    uint16_t last_drop_count;
+
+    bool dropping;
+
+    uint8_t credit;
 };
 
 
@@ -55,6 +75,12 @@ struct umac_datapath_data
 
     struct mmpkt_list tx_status_q;
 
+    struct mmpkt_list tx_mgmt_q;
+
+    bool tx_mgmt_timer_armed;
+
+    uint32_t tx_mgmt_timer_abs_ms;
+
     struct mmpkt_list rxq;
 
     struct mmpkt_list rx_mgmt_q;
@@ -73,6 +99,32 @@ struct umac_datapath_data
 };
 
 
+struct umac_datapath_rx_reorder
+{
+
+    struct mmpkt_list list;
+
+    uint8_t tid;
+};
+
+
+struct umac_datapath_tx_template
+{
+
+    bool valid;
+
+    int key_id;
+
+    uint8_t ccmp_len;
+
+    uint8_t dest_addr[DOT11_MAC_ADDR_LEN];
+
+    uint8_t src_addr[DOT11_MAC_ADDR_LEN];
+
+    struct dot11_data_hdr data_hdr;
+};
+
+
 struct umac_datapath_sta_data
 {
 
@@ -82,7 +134,7 @@ struct umac_datapath_sta_data
 
     struct datapath_defrag_data defrag_data;
 
-    struct mmpkt_list rx_reorder_list;
+    struct umac_datapath_rx_reorder *rx_reorder[MMWLAN_MAX_QOS_TID + 1];
 
-    uint16_t rx_reorder_tid;
+    struct umac_datapath_tx_template tx_templates[MMWLAN_MAX_QOS_TID + 1];
 };
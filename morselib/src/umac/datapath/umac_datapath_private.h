@@ -42,9 +42,9 @@ struct umac_datapath_ops
     bool (*is_stad_tx_paused)(struct umac_sta_data *stad);
 
 
-    void (*enqueue_tx_frame)(struct umac_data *umacd,
-                             struct umac_sta_data *stad,
-                             struct mmpkt *txbuf);
+    void (*enqueue_tx_frames)(struct umac_data *umacd,
+                              struct umac_sta_data *stad,
+                              struct mmpkt_list *txbufs);
 
 
     bool (*dequeue_tx_frame)(struct umac_data *umacd,
@@ -52,6 +52,12 @@ struct umac_datapath_ops
                              struct mmpkt **txbuf);
 
 
+    struct mmpkt *(*dequeue_tx_frame_if)(struct umac_data *umacd,
+                                         struct umac_sta_data *stad,
+                                         bool (*match)(struct mmpkt *txbuf, void *arg),
+                                         void *arg);
+
+
     void (*construct_80211_data_header)(struct umac_sta_data *stad,
                                         const struct umac_8023_hdr *hdr_8023,
                                         struct dot11_data_hdr *data_hdr);
@@ -84,3 +90,8 @@ void umac_datapath_process_rx_action_frame(struct umac_data *umacd,
 enum mmwlan_status umac_datapath_wait_for_tx_ready_(struct umac_datapath_data *data,
                                                     uint32_t timeout_ms,
                                                     uint16_t mask);
+
+
+enum mmwlan_status umac_datapath_queue_mgmt_frame_tx(struct umac_data *umacd,
+                                                     struct mmpkt *txbuf,
+                                                     uint32_t timeout_ms);
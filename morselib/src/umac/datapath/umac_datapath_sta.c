@@ -164,12 +164,17 @@ static bool nullop_update_stad_state_sta(struct umac_sta_data *stad,
     return stad != NULL && metadata != NULL;
 }
 
-static void umac_datapath_tx_queue_frame_sta(struct umac_data *umacd,
-                                             struct umac_sta_data *stad,
-                                             struct mmpkt *txbuf)
+static void umac_datapath_tx_queue_frames_sta(struct umac_data *umacd,
+                                              struct umac_sta_data *stad,
+                                              struct mmpkt_list *txbufs)
 {
+    struct mmpkt *txbuf;
+
     MMOSAL_TASK_ENTER_CRITICAL();
-    umac_sta_data_queue_pkt(stad, txbuf);
+    while ((txbuf = mmpkt_list_dequeue(txbufs)) != NULL)
+    {
+        umac_sta_data_queue_pkt(stad, txbuf);
+    }
     umac_stats_update_datapath_txq_high_water_mark(umacd, umac_sta_data_get_queued_len(stad));
     MMOSAL_TASK_EXIT_CRITICAL();
 }
@@ -183,6 +188,7 @@ static bool umac_datapath_tx_dequeue_frame_sta(struct umac_data *umacd,
     *txbuf_ptr = NULL;
 
     struct umac_sta_data *stad = umac_connection_get_stad(umacd);
+    struct mmpkt_list dropped = MMPKT_LIST_INIT;
     bool has_more = false;
 
     if (stad == NULL || umac_sta_data_is_paused(stad))
@@ -190,9 +196,10 @@ static bool umac_datapath_tx_dequeue_frame_sta(struct umac_data *umacd,
         return false;
     }
     MMOSAL_TASK_ENTER_CRITICAL();
-    *txbuf_ptr = umac_sta_data_pop_pkt(stad);
+    *txbuf_ptr = umac_sta_data_pop_pkt(stad, &dropped);
     has_more = umac_sta_data_get_queued_len(stad);
     MMOSAL_TASK_EXIT_CRITICAL();
+    mmpkt_list_clear(&dropped);
     if (*txbuf_ptr != NULL)
     {
         *stad_ptr = stad;
@@ -200,6 +207,19 @@ static bool umac_datapath_tx_dequeue_frame_sta(struct umac_data *umacd,
     return has_more;
 }
 
+static struct mmpkt *umac_datapath_tx_dequeue_frame_if_sta(struct umac_data *umacd,
+                                                           struct umac_sta_data *stad,
+                                                           bool (*match)(struct mmpkt *txbuf,
+                                                                         void *arg),
+                                                           void *arg)
+{
+    MM_UNUSED(umacd);
+    MMOSAL_TASK_ENTER_CRITICAL();
+    struct mmpkt *txbuf = umac_sta_data_pop_pkt_if(stad, match, arg);
+    MMOSAL_TASK_EXIT_CRITICAL();
+    return txbuf;
+}
+
 static void umac_datapath_sta_handle_frame_unknown_sta(struct umac_data *umacd, const uint8_t *ta)
 {
     MM_UNUSED(umacd);
@@ -215,8 +235,9 @@ static const struct umac_datapath_ops datapath_ops_sta = {
     .lookup_stad_by_aid = umac_datapath_lookup_stad_by_aid_sta,
     .update_stad_state_rx = nullop_update_stad_state_sta,
     .is_stad_tx_paused = umac_sta_data_is_paused,
-    .enqueue_tx_frame = umac_datapath_tx_queue_frame_sta,
+    .enqueue_tx_frames = umac_datapath_tx_queue_frames_sta,
     .dequeue_tx_frame = umac_datapath_tx_dequeue_frame_sta,
+    .dequeue_tx_frame_if = umac_datapath_tx_dequeue_frame_if_sta,
     .construct_80211_data_header = umac_datapath_construct_80211_data_header_sta,
     .get_sta_state = umac_datapath_get_state_sta,
     .supp_l2_sock_receive = umac_supp_l2_sock_receive,
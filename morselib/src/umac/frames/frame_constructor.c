@@ -9,22 +9,58 @@
 #include "umac/datapath/umac_datapath.h"
 #include "mmdrv.h"
 
-struct mmpkt *build_mgmt_frame(struct umac_data *umacd, mgmt_frame_builder_t builder, void *params)
-{
 
-    struct consbuf cbuf = CONSBUF_INIT_WITHOUT_BUF;
-    builder(umacd, &cbuf, params);
-    struct mmpkt *mmpkt = umac_datapath_alloc_raw_tx_mmpkt(MMDRV_PKT_CLASS_MGMT, 0, cbuf.offset);
+static struct mmpkt *build_mgmt_frame_into(struct umac_data *umacd,
+                                           mgmt_frame_builder_t builder,
+                                           void *params,
+                                           uint32_t capacity,
+                                           struct consbuf *cbuf)
+{
+    struct mmpkt *mmpkt = umac_datapath_alloc_raw_tx_mmpkt(MMDRV_PKT_CLASS_MGMT, 0, capacity);
     if (mmpkt == NULL)
     {
-        MMLOG_WRN("Failed to allocate mgmt frame (len %lu)\n", cbuf.offset);
         return NULL;
     }
+
     struct mmpktview *view = mmpkt_open(mmpkt);
-    consbuf_reinit_from_mmpkt(&cbuf, view);
-    builder(umacd, &cbuf, params);
-    uint8_t *ret = mmpkt_append(view, cbuf.offset);
+    consbuf_reinit_from_mmpkt(cbuf, view);
+    cbuf->allow_overflow = true;
+    builder(umacd, cbuf, params);
+    if (cbuf->overflowed)
+    {
+        mmpkt_close(&view);
+        mmpkt_release(mmpkt);
+        return NULL;
+    }
+
+    uint8_t *ret = mmpkt_append(view, cbuf->offset);
     MMOSAL_ASSERT(ret != NULL);
     mmpkt_close(&view);
     return mmpkt;
 }
+
+struct mmpkt *build_mgmt_frame(struct umac_data *umacd, mgmt_frame_builder_t builder, void *params)
+{
+
+    struct consbuf cbuf = CONSBUF_INIT_WITHOUT_BUF;
+    struct mmpkt *mmpkt =
+        build_mgmt_frame_into(umacd, builder, params, MGMT_FRAME_SIZE_ESTIMATE, &cbuf);
+    if (mmpkt != NULL)
+    {
+        return mmpkt;
+    }
+
+
+    if (!cbuf.overflowed)
+    {
+        consbuf_reinit(&cbuf, NULL, 0);
+        builder(umacd, &cbuf, params);
+    }
+
+    mmpkt = build_mgmt_frame_into(umacd, builder, params, cbuf.offset, &cbuf);
+    if (mmpkt == NULL)
+    {
+        MMLOG_WRN("Failed to allocate mgmt frame (len %lu)\n", cbuf.offset);
+    }
+    return mmpkt;
+}
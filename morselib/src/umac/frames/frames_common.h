@@ -16,6 +16,11 @@
 #include "umac/data/umac_data.h"
 
 
+#ifndef MGMT_FRAME_SIZE_ESTIMATE
+#define MGMT_FRAME_SIZE_ESTIMATE (256)
+#endif
+
+
 typedef void (*mgmt_frame_builder_t)(struct umac_data *umacd, struct consbuf *buf, void *params);
 
 
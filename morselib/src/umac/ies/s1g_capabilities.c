@@ -126,6 +126,12 @@ void ie_s1g_capabilities_build(struct umac_data *umacd, struct consbuf *buf)
             DOT11_S1G_CAP_INFO_5_SET_AMPDU_SUPPORTED(ie->s1g_capabilities_information[5], true);
         }
 
+        if (umac_config_is_amsdu_enabled(umacd) &&
+            MORSE_CAP_SUPPORTED(umac_interface_get_capabilities(umacd), AMSDU))
+        {
+            DOT11_S1G_CAP_INFO_5_SET_AMSDU_SUPPORTED(ie->s1g_capabilities_information[5], true);
+        }
+
         if (umac_connection_is_cac_enabled(sta_args))
         {
             DOT11_S1G_CAP_INFO_5_SET_CAC(ie->s1g_capabilities_information[5], true);
@@ -266,6 +272,12 @@ void ie_s1g_capabilities_build_ap(struct umac_data *umacd, struct consbuf *buf)
             ie->s1g_capabilities_information[5] |= DOT11_MASK_S1G_CAP5_AMPDU_SUPPORTED;
         }
 
+        if (umac_config_is_amsdu_enabled(umacd) &&
+            MORSE_CAP_SUPPORTED(umac_interface_get_capabilities(umacd), AMSDU))
+        {
+            ie->s1g_capabilities_information[5] |= DOT11_MASK_S1G_CAP5_AMSDU_SUPPORTED;
+        }
+
 
         if (false)
         {
@@ -416,6 +416,8 @@ void ie_s1g_tim_build(struct consbuf *buf,
     };
 
     MM_STATIC_ASSERT(MAX_SUPPORTED_PVB_LEN <= MAX_PVB_LEN, "Must not exceed spec limit");
+    MM_STATIC_ASSERT(sizeof(struct dot11_ie_tim) + MAX_SUPPORTED_PVB_LEN <= S1G_TIM_MAX_BUILD_LEN,
+                     "S1G_TIM_MAX_BUILD_LEN too small");
 
     if (consbuf_reserve(buf, 0) == NULL)
     {
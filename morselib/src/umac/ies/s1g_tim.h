@@ -10,6 +10,9 @@
 #define S1G_TIM_MAX_BLOCK_SIZE 256
 
 
+#define S1G_TIM_MAX_BUILD_LEN (sizeof(struct dot11_ie_tim) + 10)
+
+
 const struct dot11_ie_tim *ie_s1g_tim_find(const uint8_t *ies, size_t ies_len);
 
 
@@ -1012,6 +1012,8 @@ enum mmwlan_status umac_interface_register_rx_pkt_ext_cb(struct umac_data *umacd
 
     data->rx_pkt_ext_cb = callback;
     data->rx_pkt_ext_cb_arg = arg;
+    data->rx_pkt_batch_cb = NULL;
+    data->rx_pkt_batch_cb_arg = NULL;
 
     return MMWLAN_SUCCESS;
 }
@@ -1032,3 +1034,72 @@ mmwlan_rx_pkt_ext_cb_t umac_interface_get_rx_pkt_ext_cb(struct umac_data *umacd,
     *arg = data->rx_pkt_ext_cb_arg;
     return data->rx_pkt_ext_cb;
 }
+
+enum mmwlan_status umac_interface_register_rx_pkt_batch_cb(struct umac_data *umacd,
+                                                           enum mmwlan_vif vif,
+                                                           mmwlan_rx_pkt_batch_cb_t callback,
+                                                           void *arg)
+{
+    if (vif == MMWLAN_VIF_UNSPECIFIED)
+    {
+        umac_interface_register_rx_pkt_batch_cb(umacd, MMWLAN_VIF_STA, callback, arg);
+        umac_interface_register_rx_pkt_batch_cb(umacd, MMWLAN_VIF_AP, callback, arg);
+        return MMWLAN_SUCCESS;
+    }
+
+    struct umac_interface_vif_data *data = umac_data_get_interface_vif(umacd, vif);
+    if (data == NULL)
+    {
+        return MMWLAN_INVALID_ARGUMENT;
+    }
+
+    data->rx_pkt_ext_cb = NULL;
+    data->rx_pkt_ext_cb_arg = NULL;
+    data->rx_pkt_batch_cb = callback;
+    data->rx_pkt_batch_cb_arg = arg;
+
+    return MMWLAN_SUCCESS;
+}
+
+bool umac_interface_has_rx_pkt_batch_cb(struct umac_data *umacd, enum mmwlan_vif vif)
+{
+    struct umac_interface_vif_data *data = umac_data_get_interface_vif(umacd, vif);
+    return data != NULL && data->rx_pkt_batch_cb != NULL;
+}
+
+bool umac_interface_queue_rx_pkt_batch(struct umac_data *umacd,
+                                       enum mmwlan_vif vif,
+                                       struct mmpkt *rxbuf)
+{
+    struct umac_interface_vif_data *data = umac_data_get_interface_vif(umacd, vif);
+    if (data == NULL || data->rx_pkt_batch_cb == NULL)
+    {
+        return false;
+    }
+
+    mmpkt_list_append(&data->rx_pkt_batch, rxbuf);
+    return true;
+}
+
+static void umac_interface_deliver_rx_pkt_batch(struct umac_data *umacd, enum mmwlan_vif vif)
+{
+    struct umac_interface_vif_data *data = umac_data_get_interface_vif(umacd, vif);
+    if (mmpkt_list_is_empty(&data->rx_pkt_batch))
+    {
+        return;
+    }
+
+    if (data->rx_pkt_batch_cb != NULL)
+    {
+        data->rx_pkt_batch_cb(&data->rx_pkt_batch, vif, data->rx_pkt_batch_cb_arg);
+    }
+
+
+    mmpkt_list_clear(&data->rx_pkt_batch);
+}
+
+void umac_interface_deliver_rx_pkt_batches(struct umac_data *umacd)
+{
+    umac_interface_deliver_rx_pkt_batch(umacd, MMWLAN_VIF_STA);
+    umac_interface_deliver_rx_pkt_batch(umacd, MMWLAN_VIF_AP);
+}
@@ -186,3 +186,20 @@ mmwlan_rx_pkt_ext_cb_t umac_interface_get_rx_pkt_ext_cb(struct umac_data *umacd,
                                                         enum mmwlan_vif vif,
                                                         void **arg);
 
+
+enum mmwlan_status umac_interface_register_rx_pkt_batch_cb(struct umac_data *umacd,
+                                                           enum mmwlan_vif vif,
+                                                           mmwlan_rx_pkt_batch_cb_t callback,
+                                                           void *arg);
+
+
+bool umac_interface_queue_rx_pkt_batch(struct umac_data *umacd,
+                                       enum mmwlan_vif vif,
+                                       struct mmpkt *rxbuf);
+
+
+bool umac_interface_has_rx_pkt_batch_cb(struct umac_data *umacd, enum mmwlan_vif vif);
+
+
+void umac_interface_deliver_rx_pkt_batches(struct umac_data *umacd);
+
@@ -28,6 +28,13 @@ struct umac_interface_vif_data
     mmwlan_rx_pkt_ext_cb_t rx_pkt_ext_cb;
 
     void *rx_pkt_ext_cb_arg;
+
+
+    mmwlan_rx_pkt_batch_cb_t rx_pkt_batch_cb;
+
+    void *rx_pkt_batch_cb_arg;
+
+    struct mmpkt_list rx_pkt_batch;
 };
 
 struct umac_interface_data
@@ -8,6 +8,7 @@
 #include "umac_keys.h"
 #include "umac_keys_data.h"
 #include "connection_keys.h"
+#include "umac/datapath/umac_datapath.h"
 #include "mmdrv.h"
 #include "mmlog.h"
 
@@ -15,6 +16,7 @@ void umac_keys_init(struct umac_sta_data *stad)
 {
     struct umac_keys_sta_data *sta_data = umac_sta_data_get_keys(stad);
     connection_keys_init(&sta_data->keys);
+    umac_datapath_invalidate_tx_templates(stad);
 }
 
 
@@ -65,6 +67,8 @@ enum mmwlan_status umac_keys_install_key(struct umac_sta_data *stad,
 
     MMLOG_DBG("Installing key %u of type %u\n", key->key_id, key->key_type);
 
+    umac_datapath_invalidate_tx_templates(stad);
+
     return umac_keys_mmdrv_install_key(vif_id, aid, key);
 }
 
@@ -81,6 +85,8 @@ enum mmwlan_status umac_keys_uninstall_key(struct umac_sta_data *stad,
         return MMWLAN_SUCCESS;
     }
 
+    umac_datapath_invalidate_tx_templates(stad);
+
     enum umac_key_type key_type = connection_keys_get_key_type(&sta_data->keys, key_id);
 
     if ((key_type == UMAC_KEY_TYPE_PAIRWISE) || (key_type == UMAC_KEY_TYPE_GROUP))
@@ -132,7 +132,18 @@ static uint32_t hw_scan_pack_channel(const struct mmwlan_s1g_channel *channel, u
     return packed_channel;
 }
 
-static void hw_scan_construct_channel_list_tlv(struct umac_data *umacd, struct consbuf *cbuf)
+static bool hw_scan_channel_contains_freq(const struct mmwlan_s1g_channel *channel,
+                                          uint32_t freq_hz)
+{
+    uint32_t half_bw_hz = channel->bw_mhz * 500000ul;
+
+    return (freq_hz + half_bw_hz > channel->centre_freq_hz) &&
+           (freq_hz < channel->centre_freq_hz + half_bw_hz);
+}
+
+static void hw_scan_construct_channel_list_tlv(struct umac_data *umacd,
+                                               struct consbuf *cbuf,
+                                               uint32_t channel_freq_hz)
 {
     MM_UNUSED(umacd);
 
@@ -147,6 +158,11 @@ static void hw_scan_construct_channel_list_tlv(struct umac_data *umacd, struct c
          current_channel_index++)
     {
 
+        if (channel_freq_hz != 0 && !hw_scan_channel_contains_freq(s1g_channel, channel_freq_hz))
+        {
+            continue;
+        }
+
         if (s1g_channel->bw_mhz <= 2)
         {
             uint32_t index;
@@ -322,9 +338,10 @@ static void hw_scan_construct_probe_req_tlv(struct umac_data *umacd,
 
 static void hw_scan_add_request_tlvs_to_cbuf(struct umac_data *umacd,
                                              struct consbuf *cbuf,
-                                             const struct mmwlan_scan_args *scan_args)
+                                             const struct mmwlan_scan_args *scan_args,
+                                             uint32_t channel_freq_hz)
 {
-    hw_scan_construct_channel_list_tlv(umacd, cbuf);
+    hw_scan_construct_channel_list_tlv(umacd, cbuf, channel_freq_hz);
     hw_scan_construct_power_list_tlv(umacd, cbuf);
 
     if (scan_args->dwell_on_home_ms != 0)
@@ -341,13 +358,19 @@ static enum mmwlan_status hw_scan_start(struct umac_data *umacd)
     struct umac_scan_data *data = umac_data_get_scan(umacd);
     struct consbuf cbuf = CONSBUF_INIT_WITHOUT_BUF;
 
-    hw_scan_add_request_tlvs_to_cbuf(umacd, &cbuf, &data->active_scan_req->args);
+    hw_scan_add_request_tlvs_to_cbuf(umacd,
+                                     &cbuf,
+                                     &data->active_scan_req->args,
+                                     data->active_scan_req->channel_freq_hz);
 
     uint8_t *buf = (uint8_t *)mmosal_malloc(cbuf.offset);
     MMOSAL_ASSERT(buf);
     consbuf_reinit(&cbuf, buf, cbuf.offset);
 
-    hw_scan_add_request_tlvs_to_cbuf(umacd, &cbuf, &data->active_scan_req->args);
+    hw_scan_add_request_tlvs_to_cbuf(umacd,
+                                     &cbuf,
+                                     &data->active_scan_req->args,
+                                     data->active_scan_req->channel_freq_hz);
 
     uint16_t vif_id = umac_interface_get_vif_id(umacd, UMAC_INTERFACE_SCAN);
     if (vif_id == MMDRV_VIF_ID_INVALID)
@@ -382,13 +405,13 @@ enum mmwlan_status hw_scan_store_scan_config(struct umac_data *umacd,
     enum mmwlan_status status = MMWLAN_SUCCESS;
     struct consbuf cbuf = CONSBUF_INIT_WITHOUT_BUF;
 
-    hw_scan_add_request_tlvs_to_cbuf(umacd, &cbuf, scan_args);
+    hw_scan_add_request_tlvs_to_cbuf(umacd, &cbuf, scan_args, 0);
 
     uint8_t *buf = (uint8_t *)mmosal_malloc(cbuf.offset);
     MMOSAL_ASSERT(buf);
     consbuf_reinit(&cbuf, buf, cbuf.offset);
 
-    hw_scan_add_request_tlvs_to_cbuf(umacd, &cbuf, scan_args);
+    hw_scan_add_request_tlvs_to_cbuf(umacd, &cbuf, scan_args, 0);
 
     uint16_t vif_id = umac_interface_get_vif_id(umacd, UMAC_INTERFACE_SCAN);
     if (vif_id == MMDRV_VIF_ID_INVALID)
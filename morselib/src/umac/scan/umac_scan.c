@@ -12,6 +12,8 @@
 #include "umac/ies/s1g_operation.h"
 #include "umac/regdb/umac_regdb.h"
 #include "mmdrv.h"
+#include "common/common.h"
+#include "common/mac_address.h"
 #include "umac/core/umac_core_private.h"
 
 #include "hw_scan_fsm.h"
@@ -194,6 +196,257 @@ void umac_scan_fill_result(struct mmwlan_scan_result *res, const struct umac_sca
     PACK_LE64(res->tsf, rsp->frame.timestamp);
 }
 
+
+#define UMAC_SCAN_BSS_CACHE_SERIALISED_VERSION (2)
+
+#define UMAC_SCAN_BSS_CACHE_SERIALISED_HDR_LEN (2)
+
+#define UMAC_SCAN_BSS_CACHE_SERIALISED_ENTRY_LEN \
+    (MMWLAN_MAC_ADDR_LEN + 1 + MMWLAN_SSID_MAXLEN + 4 + 1 + 1 + 2 + \
+     sizeof(struct dot11_ie_s1g_operation))
+
+static void umac_scan_bss_cache_update(struct umac_scan_data *data,
+                                       const struct umac_scan_response *rsp,
+                                       const struct dot11_ie_s1g_operation *s1g_op)
+{
+    struct umac_scan_bss_cache_entry *entry = NULL;
+    unsigned ii;
+
+    if (rsp->frame.ssid_len == 0 || rsp->frame.ssid_len > MMWLAN_SSID_MAXLEN ||
+        s1g_op->header.length != sizeof(*s1g_op) - sizeof(s1g_op->header))
+    {
+        return;
+    }
+
+    for (ii = 0; ii < UMAC_SCAN_BSS_CACHE_MAX_ENTRIES; ii++)
+    {
+        struct umac_scan_bss_cache_entry *candidate = &data->bss_cache[ii];
+
+        if (candidate->ssid_len != 0 && mm_mac_addr_is_equal(candidate->bssid, rsp->frame.bssid))
+        {
+            entry = candidate;
+            break;
+        }
+
+
+        if (entry == NULL || (entry->ssid_len != 0 &&
+                              (candidate->ssid_len == 0 ||
+                               candidate->timestamp_ms < entry->timestamp_ms)))
+        {
+            entry = candidate;
+        }
+    }
+
+    MMOSAL_TASK_ENTER_CRITICAL();
+    mac_addr_copy(entry->bssid, rsp->frame.bssid);
+    memcpy(entry->ssid, rsp->frame.ssid, rsp->frame.ssid_len);
+    entry->ssid_len = rsp->frame.ssid_len;
+    entry->bw_mhz = rsp->bw_mhz;
+    entry->op_bw_mhz = rsp->op_bw_mhz;
+    entry->rssi = rsp->rssi;
+    entry->beacon_interval = rsp->frame.beacon_interval;
+    entry->channel_freq_hz = rsp->channel_freq_hz;
+    entry->timestamp_ms = mmosal_get_time_ms();
+    memcpy(&entry->s1g_operation, s1g_op, sizeof(entry->s1g_operation));
+    MMOSAL_TASK_EXIT_CRITICAL();
+}
+
+bool umac_scan_bss_cache_lookup(struct umac_data *umacd,
+                                const uint8_t *ssid,
+                                size_t ssid_len,
+                                const uint8_t *bssid,
+                                struct umac_scan_bss_cache_entry *entry)
+{
+    struct umac_scan_data *data = umac_data_get_scan(umacd);
+    const struct umac_scan_bss_cache_entry *best = NULL;
+    unsigned ii;
+
+    if (ssid_len == 0)
+    {
+        return false;
+    }
+
+    MMOSAL_TASK_ENTER_CRITICAL();
+    for (ii = 0; ii < UMAC_SCAN_BSS_CACHE_MAX_ENTRIES; ii++)
+    {
+        const struct umac_scan_bss_cache_entry *candidate = &data->bss_cache[ii];
+
+        if (candidate->ssid_len != ssid_len || memcmp(candidate->ssid, ssid, ssid_len) != 0)
+        {
+            continue;
+        }
+
+        if (bssid != NULL && !mm_mac_addr_is_zero(bssid) &&
+            !mm_mac_addr_is_equal(candidate->bssid, bssid))
+        {
+            continue;
+        }
+
+        if (best == NULL || candidate->timestamp_ms > best->timestamp_ms)
+        {
+            best = candidate;
+        }
+    }
+
+    if (best != NULL)
+    {
+        *entry = *best;
+    }
+    MMOSAL_TASK_EXIT_CRITICAL();
+
+    return best != NULL;
+}
+
+void umac_scan_bss_cache_invalidate(struct umac_data *umacd, const uint8_t *bssid)
+{
+    struct umac_scan_data *data = umac_data_get_scan(umacd);
+    unsigned ii;
+
+    MMOSAL_TASK_ENTER_CRITICAL();
+    for (ii = 0; ii < UMAC_SCAN_BSS_CACHE_MAX_ENTRIES; ii++)
+    {
+        if (mm_mac_addr_is_equal(data->bss_cache[ii].bssid, bssid))
+        {
+            memset(&data->bss_cache[ii], 0, sizeof(data->bss_cache[ii]));
+        }
+    }
+    MMOSAL_TASK_EXIT_CRITICAL();
+}
+
+void umac_scan_bss_cache_clear(struct umac_data *umacd)
+{
+    struct umac_scan_data *data = umac_data_get_scan(umacd);
+
+    MMOSAL_TASK_ENTER_CRITICAL();
+    memset(data->bss_cache, 0, sizeof(data->bss_cache));
+    MMOSAL_TASK_EXIT_CRITICAL();
+}
+
+int umac_scan_bss_cache_serialise(struct umac_data *umacd, uint8_t *buf, size_t buf_size)
+{
+    struct umac_scan_data *data = umac_data_get_scan(umacd);
+    struct umac_scan_bss_cache_entry entries[UMAC_SCAN_BSS_CACHE_MAX_ENTRIES];
+    unsigned num_entries = 0;
+    unsigned ii;
+
+    MMOSAL_TASK_ENTER_CRITICAL();
+    for (ii = 0; ii < UMAC_SCAN_BSS_CACHE_MAX_ENTRIES; ii++)
+    {
+        if (data->bss_cache[ii].ssid_len == 0)
+        {
+            continue;
+        }
+
+        unsigned jj = num_entries++;
+        while (jj > 0 && mmosal_time_lt(entries[jj - 1].timestamp_ms,
+                                        data->bss_cache[ii].timestamp_ms))
+        {
+            entries[jj] = entries[jj - 1];
+            jj--;
+        }
+        entries[jj] = data->bss_cache[ii];
+    }
+    MMOSAL_TASK_EXIT_CRITICAL();
+
+    size_t len = UMAC_SCAN_BSS_CACHE_SERIALISED_HDR_LEN +
+                 num_entries * UMAC_SCAN_BSS_CACHE_SERIALISED_ENTRY_LEN;
+    if (buf == NULL)
+    {
+        return (int)len;
+    }
+
+    if (buf_size < len)
+    {
+        return -1;
+    }
+
+    uint8_t *ptr = buf;
+    *ptr++ = UMAC_SCAN_BSS_CACHE_SERIALISED_VERSION;
+    *ptr++ = (uint8_t)num_entries;
+
+    for (ii = 0; ii < num_entries; ii++)
+    {
+        const struct umac_scan_bss_cache_entry *entry = &entries[ii];
+
+        mac_addr_copy(ptr, entry->bssid);
+        ptr += MMWLAN_MAC_ADDR_LEN;
+        *ptr++ = entry->ssid_len;
+        memcpy(ptr, entry->ssid, MMWLAN_SSID_MAXLEN);
+        ptr += MMWLAN_SSID_MAXLEN;
+        UNPACK_LE32(ptr, entry->channel_freq_hz);
+        ptr += 4;
+        *ptr++ = entry->bw_mhz;
+        *ptr++ = entry->op_bw_mhz;
+        UNPACK_LE16(ptr, entry->beacon_interval);
+        ptr += 2;
+        memcpy(ptr, &entry->s1g_operation, sizeof(entry->s1g_operation));
+        ptr += sizeof(entry->s1g_operation);
+    }
+
+    MMOSAL_DEV_ASSERT((size_t)(ptr - buf) == len);
+    return (int)len;
+}
+
+bool umac_scan_bss_cache_deserialise(struct umac_data *umacd, const uint8_t *buf, size_t len)
+{
+    struct umac_scan_data *data = umac_data_get_scan(umacd);
+    struct umac_scan_bss_cache_entry entries[UMAC_SCAN_BSS_CACHE_MAX_ENTRIES];
+    uint32_t now = mmosal_get_time_ms();
+    unsigned num_entries;
+    unsigned ii;
+
+    if (len < UMAC_SCAN_BSS_CACHE_SERIALISED_HDR_LEN ||
+        buf[0] != UMAC_SCAN_BSS_CACHE_SERIALISED_VERSION)
+    {
+        return false;
+    }
+
+    num_entries = buf[1];
+    if (num_entries > UMAC_SCAN_BSS_CACHE_MAX_ENTRIES ||
+        len != UMAC_SCAN_BSS_CACHE_SERIALISED_HDR_LEN +
+                   num_entries * UMAC_SCAN_BSS_CACHE_SERIALISED_ENTRY_LEN)
+    {
+        return false;
+    }
+
+    memset(entries, 0, sizeof(entries));
+
+    const uint8_t *ptr = buf + UMAC_SCAN_BSS_CACHE_SERIALISED_HDR_LEN;
+    for (ii = 0; ii < num_entries; ii++)
+    {
+        struct umac_scan_bss_cache_entry *entry = &entries[ii];
+
+        mac_addr_copy(entry->bssid, ptr);
+        ptr += MMWLAN_MAC_ADDR_LEN;
+        entry->ssid_len = *ptr++;
+        memcpy(entry->ssid, ptr, MMWLAN_SSID_MAXLEN);
+        ptr += MMWLAN_SSID_MAXLEN;
+        PACK_LE32(entry->channel_freq_hz, ptr);
+        ptr += 4;
+        entry->bw_mhz = *ptr++;
+        entry->op_bw_mhz = *ptr++;
+        PACK_LE16(entry->beacon_interval, ptr);
+        ptr += 2;
+        memcpy(&entry->s1g_operation, ptr, sizeof(entry->s1g_operation));
+        ptr += sizeof(entry->s1g_operation);
+
+        if (entry->ssid_len == 0 || entry->ssid_len > MMWLAN_SSID_MAXLEN ||
+            entry->s1g_operation.header.element_id != DOT11_IE_S1G_OPERATION)
+        {
+            return false;
+        }
+
+
+        entry->timestamp_ms = now - ii;
+    }
+
+    MMOSAL_TASK_ENTER_CRITICAL();
+    memcpy(data->bss_cache, entries, sizeof(data->bss_cache));
+    MMOSAL_TASK_EXIT_CRITICAL();
+
+    return true;
+}
+
 void umac_scan_process_probe_resp(struct umac_data *umacd, struct mmpktview *rxbufview)
 {
     struct umac_scan_data *data = umac_data_get_scan(umacd);
@@ -240,5 +493,7 @@ void umac_scan_process_probe_resp(struct umac_data *umacd, struct mmpktview *rxb
     rsp.channel_freq_hz = rx_metadata->freq_100khz * 100 * 1000;
     rsp.noise_dbm = rx_metadata->noise_dbm;
 
+    umac_scan_bss_cache_update(data, &rsp, s1g_op);
+
     data->active_scan_req->rx_cb(umacd, &rsp);
 }
@@ -11,6 +11,7 @@
 #include "mmpkt.h"
 #include "umac/umac.h"
 #include "umac/frames/probe_response.h"
+#include "dot11/dot11_ies.h"
 
 
 struct umac_scan_response
@@ -42,6 +43,8 @@ struct umac_scan_req
 
     struct mmwlan_scan_args args;
 
+    uint32_t channel_freq_hz;
+
     umac_scan_rx_cb_t rx_cb;
 
     umac_scan_complete_cb_t complete_cb;
@@ -83,3 +86,48 @@ void umac_scan_fill_result(struct mmwlan_scan_result *res, const struct umac_sca
 enum mmwlan_status umac_scan_queue_request(struct umac_data *umacd, struct umac_scan_req *scan_req);
 
 
+#define UMAC_SCAN_BSS_CACHE_MAX_ENTRIES (4)
+
+
+struct umac_scan_bss_cache_entry
+{
+
+    uint8_t bssid[MMWLAN_MAC_ADDR_LEN];
+
+    uint8_t ssid[MMWLAN_SSID_MAXLEN];
+
+    uint8_t ssid_len;
+
+    uint8_t bw_mhz;
+
+    uint8_t op_bw_mhz;
+
+    int16_t rssi;
+
+    uint16_t beacon_interval;
+
+    uint32_t channel_freq_hz;
+
+    uint32_t timestamp_ms;
+
+    struct dot11_ie_s1g_operation s1g_operation;
+};
+
+
+bool umac_scan_bss_cache_lookup(struct umac_data *umacd,
+                                const uint8_t *ssid,
+                                size_t ssid_len,
+                                const uint8_t *bssid,
+                                struct umac_scan_bss_cache_entry *entry);
+
+
+void umac_scan_bss_cache_invalidate(struct umac_data *umacd, const uint8_t *bssid);
+
+
+void umac_scan_bss_cache_clear(struct umac_data *umacd);
+
+
+int umac_scan_bss_cache_serialise(struct umac_data *umacd, uint8_t *buf, size_t buf_size);
+
+
+bool umac_scan_bss_cache_deserialise(struct umac_data *umacd, const uint8_t *buf, size_t len);
@@ -25,5 +25,7 @@ struct umac_scan_data
 
     uint32_t prev_scan_completion_time;
 
+    struct umac_scan_bss_cache_entry bss_cache[UMAC_SCAN_BSS_CACHE_MAX_ENTRIES];
+
     struct hw_scan_data hw_scan_data;
 };
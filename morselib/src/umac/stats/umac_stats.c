@@ -23,7 +23,9 @@ void umac_stats_dump(struct umac_data *umacd)
 #else
     struct mmwlan_stats_umac_data *data = umac_data_get_stats(umacd);
     MMLOG_APP("Stats: %lu %lu %lu [ %lu %lu %lu %lu %lu %lu %lu %lu %lu %lu ] %d %u %u %u %u %u "
-              "%lu %lu %lu %u %lu %lu %lu %lu %lu %lu %lu %lu\n",
+              "%lu %lu %lu %u %lu %lu %lu %lu %lu %lu %lu %lu %lu %lu "
+              "[ %u %u %u %u ] [ %lu %lu %lu %lu ] [ %lu %lu %lu %lu ] [ %lu %lu %lu %lu ] "
+              "[ %lu %lu %lu %lu ]\n",
               data->last_tx_time,
               data->datapath_rxq_frames_dropped,
               data->datapath_txq_frames_dropped,
@@ -54,7 +56,29 @@ void umac_stats_dump(struct umac_data *umacd)
               data->datapath_rx_reorder_total,
               data->timeouts_fired,
               data->datapath_driver_tx_skbq_timeout,
-              data->datapath_driver_tx_pending_status_timeout);
+              data->datapath_driver_tx_pending_status_timeout,
+              data->ap_probe_rsp_sent,
+              data->ap_probe_rsp_suppressed,
+              data->datapath_txq_ac_high_water_mark[0],
+              data->datapath_txq_ac_high_water_mark[1],
+              data->datapath_txq_ac_high_water_mark[2],
+              data->datapath_txq_ac_high_water_mark[3],
+              data->datapath_txq_ac_dequeued[0],
+              data->datapath_txq_ac_dequeued[1],
+              data->datapath_txq_ac_dequeued[2],
+              data->datapath_txq_ac_dequeued[3],
+              data->datapath_txq_ac_sojourn_total_ms[0],
+              data->datapath_txq_ac_sojourn_total_ms[1],
+              data->datapath_txq_ac_sojourn_total_ms[2],
+              data->datapath_txq_ac_sojourn_total_ms[3],
+              data->datapath_txq_ac_sojourn_max_ms[0],
+              data->datapath_txq_ac_sojourn_max_ms[1],
+              data->datapath_txq_ac_sojourn_max_ms[2],
+              data->datapath_txq_ac_sojourn_max_ms[3],
+              data->datapath_txq_ac_aqm_drops[0],
+              data->datapath_txq_ac_aqm_drops[1],
+              data->datapath_txq_ac_aqm_drops[2],
+              data->datapath_txq_ac_aqm_drops[3]);
 #endif
 }
 
@@ -230,6 +254,48 @@ int umac_stats_serialise(struct umac_data *umacd, uint8_t *buf, size_t buf_size)
                           22,
                           (const uint8_t *)&data->datapath_driver_tx_pending_status_timeout,
                           sizeof(data->datapath_driver_tx_pending_status_timeout));
+    ok = ok && append_tlv(buf,
+                          buf_size,
+                          &offset,
+                          23,
+                          (const uint8_t *)&data->ap_probe_rsp_sent,
+                          sizeof(data->ap_probe_rsp_sent));
+    ok = ok && append_tlv(buf,
+                          buf_size,
+                          &offset,
+                          24,
+                          (const uint8_t *)&data->ap_probe_rsp_suppressed,
+                          sizeof(data->ap_probe_rsp_suppressed));
+    ok = ok && append_tlv(buf,
+                          buf_size,
+                          &offset,
+                          25,
+                          (const uint8_t *)data->datapath_txq_ac_high_water_mark,
+                          sizeof(data->datapath_txq_ac_high_water_mark));
+    ok = ok && append_tlv(buf,
+                          buf_size,
+                          &offset,
+                          26,
+                          (const uint8_t *)data->datapath_txq_ac_dequeued,
+                          sizeof(data->datapath_txq_ac_dequeued));
+    ok = ok && append_tlv(buf,
+                          buf_size,
+                          &offset,
+                          27,
+                          (const uint8_t *)data->datapath_txq_ac_sojourn_total_ms,
+                          sizeof(data->datapath_txq_ac_sojourn_total_ms));
+    ok = ok && append_tlv(buf,
+                          buf_size,
+                          &offset,
+                          28,
+                          (const uint8_t *)data->datapath_txq_ac_sojourn_max_ms,
+                          sizeof(data->datapath_txq_ac_sojourn_max_ms));
+    ok = ok && append_tlv(buf,
+                          buf_size,
+                          &offset,
+                          29,
+                          (const uint8_t *)data->datapath_txq_ac_aqm_drops,
+                          sizeof(data->datapath_txq_ac_aqm_drops));
     if (ok)
     {
         return offset;
@@ -706,3 +772,115 @@ void umac_stats_clear_datapath_driver_tx_pending_status_timeout(struct umac_data
 
     data->datapath_driver_tx_pending_status_timeout = 0;
 }
+
+void umac_stats_increment_ap_probe_rsp_sent(struct umac_data *umacd)
+{
+    struct mmwlan_stats_umac_data *data = umac_data_get_stats(umacd);
+
+    data->ap_probe_rsp_sent++;
+}
+
+uint32_t umac_stats_get_ap_probe_rsp_sent(struct umac_data *umacd)
+{
+    struct mmwlan_stats_umac_data *data = umac_data_get_stats(umacd);
+
+    return data->ap_probe_rsp_sent;
+}
+
+void umac_stats_clear_ap_probe_rsp_sent(struct umac_data *umacd)
+{
+    struct mmwlan_stats_umac_data *data = umac_data_get_stats(umacd);
+
+    data->ap_probe_rsp_sent = 0;
+}
+
+void umac_stats_increment_ap_probe_rsp_suppressed(struct umac_data *umacd)
+{
+    struct mmwlan_stats_umac_data *data = umac_data_get_stats(umacd);
+
+    data->ap_probe_rsp_suppressed++;
+}
+
+uint32_t umac_stats_get_ap_probe_rsp_suppressed(struct umac_data *umacd)
+{
+    struct mmwlan_stats_umac_data *data = umac_data_get_stats(umacd);
+
+    return data->ap_probe_rsp_suppressed;
+}
+
+void umac_stats_clear_ap_probe_rsp_suppressed(struct umac_data *umacd)
+{
+    struct mmwlan_stats_umac_data *data = umac_data_get_stats(umacd);
+
+    data->ap_probe_rsp_suppressed = 0;
+}
+
+void umac_stats_update_datapath_txq_ac_high_water_mark(struct umac_data *umacd,
+                                                       uint32_t idx,
+                                                       uint32_t datapath_txq_ac)
+{
+    struct mmwlan_stats_umac_data *data = umac_data_get_stats(umacd);
+
+    MMOSAL_ASSERT(idx < MMWLAN_STATS_TXQ_AC_N_ENTRIES);
+
+    if (datapath_txq_ac > UINT16_MAX)
+    {
+        datapath_txq_ac = UINT16_MAX;
+    }
+    if (datapath_txq_ac > data->datapath_txq_ac_high_water_mark[idx])
+    {
+        data->datapath_txq_ac_high_water_mark[idx] = datapath_txq_ac;
+    }
+}
+
+void umac_stats_clear_datapath_txq_ac_high_water_marks(struct umac_data *umacd)
+{
+    struct mmwlan_stats_umac_data *data = umac_data_get_stats(umacd);
+
+    memset(data->datapath_txq_ac_high_water_mark,
+           0,
+           sizeof(data->datapath_txq_ac_high_water_mark));
+}
+
+void umac_stats_update_datapath_txq_ac_sojourn(struct umac_data *umacd,
+                                               uint32_t idx,
+                                               uint32_t sojourn_ms)
+{
+    struct mmwlan_stats_umac_data *data = umac_data_get_stats(umacd);
+
+    MMOSAL_ASSERT(idx < MMWLAN_STATS_TXQ_AC_N_ENTRIES);
+
+    data->datapath_txq_ac_dequeued[idx]++;
+    data->datapath_txq_ac_sojourn_total_ms[idx] += sojourn_ms;
+    if (sojourn_ms > data->datapath_txq_ac_sojourn_max_ms[idx])
+    {
+        data->datapath_txq_ac_sojourn_max_ms[idx] = sojourn_ms;
+    }
+}
+
+void umac_stats_clear_datapath_txq_ac_sojourn(struct umac_data *umacd)
+{
+    struct mmwlan_stats_umac_data *data = umac_data_get_stats(umacd);
+
+    memset(data->datapath_txq_ac_dequeued, 0, sizeof(data->datapath_txq_ac_dequeued));
+    memset(data->datapath_txq_ac_sojourn_total_ms,
+           0,
+           sizeof(data->datapath_txq_ac_sojourn_total_ms));
+    memset(data->datapath_txq_ac_sojourn_max_ms, 0, sizeof(data->datapath_txq_ac_sojourn_max_ms));
+}
+
+void umac_stats_increment_datapath_txq_ac_aqm_drops(struct umac_data *umacd, uint32_t idx)
+{
+    struct mmwlan_stats_umac_data *data = umac_data_get_stats(umacd);
+
+    MMOSAL_ASSERT(idx < MMWLAN_STATS_TXQ_AC_N_ENTRIES);
+
+    data->datapath_txq_ac_aqm_drops[idx]++;
+}
+
+void umac_stats_clear_datapath_txq_ac_aqm_drops(struct umac_data *umacd)
+{
+    struct mmwlan_stats_umac_data *data = umac_data_get_stats(umacd);
+
+    memset(data->datapath_txq_ac_aqm_drops, 0, sizeof(data->datapath_txq_ac_aqm_drops));
+}
@@ -225,3 +225,42 @@ uint32_t umac_stats_get_datapath_driver_tx_pending_status_timeout(struct umac_da
 
 void umac_stats_clear_datapath_driver_tx_pending_status_timeout(struct umac_data *umacd);
 
+
+void umac_stats_increment_ap_probe_rsp_sent(struct umac_data *umacd);
+
+
+uint32_t umac_stats_get_ap_probe_rsp_sent(struct umac_data *umacd);
+
+
+void umac_stats_clear_ap_probe_rsp_sent(struct umac_data *umacd);
+
+
+void umac_stats_increment_ap_probe_rsp_suppressed(struct umac_data *umacd);
+
+
+uint32_t umac_stats_get_ap_probe_rsp_suppressed(struct umac_data *umacd);
+
+
+void umac_stats_clear_ap_probe_rsp_suppressed(struct umac_data *umacd);
+
+
+void umac_stats_update_datapath_txq_ac_high_water_mark(struct umac_data *umacd,
+                                                       uint32_t idx,
+                                                       uint32_t datapath_txq_ac);
+
+
+void umac_stats_clear_datapath_txq_ac_high_water_marks(struct umac_data *umacd);
+
+
+void umac_stats_update_datapath_txq_ac_sojourn(struct umac_data *umacd,
+                                               uint32_t idx,
+                                               uint32_t sojourn_ms);
+
+
+void umac_stats_clear_datapath_txq_ac_sojourn(struct umac_data *umacd);
+
+
+void umac_stats_increment_datapath_txq_ac_aqm_drops(struct umac_data *umacd, uint32_t idx);
+
+
+void umac_stats_clear_datapath_txq_ac_aqm_drops(struct umac_data *umacd);
@@ -444,12 +444,83 @@ static bool mmwpas_bss_cache_lookup(struct umac_supp_shim_data *data,
     return false;
 }
 
+static void mmwpas_select_targeted_scan(struct umac_data *umacd, struct umac_supp_shim_data *data)
+{
+    const struct mmwlan_sta_args *sta_args = umac_connection_get_sta_args(umacd);
+    struct umac_scan_bss_cache_entry entry;
+
+    data->scan_req.channel_freq_hz = 0;
+    data->targeted_scan = false;
+
+    if (sta_args == NULL || umac_connection_get_state(umacd) == MMWLAN_STA_CONNECTED)
+    {
+        return;
+    }
+
+    if (!umac_scan_bss_cache_lookup(umacd,
+                                    sta_args->ssid,
+                                    sta_args->ssid_len,
+                                    sta_args->bssid,
+                                    &entry))
+    {
+        return;
+    }
+
+    MMLOG_INF("Targeted scan for cached BSS " MM_MAC_ADDR_FMT " (%lu kHz)\n",
+              MM_MAC_ADDR_VAL(entry.bssid),
+              HZ_TO_KHZ(entry.channel_freq_hz));
+
+    data->scan_req.channel_freq_hz = entry.channel_freq_hz;
+    data->targeted_scan = true;
+    mac_addr_copy(data->targeted_scan_bssid, entry.bssid);
+}
+
+
+static bool mmwpas_targeted_scan_fallback(struct umac_data *umacd,
+                                          struct umac_supp_shim_data *data,
+                                          enum mmwlan_scan_state result_code)
+{
+    unsigned ii;
+
+    if (!data->targeted_scan)
+    {
+        return false;
+    }
+
+    data->targeted_scan = false;
+    data->scan_req.channel_freq_hz = 0;
+
+    if (result_code != MMWLAN_SCAN_SUCCESSFUL)
+    {
+        return false;
+    }
+
+    for (ii = 0; ii < data->in_progress_scan_results->num; ii++)
+    {
+        if (mm_mac_addr_is_equal(data->in_progress_scan_results->res[ii]->bssid,
+                                 data->targeted_scan_bssid))
+        {
+            return false;
+        }
+    }
+
+    MMLOG_INF("Cached BSS not found, falling back to full scan\n");
+    umac_scan_bss_cache_invalidate(umacd, data->targeted_scan_bssid);
+
+    return umac_scan_queue_request(umacd, &data->scan_req) == MMWLAN_SUCCESS;
+}
+
 static void mmwpas_scan_complete_handler(struct umac_data *umacd,
                                          enum mmwlan_scan_state result_code)
 {
-    MM_UNUSED(result_code);
     struct umac_supp_shim_data *data = umac_data_get_supp_shim(umacd);
     MMOSAL_ASSERT(data->in_progress_scan_results != NULL);
+
+    if (mmwpas_targeted_scan_fallback(umacd, data, result_code))
+    {
+        return;
+    }
+
     data->completed_scan_results = data->in_progress_scan_results;
     data->in_progress_scan_results = NULL;
     mmwpas_clean_up_scan_data(data);
@@ -482,6 +553,7 @@ static void mmwpas_scan_complete_handler(struct umac_data *umacd,
     umac_connection_signal_sta_event(umacd, MMWLAN_STA_EVT_SCAN_COMPLETE);
 }
 
+
 static int mmwpas_initialise_scan_data(struct umac_data *umacd,
                                        struct umac_supp_shim_data *data,
                                        struct wpa_driver_scan_params *params)
@@ -532,6 +604,8 @@ static int mmwpas_initialise_scan_data(struct umac_data *umacd,
     args->dwell_time_ms = umac_config_get_supp_scan_dwell_time(umacd);
     dwell_on_home = umac_connection_get_state(umacd) == MMWLAN_STA_CONNECTED &&
                     !data->sta_wpa_s->reassociate;
+
+    mmwpas_select_targeted_scan(umacd, data);
     args->dwell_on_home_ms = dwell_on_home ? umac_config_get_supp_scan_home_dwell_time(umacd) : 0;
 
     if (params->extra_ies_len)
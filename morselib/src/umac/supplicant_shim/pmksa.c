@@ -0,0 +1,535 @@
+/*
+ * Copyright 2025 Morse Micro
+ * SPDX-License-Identifier: GPL-3.0-or-later OR LicenseRef-MorseMicroCommercial
+ */
+
+#include "mmlog.h"
+#include "mmosal.h"
+#include "mmutils.h"
+#include "umac_supp_shim_private.h"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#pragma GCC diagnostic ignored "-Wc++-compat"
+#pragma GCC diagnostic ignored "-Wcast-qual"
+#include "hostap/src/common/sae.h"
+#include "hostap/src/rsn_supp/wpa.h"
+#include "hostap/src/rsn_supp/pmksa_cache.h"
+#pragma GCC diagnostic pop
+
+
+#define PMKSA_BLOB_VERSION (1)
+
+#define PMKSA_BLOB_HDR_LEN (4 + SHA256_MAC_LEN)
+
+#define PMKSA_BLOB_PMKSA_FIXED_LEN (ETH_ALEN + PMKID_LEN + 4 + 4 + 1)
+
+#define PMKSA_BLOB_PT_FIXED_LEN (2 + 2)
+
+#define PMKSA_BLOB_MAX_PT_POINT_LEN (2 * 66)
+
+
+#define PMKSA_BLOB_LIFETIME_GRANULARITY_S (3600)
+
+
+struct pmksa_blob_pmksa
+{
+    const uint8_t *aa;
+    const uint8_t *pmkid;
+    uint32_t akmp;
+    uint8_t *lifetime;
+    const uint8_t *pmk;
+    uint8_t pmk_len;
+};
+
+struct pmksa_blob_pt
+{
+    uint16_t group;
+    const uint8_t *point;
+    uint16_t point_len;
+};
+
+
+static bool pmksa_blob_next_pmksa(uint8_t **pos, const uint8_t *end, struct pmksa_blob_pmksa *out)
+{
+    uint8_t *ptr = *pos;
+
+    if (end - ptr < PMKSA_BLOB_PMKSA_FIXED_LEN)
+    {
+        return false;
+    }
+
+    out->aa = ptr;
+    ptr += ETH_ALEN;
+    out->pmkid = ptr;
+    ptr += PMKID_LEN;
+    PACK_LE32(out->akmp, ptr);
+    ptr += 4;
+    out->lifetime = ptr;
+    ptr += 4;
+    out->pmk_len = *ptr++;
+    if (out->pmk_len == 0 || out->pmk_len > PMK_LEN_MAX || end - ptr < out->pmk_len)
+    {
+        return false;
+    }
+    out->pmk = ptr;
+    ptr += out->pmk_len;
+
+    *pos = ptr;
+    return true;
+}
+
+static bool pmksa_blob_next_pt(uint8_t **pos, const uint8_t *end, struct pmksa_blob_pt *out)
+{
+    uint8_t *ptr = *pos;
+
+    if (end - ptr < PMKSA_BLOB_PT_FIXED_LEN)
+    {
+        return false;
+    }
+
+    PACK_LE16(out->group, ptr);
+    ptr += 2;
+    PACK_LE16(out->point_len, ptr);
+    ptr += 2;
+    if (out->point_len == 0 || out->point_len > PMKSA_BLOB_MAX_PT_POINT_LEN ||
+        end - ptr < out->point_len)
+    {
+        return false;
+    }
+    out->point = ptr;
+    ptr += out->point_len;
+
+    *pos = ptr;
+    return true;
+}
+
+
+static bool pmksa_blob_walk(uint8_t *buf, size_t len, uint32_t elapsed_s)
+{
+    uint8_t *pos = buf + PMKSA_BLOB_HDR_LEN;
+    const uint8_t *end = buf + len;
+    unsigned ii;
+
+    if (len < PMKSA_BLOB_HDR_LEN || buf[0] != PMKSA_BLOB_VERSION)
+    {
+        return false;
+    }
+
+    for (ii = 0; ii < buf[1]; ii++)
+    {
+        struct pmksa_blob_pmksa entry;
+        uint32_t lifetime;
+
+        if (!pmksa_blob_next_pmksa(&pos, end, &entry))
+        {
+            return false;
+        }
+
+        PACK_LE32(lifetime, entry.lifetime);
+        lifetime = (lifetime > elapsed_s) ? lifetime - elapsed_s : 0;
+        UNPACK_LE32(entry.lifetime, lifetime);
+    }
+
+    for (ii = 0; ii < buf[2]; ii++)
+    {
+        struct pmksa_blob_pt pt;
+
+        if (!pmksa_blob_next_pt(&pos, end, &pt))
+        {
+            return false;
+        }
+    }
+
+    return pos == end;
+}
+
+static bool pmksa_cred_hash(const struct wpa_ssid *ssid, uint8_t *hash)
+{
+    const char *password = ssid->sae_password ? ssid->sae_password : ssid->passphrase;
+    const uint8_t *addr[2];
+    size_t len[2];
+
+    if (password == NULL)
+    {
+        return false;
+    }
+
+    addr[0] = ssid->ssid;
+    len[0] = ssid->ssid_len;
+    addr[1] = (const uint8_t *)password;
+    len[1] = os_strlen(password);
+
+    return sha256_vector(2, addr, len, hash) == 0;
+}
+
+static void pmksa_blob_set(struct umac_supp_shim_data *data, uint8_t *blob, size_t len)
+{
+    struct os_reltime now;
+
+    if (data->pmksa_blob != NULL)
+    {
+        forced_memzero(data->pmksa_blob, data->pmksa_blob_len);
+        os_free(data->pmksa_blob);
+    }
+
+    os_get_reltime(&now);
+    data->pmksa_blob = blob;
+    data->pmksa_blob_len = len;
+    data->pmksa_blob_time = now.sec;
+}
+
+static uint32_t pmksa_blob_age(struct umac_supp_shim_data *data)
+{
+    struct os_reltime now;
+
+    os_get_reltime(&now);
+    return (uint32_t)(now.sec - data->pmksa_blob_time);
+}
+
+void umac_supp_pmksa_snapshot(struct umac_data *umacd)
+{
+    struct umac_supp_shim_data *data = umac_data_get_supp_shim(umacd);
+    struct wpa_supplicant *wpa_s = data->sta_wpa_s;
+    struct rsn_pmksa_cache_entry *entry;
+    struct os_reltime now;
+    uint8_t cred_hash[SHA256_MAC_LEN];
+    unsigned num_pmksa = 0;
+    unsigned num_pt = 0;
+    size_t len = PMKSA_BLOB_HDR_LEN;
+
+    if (wpa_s == NULL || wpa_s->conf == NULL || wpa_s->conf->ssid == NULL ||
+        !pmksa_cred_hash(wpa_s->conf->ssid, cred_hash))
+    {
+        return;
+    }
+
+    os_get_reltime(&now);
+
+    for (entry = wpa_sm_pmksa_cache_head(wpa_s->wpa); entry != NULL; entry = entry->next)
+    {
+        if (entry->network_ctx == wpa_s->conf->ssid && entry->expiration > now.sec &&
+            num_pmksa < UINT8_MAX)
+        {
+            len += PMKSA_BLOB_PMKSA_FIXED_LEN + entry->pmk_len;
+            num_pmksa++;
+        }
+    }
+
+#ifdef CONFIG_SAE
+    const struct sae_pt *pt;
+    for (pt = wpa_s->conf->ssid->pt; pt != NULL; pt = pt->next)
+    {
+        if (pt->ec != NULL && pt->ecc_pt != NULL && pt->password_id == NULL)
+        {
+            len += PMKSA_BLOB_PT_FIXED_LEN + 2 * crypto_ec_prime_len(pt->ec);
+            num_pt++;
+        }
+    }
+#endif
+
+    if (num_pmksa == 0 && num_pt == 0)
+    {
+
+        return;
+    }
+
+    uint8_t *blob = (uint8_t *)os_malloc(len);
+    if (blob == NULL)
+    {
+        MMLOG_WRN("Failed to allocate PMKSA snapshot\n");
+        return;
+    }
+
+    uint8_t *ptr = blob;
+    *ptr++ = PMKSA_BLOB_VERSION;
+    *ptr++ = (uint8_t)num_pmksa;
+    *ptr++ = (uint8_t)num_pt;
+    *ptr++ = 0;
+    memcpy(ptr, cred_hash, SHA256_MAC_LEN);
+    ptr += SHA256_MAC_LEN;
+
+    unsigned ii = 0;
+    for (entry = wpa_sm_pmksa_cache_head(wpa_s->wpa); entry != NULL && ii < num_pmksa;
+         entry = entry->next)
+    {
+        if (entry->network_ctx != wpa_s->conf->ssid || entry->expiration <= now.sec)
+        {
+            continue;
+        }
+
+        uint32_t lifetime = (uint32_t)(entry->expiration - now.sec);
+        lifetime += PMKSA_BLOB_LIFETIME_GRANULARITY_S - 1;
+        lifetime -= lifetime % PMKSA_BLOB_LIFETIME_GRANULARITY_S;
+
+        memcpy(ptr, entry->aa, ETH_ALEN);
+        ptr += ETH_ALEN;
+        memcpy(ptr, entry->pmkid, PMKID_LEN);
+        ptr += PMKID_LEN;
+        UNPACK_LE32(ptr, (uint32_t)entry->akmp);
+        ptr += 4;
+        UNPACK_LE32(ptr, lifetime);
+        ptr += 4;
+        *ptr++ = (uint8_t)entry->pmk_len;
+        memcpy(ptr, entry->pmk, entry->pmk_len);
+        ptr += entry->pmk_len;
+        ii++;
+    }
+
+#ifdef CONFIG_SAE
+    for (pt = wpa_s->conf->ssid->pt; pt != NULL; pt = pt->next)
+    {
+        if (pt->ec == NULL || pt->ecc_pt == NULL || pt->password_id != NULL)
+        {
+            continue;
+        }
+
+        size_t prime_len = crypto_ec_prime_len(pt->ec);
+        uint16_t point_len = (uint16_t)(2 * prime_len);
+
+        UNPACK_LE16(ptr, (uint16_t)pt->group);
+        ptr += 2;
+        UNPACK_LE16(ptr, point_len);
+        ptr += 2;
+        if (crypto_ec_point_to_bin(pt->ec, pt->ecc_pt, ptr, ptr + prime_len) != 0)
+        {
+            MMLOG_WRN("Failed to serialise SAE PT\n");
+            forced_memzero(blob, len);
+            os_free(blob);
+            return;
+        }
+        ptr += point_len;
+    }
+#endif
+
+    MMOSAL_DEV_ASSERT((size_t)(ptr - blob) == len);
+    pmksa_blob_set(data, blob, len);
+
+    MMLOG_DBG("Captured %u PMKSA and %u PT entries\n", num_pmksa, num_pt);
+}
+
+#ifdef CONFIG_SAE
+
+static bool pmksa_restore_pt(struct wpa_supplicant *wpa_s, uint8_t *buf, size_t len)
+{
+    struct wpa_ssid *ssid = wpa_s->conf->ssid;
+    struct sae_pt *head = NULL;
+    struct sae_pt *last = NULL;
+    uint8_t *pos = buf + PMKSA_BLOB_HDR_LEN;
+    const uint8_t *end = buf + len;
+    unsigned ii;
+
+    if (ssid->pt != NULL || ssid->sae_password_id != NULL || buf[2] == 0)
+    {
+        return false;
+    }
+
+    for (ii = 0; ii < buf[1]; ii++)
+    {
+        struct pmksa_blob_pmksa entry;
+        (void)pmksa_blob_next_pmksa(&pos, end, &entry);
+    }
+
+    for (ii = 0; ii < buf[2]; ii++)
+    {
+        struct pmksa_blob_pt blob_pt;
+        struct sae_pt *pt;
+
+        (void)pmksa_blob_next_pt(&pos, end, &blob_pt);
+
+        pt = (struct sae_pt *)os_zalloc(sizeof(*pt));
+        if (pt == NULL)
+        {
+            goto fail;
+        }
+
+        pt->group = blob_pt.group;
+        pt->ec = crypto_ec_init(pt->group);
+        if (pt->ec == NULL || blob_pt.point_len != 2 * crypto_ec_prime_len(pt->ec))
+        {
+            sae_deinit_pt(pt);
+            goto fail;
+        }
+
+        pt->ecc_pt = crypto_ec_point_from_bin(pt->ec, blob_pt.point);
+        if (pt->ecc_pt == NULL || !crypto_ec_point_is_on_curve(pt->ec, pt->ecc_pt))
+        {
+            sae_deinit_pt(pt);
+            goto fail;
+        }
+
+        if (last != NULL)
+        {
+            last->next = pt;
+        }
+        else
+        {
+            head = pt;
+        }
+        last = pt;
+    }
+
+
+    const int default_groups[] = { 19, 20, 21, 0 };
+    const int *groups = wpa_s->conf->sae_groups;
+    if (groups == NULL || groups[0] <= 0)
+    {
+        groups = default_groups;
+    }
+
+    for (ii = 0; groups[ii] > 0; ii++)
+    {
+        const struct sae_pt *pt;
+        for (pt = head; pt != NULL && pt->group != groups[ii]; pt = pt->next)
+        {
+        }
+
+        if (pt == NULL)
+        {
+            goto fail;
+        }
+    }
+
+    ssid->pt = head;
+    return true;
+
+fail:
+    sae_deinit_pt(head);
+    return false;
+}
+
+#endif
+
+void umac_supp_pmksa_restore(struct umac_data *umacd)
+{
+    struct umac_supp_shim_data *data = umac_data_get_supp_shim(umacd);
+    struct wpa_supplicant *wpa_s = data->sta_wpa_s;
+    uint8_t cred_hash[SHA256_MAC_LEN];
+    struct os_reltime now;
+    unsigned num_pmksa = 0;
+    unsigned ii;
+
+    if (data->pmksa_blob == NULL || wpa_s == NULL || wpa_s->conf == NULL ||
+        wpa_s->conf->ssid == NULL)
+    {
+        return;
+    }
+
+
+    if (!pmksa_blob_walk(data->pmksa_blob, data->pmksa_blob_len, pmksa_blob_age(data)))
+    {
+        pmksa_blob_set(data, NULL, 0);
+        return;
+    }
+    os_get_reltime(&now);
+    data->pmksa_blob_time = now.sec;
+
+    if (!pmksa_cred_hash(wpa_s->conf->ssid, cred_hash) ||
+        memcmp(cred_hash, data->pmksa_blob + 4, SHA256_MAC_LEN) != 0)
+    {
+        MMLOG_DBG("Stored PMKSA does not match current network\n");
+        return;
+    }
+
+    uint8_t *pos = data->pmksa_blob + PMKSA_BLOB_HDR_LEN;
+    const uint8_t *end = data->pmksa_blob + data->pmksa_blob_len;
+    for (ii = 0; ii < data->pmksa_blob[1]; ii++)
+    {
+        struct pmksa_blob_pmksa blob_entry;
+        struct rsn_pmksa_cache_entry *entry;
+        uint32_t lifetime;
+
+        (void)pmksa_blob_next_pmksa(&pos, end, &blob_entry);
+        PACK_LE32(lifetime, blob_entry.lifetime);
+        if (lifetime == 0)
+        {
+            continue;
+        }
+
+        entry = (struct rsn_pmksa_cache_entry *)os_zalloc(sizeof(*entry));
+        if (entry == NULL)
+        {
+            break;
+        }
+
+        memcpy(entry->pmk, blob_entry.pmk, blob_entry.pmk_len);
+        entry->pmk_len = blob_entry.pmk_len;
+        memcpy(entry->pmkid, blob_entry.pmkid, PMKID_LEN);
+        memcpy(entry->aa, blob_entry.aa, ETH_ALEN);
+        memcpy(entry->spa, wpa_s->own_addr, ETH_ALEN);
+        entry->akmp = (int)blob_entry.akmp;
+        entry->expiration = now.sec + lifetime;
+        entry->reauth_time = now.sec + lifetime * 70 / 100;
+        entry->network_ctx = wpa_s->conf->ssid;
+
+        if (wpa_sm_pmksa_cache_add_entry(wpa_s->wpa, entry) != NULL)
+        {
+            num_pmksa++;
+        }
+    }
+
+    bool pt_restored = false;
+#ifdef CONFIG_SAE
+    pt_restored = pmksa_restore_pt(wpa_s, data->pmksa_blob, data->pmksa_blob_len);
+#endif
+
+    MMLOG_INF("Restored %u PMKSA entries%s\n", num_pmksa, pt_restored ? " and SAE PT" : "");
+}
+
+enum mmwlan_status umac_supp_pmksa_save(struct umac_data *umacd, uint8_t *buf, size_t *len)
+{
+    struct umac_supp_shim_data *data = umac_data_get_supp_shim(umacd);
+
+    umac_supp_pmksa_snapshot(umacd);
+
+    if (data->pmksa_blob == NULL)
+    {
+        *len = 0;
+        return MMWLAN_NOT_FOUND;
+    }
+
+    if (buf == NULL || *len < data->pmksa_blob_len)
+    {
+        *len = data->pmksa_blob_len;
+        return MMWLAN_NO_MEM;
+    }
+
+    memcpy(buf, data->pmksa_blob, data->pmksa_blob_len);
+    *len = data->pmksa_blob_len;
+
+    return MMWLAN_SUCCESS;
+}
+
+enum mmwlan_status umac_supp_pmksa_load(struct umac_data *umacd, const uint8_t *buf, size_t len)
+{
+    struct umac_supp_shim_data *data = umac_data_get_supp_shim(umacd);
+    uint8_t *blob = NULL;
+
+    if (buf != NULL && len != 0)
+    {
+        blob = (uint8_t *)os_malloc(len);
+        if (blob == NULL)
+        {
+            return MMWLAN_NO_MEM;
+        }
+
+        memcpy(blob, buf, len);
+        if (!pmksa_blob_walk(blob, len, 0))
+        {
+            os_free(blob);
+            return MMWLAN_INVALID_ARGUMENT;
+        }
+    }
+
+    pmksa_blob_set(data, blob, blob != NULL ? len : 0);
+    umac_supp_pmksa_restore(umacd);
+
+    return MMWLAN_SUCCESS;
+}
+
+void umac_supp_pmksa_deinit(struct umac_data *umacd)
+{
+    struct umac_supp_shim_data *data = umac_data_get_supp_shim(umacd);
+
+    pmksa_blob_set(data, NULL, 0);
+}
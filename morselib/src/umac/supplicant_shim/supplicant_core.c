@@ -82,11 +82,13 @@ enum mmwlan_status umac_supp_add_sta_interface(struct umac_data *umacd, const ch
         os_free(data->sta_wpa_s->confname);
         data->sta_wpa_s->confname = os_strdup(confname);
 
+        umac_supp_pmksa_snapshot(umacd);
         if (wpa_supplicant_reload_configuration(data->sta_wpa_s))
         {
             MMLOG_WRN("WPAS: config reload failed\n");
             return MMWLAN_ERROR;
         }
+        umac_supp_pmksa_restore(umacd);
         return MMWLAN_SUCCESS;
     }
 
@@ -114,6 +116,7 @@ enum mmwlan_status umac_supp_add_sta_interface(struct umac_data *umacd, const ch
     }
 
     data->sta_wpa_s->auto_reconnect_disabled = data->auto_reconnect_disabled;
+    umac_supp_pmksa_restore(umacd);
 
     return MMWLAN_SUCCESS;
 }
@@ -134,6 +137,7 @@ enum mmwlan_status umac_supp_remove_sta_interface(struct umac_data *umacd)
         return MMWLAN_NOT_FOUND;
     }
 
+    umac_supp_pmksa_snapshot(umacd);
     int ret = wpa_supplicant_remove_iface(data->global, data->sta_wpa_s, 0);
     data->sta_wpa_s = NULL;
 
@@ -223,6 +227,7 @@ void umac_supp_deinit(struct umac_data *umacd)
     struct umac_supp_shim_data *data = umac_data_get_supp_shim(umacd);
     if (data->global)
     {
+        umac_supp_pmksa_snapshot(umacd);
         wpa_supplicant_deinit(data->global);
     }
     data->sta_wpa_s = NULL;
@@ -52,6 +52,15 @@ void umac_supp_disconnect(struct umac_data *umacd);
 void umac_supp_deinit(struct umac_data *umacd);
 
 
+enum mmwlan_status umac_supp_pmksa_save(struct umac_data *umacd, uint8_t *buf, size_t *len);
+
+
+enum mmwlan_status umac_supp_pmksa_load(struct umac_data *umacd, const uint8_t *buf, size_t len);
+
+
+void umac_supp_pmksa_deinit(struct umac_data *umacd);
+
+
 void umac_supp_set_auto_reconnect_disabled(struct umac_data *umacd, bool auto_reconnect_disabled);
 
 
@@ -86,6 +86,10 @@ struct umac_supp_shim_data
 
     struct umac_scan_req scan_req;
 
+    bool targeted_scan;
+
+    uint8_t targeted_scan_bssid[MMWLAN_MAC_ADDR_LEN];
+
     uint16_t max_scan_results;
 
     struct wpa_scan_results *in_progress_scan_results;
@@ -104,4 +108,10 @@ struct umac_supp_shim_data
 #pragma GCC diagnostic pop
 
     uint8_t num_filter_ssids;
+
+    uint8_t *pmksa_blob;
+
+    size_t pmksa_blob_len;
+
+    os_time_t pmksa_blob_time;
 };
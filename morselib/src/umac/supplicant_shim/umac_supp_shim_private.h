@@ -72,3 +72,9 @@ enum mmwlan_status umac_supp_start_supp(struct umac_data *umacd);
 
 
 void umac_supp_event(void *ctx, enum wpa_event_type event, union wpa_event_data *data);
+
+
+void umac_supp_pmksa_snapshot(struct umac_data *umacd);
+
+
+void umac_supp_pmksa_restore(struct umac_data *umacd);
@@ -75,6 +75,7 @@ void mmwlan_deinit(void)
     struct umac_data *umacd = umac_data_get_umacd();
     umac_scan_deinit(umacd);
     umac_supp_deinit(umacd);
+    umac_supp_pmksa_deinit(umacd);
     umac_datapath_deinit(umacd);
     umac_connection_deinit(umacd);
     umac_health_check_deinit(umacd);
@@ -310,6 +311,43 @@ enum mmwlan_status mmwlan_set_ampdu_enabled(bool ampdu_enabled)
     return MMWLAN_SUCCESS;
 }
 
+enum mmwlan_status mmwlan_set_amsdu_enabled(bool amsdu_enabled)
+{
+    struct umac_data *umacd = umac_data_get_umacd();
+
+    if (!umac_data_is_initialised(umacd))
+    {
+        return MMWLAN_NOT_INITIALIZED;
+    }
+
+    if (umac_connection_get_state(umacd) != MMWLAN_STA_DISABLED)
+    {
+        return MMWLAN_UNAVAILABLE;
+    }
+
+    umac_config_set_amsdu_enabled(umacd, amsdu_enabled);
+    return MMWLAN_SUCCESS;
+}
+
+enum mmwlan_status mmwlan_set_amsdu_limits(uint16_t max_len, uint8_t max_subframes)
+{
+    struct umac_data *umacd = umac_data_get_umacd();
+
+    if (!umac_data_is_initialised(umacd))
+    {
+        return MMWLAN_NOT_INITIALIZED;
+    }
+
+    if (max_len < MMWLAN_AMSDU_MIN_MAX_LEN || max_len > MMWLAN_AMSDU_MAX_MAX_LEN ||
+        max_subframes == 0)
+    {
+        return MMWLAN_INVALID_ARGUMENT;
+    }
+
+    umac_config_set_amsdu_limits(umacd, max_len, max_subframes);
+    return MMWLAN_SUCCESS;
+}
+
 enum mmwlan_status mmwlan_set_non_tim_mode_enabled(bool non_tim_mode_enabled)
 {
     struct umac_data *umacd = umac_data_get_umacd();
@@ -409,6 +447,46 @@ enum mmwlan_status mmwlan_set_default_qos_queue_params(const struct mmwlan_qos_q
     return MMWLAN_SUCCESS;
 }
 
+enum mmwlan_status mmwlan_set_txq_params(const struct mmwlan_txq_params *params)
+{
+    struct umac_data *umacd = umac_data_get_umacd();
+
+    if (!umac_data_is_initialised(umacd))
+    {
+        return MMWLAN_NOT_INITIALIZED;
+    }
+
+    if (params == NULL)
+    {
+        return MMWLAN_INVALID_ARGUMENT;
+    }
+
+    if (params->service_mode != MMWLAN_TXQ_SERVICE_WEIGHTED &&
+        params->service_mode != MMWLAN_TXQ_SERVICE_STRICT)
+    {
+        return MMWLAN_INVALID_ARGUMENT;
+    }
+
+    for (unsigned ii = 0; ii < MM_ARRAY_COUNT(params->weights); ii++)
+    {
+        if (params->weights[ii] == 0)
+        {
+            MMLOG_ERR("Invalid weight for ACI %u\n", ii);
+            return MMWLAN_INVALID_ARGUMENT;
+        }
+    }
+
+    if (params->codel_target_ms != 0 && params->codel_interval_ms <= params->codel_target_ms)
+    {
+        return MMWLAN_INVALID_ARGUMENT;
+    }
+
+    MMOSAL_TASK_ENTER_CRITICAL();
+    umac_config_set_txq_params(umacd, params);
+    MMOSAL_TASK_EXIT_CRITICAL();
+    return MMWLAN_SUCCESS;
+}
+
 static void umac_interface_add_evt_handler(struct umac_data *umacd, const struct umac_evt *evt)
 {
     MMOSAL_DEV_ASSERT(evt->args.interface_add.type == UMAC_INTERFACE_NONE);
@@ -891,6 +969,7 @@ enum mmwlan_status mmwlan_scan_request(const struct mmwlan_scan_req *scan_req)
         memset(data->scan_request.args.ssid, 0, MMWLAN_SSID_MAXLEN);
     }
     data->scan_request.args.dwell_time_ms = scan_req->args.dwell_time_ms;
+    data->scan_request.channel_freq_hz = 0;
     data->scan_request.args.dwell_on_home_ms =
         umac_connection_get_state(umacd) == MMWLAN_STA_CONNECTED ? scan_req->args.dwell_on_home_ms :
                                                                    0;
@@ -1208,41 +1287,42 @@ enum mmwlan_status mmwlan_register_rx_pkt_ext_cb(enum mmwlan_vif vif,
     return umac_datapath_register_rx_pkt_ext_cb(umacd, vif, callback, arg);
 }
 
-enum mmwlan_status mmwlan_tx_pkt(struct mmpkt *pkt, const struct mmwlan_tx_metadata *_metadata)
+enum mmwlan_status mmwlan_register_rx_pkt_batch_cb(enum mmwlan_vif vif,
+                                                   mmwlan_rx_pkt_batch_cb_t callback,
+                                                   void *arg)
 {
     struct umac_data *umacd = umac_data_get_umacd();
-    MMLOG_VRB("TX packet\n");
-
-    struct mmwlan_tx_metadata metadata = MMWLAN_TX_METADATA_INIT;
-    if (_metadata != NULL)
-    {
-        metadata = *_metadata;
-    }
+    return umac_datapath_register_rx_pkt_batch_cb(umacd, vif, callback, arg);
+}
 
-    if (metadata.tid > MMWLAN_MAX_QOS_TID)
+static enum mmwlan_status umac_tx_pkt_prepare(struct umac_data *umacd,
+                                              struct mmpkt *pkt,
+                                              struct mmwlan_tx_metadata *metadata)
+{
+    if (metadata->tid > MMWLAN_MAX_QOS_TID)
     {
-        MMLOG_DBG("Given TID (%d) is out of range, max %d.\n", metadata.tid, MMWLAN_MAX_QOS_TID);
+        MMLOG_DBG("Given TID (%d) is out of range, max %d.\n", metadata->tid, MMWLAN_MAX_QOS_TID);
         mmpkt_release(pkt);
         return MMWLAN_INVALID_ARGUMENT;
     }
 
     UMAC_TRACE("tx %x", pkt);
 
-    mmdrv_get_tx_metadata(pkt)->tid = metadata.tid;
+    mmdrv_get_tx_metadata(pkt)->tid = metadata->tid;
 
-    umac_relay_update_tx_metadata(umacd, pkt, &metadata);
+    umac_relay_update_tx_metadata(umacd, pkt, metadata);
 
     uint16_t vif_id = MMDRV_VIF_ID_INVALID;
 
-    if (metadata.vif == MMWLAN_VIF_STA)
+    if (metadata->vif == MMWLAN_VIF_STA)
     {
         vif_id = umac_interface_get_vif_id(umacd, UMAC_INTERFACE_STA);
     }
-    else if (metadata.vif == MMWLAN_VIF_AP)
+    else if (metadata->vif == MMWLAN_VIF_AP)
     {
         vif_id = umac_interface_get_vif_id(umacd, UMAC_INTERFACE_AP);
     }
-    else if (metadata.vif == MMWLAN_VIF_UNSPECIFIED)
+    else if (metadata->vif == MMWLAN_VIF_UNSPECIFIED)
     {
         uint16_t vif_id_sta = umac_interface_get_vif_id(umacd, UMAC_INTERFACE_STA);
         bool sta_vif_valid = vif_id_sta != MMDRV_VIF_ID_INVALID;
@@ -1268,18 +1348,99 @@ enum mmwlan_status mmwlan_tx_pkt(struct mmpkt *pkt, const struct mmwlan_tx_metad
 
     if (vif_id == MMDRV_VIF_ID_INVALID)
     {
-        MMLOG_WRN("No matching VIF (type=%u)\n", metadata.vif);
+        MMLOG_WRN("No matching VIF (type=%u)\n", metadata->vif);
         mmpkt_release(pkt);
         return MMWLAN_VIF_ERROR;
     }
 
     struct mmdrv_tx_metadata *tx_metadata = mmdrv_get_tx_metadata(pkt);
-    tx_metadata->tid = metadata.tid;
+    tx_metadata->tid = metadata->tid;
     tx_metadata->vif_id = vif_id;
 
+    return MMWLAN_SUCCESS;
+}
+
+enum mmwlan_status mmwlan_tx_pkt(struct mmpkt *pkt, const struct mmwlan_tx_metadata *_metadata)
+{
+    struct umac_data *umacd = umac_data_get_umacd();
+    MMLOG_VRB("TX packet\n");
+
+    struct mmwlan_tx_metadata metadata = MMWLAN_TX_METADATA_INIT;
+    if (_metadata != NULL)
+    {
+        metadata = *_metadata;
+    }
+
+    enum mmwlan_status status = umac_tx_pkt_prepare(umacd, pkt, &metadata);
+    if (status != MMWLAN_SUCCESS)
+    {
+        return status;
+    }
+
     return umac_datapath_tx_frame(umacd, pkt, ENCRYPTION_ENABLED, metadata.ra);
 }
 
+enum mmwlan_status mmwlan_tx_pkt_list(struct mmpkt_list *pkts,
+                                      const struct mmwlan_tx_metadata *_metadata)
+{
+    struct umac_data *umacd = umac_data_get_umacd();
+    enum mmwlan_status status = MMWLAN_SUCCESS;
+    struct mmpkt_list batch = MMPKT_LIST_INIT;
+    const uint8_t *batch_ra = NULL;
+    struct mmpkt *pkt;
+
+    if (pkts == NULL)
+    {
+        return MMWLAN_INVALID_ARGUMENT;
+    }
+
+    MMLOG_VRB("TX packet list (%lu packets)\n", mmpkt_list_length(pkts));
+
+    struct mmwlan_tx_metadata default_metadata = MMWLAN_TX_METADATA_INIT;
+    if (_metadata != NULL)
+    {
+        default_metadata = *_metadata;
+    }
+
+    while ((pkt = mmpkt_list_dequeue(pkts)) != NULL)
+    {
+        struct mmwlan_tx_metadata metadata = default_metadata;
+        enum mmwlan_status pkt_status = umac_tx_pkt_prepare(umacd, pkt, &metadata);
+        if (pkt_status != MMWLAN_SUCCESS)
+        {
+            if (status == MMWLAN_SUCCESS)
+            {
+                status = pkt_status;
+            }
+            continue;
+        }
+
+
+        if (!mmpkt_list_is_empty(&batch) && metadata.ra != batch_ra)
+        {
+            pkt_status = umac_datapath_tx_frames(umacd, &batch, ENCRYPTION_ENABLED, batch_ra);
+            if (status == MMWLAN_SUCCESS)
+            {
+                status = pkt_status;
+            }
+        }
+        batch_ra = metadata.ra;
+        mmpkt_list_append(&batch, pkt);
+    }
+
+    if (!mmpkt_list_is_empty(&batch))
+    {
+        enum mmwlan_status pkt_status =
+            umac_datapath_tx_frames(umacd, &batch, ENCRYPTION_ENABLED, batch_ra);
+        if (status == MMWLAN_SUCCESS)
+        {
+            status = pkt_status;
+        }
+    }
+
+    return status;
+}
+
 enum mmwlan_status mmwlan_tx_wait_until_ready(uint32_t timeout_ms)
 {
     struct umac_data *umacd = umac_data_get_umacd();
@@ -1824,6 +1985,124 @@ enum mmwlan_status mmwlan_get_serialized_umac_stats(uint8_t *buf, size_t *len)
     return MMWLAN_SUCCESS;
 }
 
+static void umac_pmksa_save_evt_handler(struct umac_data *umacd, const struct umac_evt *evt)
+{
+    *evt->args.pmksa_save.status =
+        umac_supp_pmksa_save(umacd, evt->args.pmksa_save.buf, evt->args.pmksa_save.len);
+    mmosal_semb_give(evt->args.pmksa_save.semb);
+}
+
+enum mmwlan_status mmwlan_sta_pmksa_save(uint8_t *buf, size_t *len)
+{
+    struct umac_data *umacd = umac_data_get_umacd();
+
+    if (!umac_data_is_initialised(umacd))
+    {
+        return MMWLAN_NOT_INITIALIZED;
+    }
+
+    if (!umac_core_is_running(umacd))
+    {
+        return umac_supp_pmksa_save(umacd, buf, len);
+    }
+
+    enum mmwlan_status status = MMWLAN_ERROR;
+    UMAC_QUEUE_EVT_AND_WAIT(umac_pmksa_save_evt_handler,
+                            pmksa_save,
+                            &status,
+                            .buf = buf,
+                            .len = len);
+
+    return status;
+}
+
+static void umac_pmksa_load_evt_handler(struct umac_data *umacd, const struct umac_evt *evt)
+{
+    *evt->args.pmksa_load.status =
+        umac_supp_pmksa_load(umacd, evt->args.pmksa_load.buf, evt->args.pmksa_load.len);
+    mmosal_semb_give(evt->args.pmksa_load.semb);
+}
+
+enum mmwlan_status mmwlan_sta_pmksa_load(const uint8_t *buf, size_t len)
+{
+    struct umac_data *umacd = umac_data_get_umacd();
+
+    if (!umac_data_is_initialised(umacd))
+    {
+        return MMWLAN_NOT_INITIALIZED;
+    }
+
+    if (!umac_core_is_running(umacd))
+    {
+        return umac_supp_pmksa_load(umacd, buf, len);
+    }
+
+    enum mmwlan_status status = MMWLAN_ERROR;
+    UMAC_QUEUE_EVT_AND_WAIT(umac_pmksa_load_evt_handler,
+                            pmksa_load,
+                            &status,
+                            .buf = buf,
+                            .len = len);
+
+    return status;
+}
+
+enum mmwlan_status mmwlan_bss_cache_save(uint8_t *buf, size_t *len)
+{
+    struct umac_data *umacd = umac_data_get_umacd();
+
+    if (!umac_data_is_initialised(umacd))
+    {
+        return MMWLAN_NOT_INITIALIZED;
+    }
+
+    int required_len = umac_scan_bss_cache_serialise(umacd, NULL, 0);
+    if (buf == NULL || *len < (size_t)required_len)
+    {
+        *len = required_len;
+        return MMWLAN_NO_MEM;
+    }
+
+    int ret = umac_scan_bss_cache_serialise(umacd, buf, *len);
+    if (ret < 0)
+    {
+        return MMWLAN_NO_MEM;
+    }
+
+    *len = ret;
+    return MMWLAN_SUCCESS;
+}
+
+enum mmwlan_status mmwlan_bss_cache_load(const uint8_t *buf, size_t len)
+{
+    struct umac_data *umacd = umac_data_get_umacd();
+
+    if (!umac_data_is_initialised(umacd))
+    {
+        return MMWLAN_NOT_INITIALIZED;
+    }
+
+    if (buf == NULL || !umac_scan_bss_cache_deserialise(umacd, buf, len))
+    {
+        return MMWLAN_INVALID_ARGUMENT;
+    }
+
+    return MMWLAN_SUCCESS;
+}
+
+enum mmwlan_status mmwlan_bss_cache_clear(void)
+{
+    struct umac_data *umacd = umac_data_get_umacd();
+
+    if (!umac_data_is_initialised(umacd))
+    {
+        return MMWLAN_NOT_INITIALIZED;
+    }
+
+    umac_scan_bss_cache_clear(umacd);
+    return MMWLAN_SUCCESS;
+}
+
 static void umac_get_ap_sta_status(struct umac_data *umacd, const struct umac_evt *evt)
 {
     *evt->args.ap_get_sta_status.status =
@@ -118,6 +118,33 @@ struct MQTTAgentMessageContext
     struct mmosal_queue *xQueue;            /**< The queue to post the commands to */
 };
 
+/**
+ * Initial number of buckets in the topic trie hash table. Must be a power of 2.
+ */
+#define SUB_TRIE_MIN_BUCKETS                  (16U)
+
+/**
+ * A level of a topic filter in the subscription trie.
+ *
+ * Each node represents one level of one or more topic filters. Literal child levels are found
+ * through the hash table in the subscription manager context, keyed on the parent node and the
+ * level string, so that dispatching a publish costs one lookup per topic level regardless of the
+ * number of subscriptions. The single level (@c +) and multi level (@c #) wildcard children are
+ * held directly by the parent.
+ */
+typedef struct SubTrieNode
+{
+    struct SubTrieNode *pxParent;       /**< Parent level, NULL for the root */
+    struct SubTrieNode *pxBucketNext;   /**< Next node in the same hash bucket */
+    struct SubTrieNode *pxPlus;         /**< Child for the @c + wildcard level */
+    struct SubTrieNode *pxHash;         /**< Child for the @c # wildcard level */
+    MQTTSubscribeInfo_t *pxSubInfo;     /**< Subscription whose filter ends at this level */
+    size_t uxFirstCb;                   /**< Index of the first callback for @c pxSubInfo */
+    size_t uxChildCount;                /**< Number of child levels, including wildcards */
+    const char *pcLevel;                /**< Level string, stored after the node */
+    uint16_t usLevelLen;                /**< Length of @c pcLevel */
+} SubTrieNode_t;
+
 /**
  * Subscription manager context
  */
@@ -126,7 +153,14 @@ typedef struct MQTTAgentSubscriptionManagerCtx
     MQTTSubscribeInfo_t pxSubscriptions[ MQTT_AGENT_MAX_SUBSCRIPTIONS ];/**< Subscriptions */
     MQTTSubAckStatus_t pxSubAckStatus[ MQTT_AGENT_MAX_SUBSCRIPTIONS ];  /**< Acknowledgment */
     uint32_t pulSubCbCount[ MQTT_AGENT_MAX_SUBSCRIPTIONS ];             /**< No of callbacks */
+    SubTrieNode_t *pxSubNodes[ MQTT_AGENT_MAX_SUBSCRIPTIONS ];          /**< Trie node of each */
     SubCallbackElement_t pxCallbacks[ MQTT_AGENT_MAX_CALLBACKS ];       /**< Callbacks */
+    size_t puxNextCb[ MQTT_AGENT_MAX_CALLBACKS ];   /**< Next callback of the same subscription */
+
+    SubTrieNode_t xTrieRoot;                            /**< Root of the topic filter trie */
+    SubTrieNode_t **ppxTrieBuckets;                     /**< Hash table of literal trie levels */
+    size_t uxTrieBucketCount;                           /**< Number of buckets in the table */
+    size_t uxTrieNodeCount;                             /**< Number of nodes in the table */
 
     size_t uxSubscriptionCount;                         /**< Total active subscriptions */
     size_t uxCallbackCount;                             /**< Total registered callbacks */
@@ -288,35 +322,46 @@ void mqtt_agent_task_set_exit_flag(bool newval)
     bExitFlag = newval;
 }
 
-static inline void prvUpdateCallbackRefs(SubCallbackElement_t *pxCallbacksList,
-                                         MQTTSubscribeInfo_t *pxSubList,
-                                         size_t uxOldIdx,
-                                         size_t uxNewIdx)
+static inline void prvMoveSubscription(SubMgrCtx_t *pxCtx,
+                                       size_t uxOldIdx,
+                                       size_t uxNewIdx)
 {
-    MMOSAL_ASSERT(pxCallbacksList);
-    MMOSAL_ASSERT(pxSubList);
     MMOSAL_ASSERT(uxOldIdx < MQTT_AGENT_MAX_SUBSCRIPTIONS);
     MMOSAL_ASSERT(uxNewIdx < MQTT_AGENT_MAX_SUBSCRIPTIONS);
 
+    /* Move new item into place */
+    pxCtx->pxSubscriptions[ uxNewIdx ] = pxCtx->pxSubscriptions[ uxOldIdx ];
+    pxCtx->pxSubAckStatus[ uxNewIdx ] = pxCtx->pxSubAckStatus[ uxOldIdx ];
+    pxCtx->pulSubCbCount[ uxNewIdx ] = pxCtx->pulSubCbCount[ uxOldIdx ];
+    pxCtx->pxSubNodes[ uxNewIdx ] = pxCtx->pxSubNodes[ uxOldIdx ];
+
+    /* Clear old location */
+    memset(&(pxCtx->pxSubscriptions[ uxOldIdx ]), 0, sizeof(MQTTSubscribeInfo_t));
+    pxCtx->pxSubAckStatus[ uxOldIdx ] = MQTTSubAckFailure;
+    pxCtx->pulSubCbCount[ uxOldIdx ] = 0;
+    pxCtx->pxSubNodes[ uxOldIdx ] = NULL;
+
+    /* Update references to the subscription */
+    if (pxCtx->pxSubNodes[ uxNewIdx ] != NULL)
+    {
+        pxCtx->pxSubNodes[ uxNewIdx ]->pxSubInfo = &(pxCtx->pxSubscriptions[ uxNewIdx ]);
+    }
+
     for (size_t uxIdx = 0; uxIdx < MQTT_AGENT_MAX_CALLBACKS; uxIdx++)
     {
-        if (pxCallbacksList[ uxIdx ].pxSubInfo == &(pxSubList[ uxOldIdx ]))
+        if (pxCtx->pxCallbacks[ uxIdx ].pxSubInfo == &(pxCtx->pxSubscriptions[ uxOldIdx ]))
         {
-            pxCallbacksList[ uxIdx ].pxSubInfo = &(pxSubList[ uxNewIdx ]);
+            pxCtx->pxCallbacks[ uxIdx ].pxSubInfo = &(pxCtx->pxSubscriptions[ uxNewIdx ]);
         }
     }
 }
 
-static inline void prvCompressSubscriptionList(MQTTSubscribeInfo_t *pxSubList,
-                                               SubCallbackElement_t *pxCallbacksList,
-                                               size_t *puxSubCount)
+static inline void prvCompressSubscriptionList(SubMgrCtx_t *pxCtx)
 {
+    MQTTSubscribeInfo_t *pxSubList = pxCtx->pxSubscriptions;
     size_t uxLastOccupiedIndex = 0;
     size_t uxSubCount = 0;
 
-    MMOSAL_ASSERT(pxSubList);
-    MMOSAL_ASSERT(pxCallbacksList);
-
     for (size_t uxIdx = 0U; uxIdx < MQTT_AGENT_MAX_SUBSCRIPTIONS; uxIdx++)
     {
         if ((pxSubList[ uxIdx ].pTopicFilter == NULL) &&
@@ -329,17 +374,11 @@ static inline void prvCompressSubscriptionList(MQTTSubscribeInfo_t *pxSubList,
             }
 
             /* Iterate over remainder of list for occupied spots */
-            for (; uxLastOccupiedIndex < MQTT_AGENT_MAX_CALLBACKS; uxLastOccupiedIndex++)
+            for (; uxLastOccupiedIndex < MQTT_AGENT_MAX_SUBSCRIPTIONS; uxLastOccupiedIndex++)
             {
                 if (pxSubList[ uxLastOccupiedIndex ].topicFilterLength != 0)
                 {
-                    /* Move new item into place */
-                    pxSubList[ uxIdx ] = pxSubList[ uxLastOccupiedIndex ];
-
-                    /* Clear old location */
-                    memset(&(pxSubList[ uxLastOccupiedIndex ]), 0, sizeof(MQTTSubscribeInfo_t));
-
-                    prvUpdateCallbackRefs(pxCallbacksList, pxSubList, uxLastOccupiedIndex, uxIdx);
+                    prvMoveSubscription(pxCtx, uxLastOccupiedIndex, uxIdx);
 
                     /* Increment count of active subscriptions */
                     uxSubCount++;
@@ -363,68 +402,419 @@ static inline void prvCompressSubscriptionList(MQTTSubscribeInfo_t *pxSubList,
         }
     }
 
-    *puxSubCount = uxSubCount;
+    pxCtx->uxSubscriptionCount = uxSubCount;
 }
 
-static inline void prvCompressCallbackList(SubCallbackElement_t *pxCallbackList,
-                                           size_t *puxCallbackCount)
+/**
+ * Hash a topic level for lookup in the trie hash table.
+ *
+ * @param[in] pxParent   The parent level.
+ * @param[in] pcLevel    The level string, not null terminated.
+ * @param[in] usLevelLen The length of the level string.
+ * @return               The hash value.
+ */
+static uint32_t prvTrieHash(const SubTrieNode_t *pxParent,
+                            const char *pcLevel,
+                            uint16_t usLevelLen)
 {
-    size_t uxLastOccupiedIndex = 0;
-    size_t uxCallbackCount = 0;
+    /* FNV-1a over the level, seeded with the parent so that equal levels under different parents
+     * are spread across the table. */
+    uint32_t ulHash = 2166136261U ^ ((uint32_t)(uintptr_t)pxParent * 2654435761U);
+
+    for (uint16_t usIdx = 0; usIdx < usLevelLen; usIdx++)
+    {
+        ulHash ^= (uint8_t)pcLevel[ usIdx ];
+        ulHash *= 16777619U;
+    }
 
-    MMOSAL_ASSERT(pxCallbackList);
-    MMOSAL_ASSERT(puxCallbackCount);
+    return ulHash;
+}
+
+static SubTrieNode_t *prvTrieFindChild(SubMgrCtx_t *pxCtx,
+                                       const SubTrieNode_t *pxParent,
+                                       const char *pcLevel,
+                                       uint16_t usLevelLen)
+{
+    if (pxCtx->uxTrieBucketCount == 0)
+    {
+        return NULL;
+    }
+
+    uint32_t ulBucket = prvTrieHash(pxParent, pcLevel, usLevelLen) &
+                        (pxCtx->uxTrieBucketCount - 1);
+    SubTrieNode_t *pxNode = pxCtx->ppxTrieBuckets[ ulBucket ];
 
-    for (size_t uxIdx = 0U; uxIdx < MQTT_AGENT_MAX_CALLBACKS; uxIdx++)
+    while (pxNode != NULL)
     {
-        if ((pxCallbackList[ uxIdx ].pxSubInfo == NULL) &&    /* Current slot at uxIdx is Empty */
-            (uxLastOccupiedIndex < MQTT_AGENT_MAX_CALLBACKS))
+        if ((pxNode->pxParent == pxParent) &&
+            (pxNode->usLevelLen == usLevelLen) &&
+            (memcmp(pxNode->pcLevel, pcLevel, usLevelLen) == 0))
         {
-            /* uxLastOccupiedIndex is always > uxIdx */
-            if (uxLastOccupiedIndex <= uxIdx)
-            {
-                uxLastOccupiedIndex = uxIdx + 1;
-            }
+            break;
+        }
+        pxNode = pxNode->pxBucketNext;
+    }
 
-            /* Iterate over remainder of list for occupied spots */
-            for (; uxLastOccupiedIndex < MQTT_AGENT_MAX_CALLBACKS; uxLastOccupiedIndex++)
-            {
-                if (pxCallbackList[ uxLastOccupiedIndex ].pxSubInfo != NULL)
-                {
-                    MMOSAL_ASSERT(uxLastOccupiedIndex > uxIdx);
+    return pxNode;
+}
 
-                    /* Move context from uxLastOccupiedIndex to uxIdx */
-                    pxCallbackList[ uxIdx ] = pxCallbackList[ uxLastOccupiedIndex ];
+static void prvTrieBucketInsert(SubTrieNode_t **ppxBuckets,
+                                size_t uxBucketCount,
+                                SubTrieNode_t *pxNode)
+{
+    uint32_t ulBucket = prvTrieHash(pxNode->pxParent, pxNode->pcLevel, pxNode->usLevelLen) &
+                        (uxBucketCount - 1);
 
-                    /* Clear old context location */
-                    memset(&(pxCallbackList[ uxLastOccupiedIndex ]), 0,
-                           sizeof(SubCallbackElement_t));
+    pxNode->pxBucketNext = ppxBuckets[ ulBucket ];
+    ppxBuckets[ ulBucket ] = pxNode;
+}
 
-                    pxCallbackList[ uxLastOccupiedIndex ].pxIncomingPublishCallback = NULL;
-                    pxCallbackList[ uxLastOccupiedIndex ].pvIncomingPublishCallbackContext = NULL;
-                    pxCallbackList[ uxLastOccupiedIndex ].pxSubInfo = NULL;
+/**
+ * Double the size of the trie hash table once it is fully loaded. Failure to grow is not fatal;
+ * lookups just walk longer bucket chains.
+ */
+static void prvTrieGrow(SubMgrCtx_t *pxCtx)
+{
+    size_t uxNewCount = (pxCtx->uxTrieBucketCount == 0) ? SUB_TRIE_MIN_BUCKETS :
+                        (pxCtx->uxTrieBucketCount * 2);
+    SubTrieNode_t **ppxNewBuckets;
 
-                    /* Increment count of active callbacks */
-                    uxCallbackCount++;
+    if (pxCtx->uxTrieNodeCount < pxCtx->uxTrieBucketCount)
+    {
+        return;
+    }
 
-                    /* Increment counter so we don't visit this empty location again */
-                    uxLastOccupiedIndex++;
-                    break;
-                }
+    ppxNewBuckets = (SubTrieNode_t **)mmosal_malloc(uxNewCount * sizeof(SubTrieNode_t *));
+    if (ppxNewBuckets == NULL)
+    {
+        return;
+    }
+    memset(ppxNewBuckets, 0, uxNewCount * sizeof(SubTrieNode_t *));
+
+    for (size_t uxIdx = 0; uxIdx < pxCtx->uxTrieBucketCount; uxIdx++)
+    {
+        SubTrieNode_t *pxNode = pxCtx->ppxTrieBuckets[ uxIdx ];
+
+        while (pxNode != NULL)
+        {
+            SubTrieNode_t *pxNext = pxNode->pxBucketNext;
+            prvTrieBucketInsert(ppxNewBuckets, uxNewCount, pxNode);
+            pxNode = pxNext;
+        }
+    }
+
+    mmosal_free(pxCtx->ppxTrieBuckets);
+    pxCtx->ppxTrieBuckets = ppxNewBuckets;
+    pxCtx->uxTrieBucketCount = uxNewCount;
+}
+
+static SubTrieNode_t *prvTrieAddChild(SubMgrCtx_t *pxCtx,
+                                      SubTrieNode_t *pxParent,
+                                      const char *pcLevel,
+                                      uint16_t usLevelLen)
+{
+    SubTrieNode_t **ppxWildcard = NULL;
+    SubTrieNode_t *pxNode;
+
+    if ((usLevelLen == 1) && (pcLevel[ 0 ] == '+'))
+    {
+        ppxWildcard = &(pxParent->pxPlus);
+    }
+    else if ((usLevelLen == 1) && (pcLevel[ 0 ] == '#'))
+    {
+        ppxWildcard = &(pxParent->pxHash);
+    }
+
+    pxNode = (ppxWildcard != NULL) ? *ppxWildcard :
+             prvTrieFindChild(pxCtx, pxParent, pcLevel, usLevelLen);
+    if (pxNode != NULL)
+    {
+        return pxNode;
+    }
+
+    if (ppxWildcard == NULL)
+    {
+        prvTrieGrow(pxCtx);
+        if (pxCtx->uxTrieBucketCount == 0)
+        {
+            return NULL;
+        }
+    }
+
+    pxNode = (SubTrieNode_t *)mmosal_malloc(sizeof(SubTrieNode_t) + usLevelLen);
+    if (pxNode == NULL)
+    {
+        return NULL;
+    }
+
+    memset(pxNode, 0, sizeof(SubTrieNode_t));
+    memcpy((char *)(pxNode + 1), pcLevel, usLevelLen);
+    pxNode->pcLevel = (const char *)(pxNode + 1);
+    pxNode->usLevelLen = usLevelLen;
+    pxNode->pxParent = pxParent;
+    pxNode->uxFirstCb = MQTT_AGENT_MAX_CALLBACKS;
+    pxParent->uxChildCount++;
+
+    if (ppxWildcard != NULL)
+    {
+        *ppxWildcard = pxNode;
+    }
+    else
+    {
+        prvTrieBucketInsert(pxCtx->ppxTrieBuckets, pxCtx->uxTrieBucketCount, pxNode);
+        pxCtx->uxTrieNodeCount++;
+    }
+
+    return pxNode;
+}
+
+static void prvTrieRemoveNode(SubMgrCtx_t *pxCtx, SubTrieNode_t *pxNode)
+{
+    SubTrieNode_t *pxParent = pxNode->pxParent;
+
+    if (pxParent->pxPlus == pxNode)
+    {
+        pxParent->pxPlus = NULL;
+    }
+    else if (pxParent->pxHash == pxNode)
+    {
+        pxParent->pxHash = NULL;
+    }
+    else
+    {
+        uint32_t ulBucket = prvTrieHash(pxParent, pxNode->pcLevel, pxNode->usLevelLen) &
+                            (pxCtx->uxTrieBucketCount - 1);
+        SubTrieNode_t **ppxLink = &(pxCtx->ppxTrieBuckets[ ulBucket ]);
+
+        while (*ppxLink != pxNode)
+        {
+            MMOSAL_ASSERT(*ppxLink != NULL);
+            ppxLink = &((*ppxLink)->pxBucketNext);
+        }
+
+        *ppxLink = pxNode->pxBucketNext;
+        pxCtx->uxTrieNodeCount--;
+    }
+
+    pxParent->uxChildCount--;
+    mmosal_free(pxNode);
+}
+
+/**
+ * Remove the given node and any ancestors that no longer lead to a subscription.
+ */
+static void prvTriePrune(SubMgrCtx_t *pxCtx, SubTrieNode_t *pxNode)
+{
+    while ((pxNode != NULL) &&
+           (pxNode != &(pxCtx->xTrieRoot)) &&
+           (pxNode->pxSubInfo == NULL) &&
+           (pxNode->uxChildCount == 0))
+    {
+        SubTrieNode_t *pxParent = pxNode->pxParent;
+        prvTrieRemoveNode(pxCtx, pxNode);
+        pxNode = pxParent;
+    }
+}
+
+/**
+ * Walk a topic filter level by level.
+ *
+ * @param[in] pxCtx           Subscription manager context.
+ * @param[in] pcTopicFilter   The topic filter, need not be null terminated.
+ * @param[in] usTopicFilterLen The length of the topic filter.
+ * @param[in] bCreate         Create any levels that do not yet exist.
+ * @return                    The node for the last level of the filter, or NULL if it does not
+ *                            exist (or could not be created).
+ */
+static SubTrieNode_t *prvTrieLookup(SubMgrCtx_t *pxCtx,
+                                    const char *pcTopicFilter,
+                                    uint16_t usTopicFilterLen,
+                                    bool bCreate)
+{
+    SubTrieNode_t *pxNode = &(pxCtx->xTrieRoot);
+    uint16_t usStart = 0;
+
+    while (pxNode != NULL)
+    {
+        uint16_t usEnd = usStart;
+
+        while ((usEnd < usTopicFilterLen) && (pcTopicFilter[ usEnd ] != '/'))
+        {
+            usEnd++;
+        }
+
+        const char *pcLevel = &(pcTopicFilter[ usStart ]);
+        uint16_t usLevelLen = usEnd - usStart;
+
+        if (bCreate)
+        {
+            SubTrieNode_t *pxParent = pxNode;
+
+            pxNode = prvTrieAddChild(pxCtx, pxParent, pcLevel, usLevelLen);
+            if (pxNode == NULL)
+            {
+                /* Free the levels already created for this filter. Existing levels all lead to
+                 * a subscription so are left in place. */
+                prvTriePrune(pxCtx, pxParent);
             }
         }
-        else if (pxCallbackList[ uxIdx ].pxSubInfo != NULL)
+        else if ((usLevelLen == 1) && (pcLevel[ 0 ] == '+'))
         {
-            /* Increment count of valid contexts */
-            uxCallbackCount++;
+            pxNode = pxNode->pxPlus;
         }
-        else /* pxCallbackList[ uxIdx ].pxSubInfo == NULL */
+        else if ((usLevelLen == 1) && (pcLevel[ 0 ] == '#'))
         {
-            /* Continue iterating, ignore empty slot. */
+            pxNode = pxNode->pxHash;
+        }
+        else
+        {
+            pxNode = prvTrieFindChild(pxCtx, pxNode, pcLevel, usLevelLen);
+        }
+
+        if (usEnd >= usTopicFilterLen)
+        {
+            break;
+        }
+        usStart = usEnd + 1;
+    }
+
+    return pxNode;
+}
+
+static void prvTrieFreeWildcards(SubTrieNode_t *pxNode)
+{
+    /* Wildcard nodes are not in the hash table so are only reachable from their parent */
+    if (pxNode->pxPlus != NULL)
+    {
+        prvTrieFreeWildcards(pxNode->pxPlus);
+        mmosal_free(pxNode->pxPlus);
+        pxNode->pxPlus = NULL;
+    }
+
+    if (pxNode->pxHash != NULL)
+    {
+        prvTrieFreeWildcards(pxNode->pxHash);
+        mmosal_free(pxNode->pxHash);
+        pxNode->pxHash = NULL;
+    }
+}
+
+static void prvTrieClear(SubMgrCtx_t *pxCtx)
+{
+    /* Literal nodes may have wildcard children, so free those before the node itself */
+    for (size_t uxIdx = 0; uxIdx < pxCtx->uxTrieBucketCount; uxIdx++)
+    {
+        SubTrieNode_t *pxNode = pxCtx->ppxTrieBuckets[ uxIdx ];
+
+        while (pxNode != NULL)
+        {
+            SubTrieNode_t *pxNext = pxNode->pxBucketNext;
+            prvTrieFreeWildcards(pxNode);
+            mmosal_free(pxNode);
+            pxNode = pxNext;
         }
     }
+    prvTrieFreeWildcards(&(pxCtx->xTrieRoot));
 
-    *puxCallbackCount = uxCallbackCount;
+    mmosal_free(pxCtx->ppxTrieBuckets);
+    pxCtx->ppxTrieBuckets = NULL;
+    pxCtx->uxTrieBucketCount = 0;
+    pxCtx->uxTrieNodeCount = 0;
+
+    memset(&(pxCtx->xTrieRoot), 0, sizeof(pxCtx->xTrieRoot));
+    pxCtx->xTrieRoot.uxFirstCb = MQTT_AGENT_MAX_CALLBACKS;
+}
+
+static bool prvTrieDeliver(SubMgrCtx_t *pxCtx,
+                           const SubTrieNode_t *pxNode,
+                           MQTTPublishInfo_t *pxPublishInfo)
+{
+    bool bPublishHandled = false;
+
+    if (pxNode->pxSubInfo == NULL)
+    {
+        return false;
+    }
+
+    for (size_t uxCbIdx = pxNode->uxFirstCb;
+         uxCbIdx < MQTT_AGENT_MAX_CALLBACKS;
+         uxCbIdx = pxCtx->puxNextCb[ uxCbIdx ])
+    {
+        SubCallbackElement_t * const pxCallback = &(pxCtx->pxCallbacks[ uxCbIdx ]);
+
+        pxCallback->pxIncomingPublishCallback(pxCallback->pvIncomingPublishCallbackContext,
+                                              pxPublishInfo);
+        bPublishHandled = true;
+    }
+
+    return bPublishHandled;
+}
+
+/**
+ * Deliver a publish to every subscription in the trie below @p pxNode that matches the
+ * remainder of the topic name.
+ *
+ * @param[in] pxCtx         Subscription manager context.
+ * @param[in] pxNode        The trie node matched so far.
+ * @param[in] pcTopic       Start of the next level of the topic name, or NULL if all levels
+ *                          have been matched.
+ * @param[in] usTopicLen    Length of the remainder of the topic name.
+ * @param[in] pxPublishInfo The publish to deliver.
+ * @return                  @c true if at least one callback was invoked.
+ */
+static bool prvTrieMatch(SubMgrCtx_t *pxCtx,
+                         const SubTrieNode_t *pxNode,
+                         const char *pcTopic,
+                         uint16_t usTopicLen,
+                         MQTTPublishInfo_t *pxPublishInfo)
+{
+    bool bPublishHandled = false;
+
+    /* Wildcards at the first level must not match topics starting with '$' */
+    bool bWildcardsAllowed = !((pxNode == &(pxCtx->xTrieRoot)) &&
+                               (usTopicLen > 0) && (pcTopic[ 0 ] == '$'));
+
+    /* '#' matches the parent level as well as any number of child levels */
+    if ((pxNode->pxHash != NULL) && bWildcardsAllowed)
+    {
+        bPublishHandled |= prvTrieDeliver(pxCtx, pxNode->pxHash, pxPublishInfo);
+    }
+
+    if (pcTopic == NULL)
+    {
+        bPublishHandled |= prvTrieDeliver(pxCtx, pxNode, pxPublishInfo);
+        return bPublishHandled;
+    }
+
+    uint16_t usLevelLen = 0;
+
+    while ((usLevelLen < usTopicLen) && (pcTopic[ usLevelLen ] != '/'))
+    {
+        usLevelLen++;
+    }
+
+    const char *pcNext = NULL;
+    uint16_t usNextLen = 0;
+
+    if (usLevelLen < usTopicLen)
+    {
+        pcNext = &(pcTopic[ usLevelLen + 1 ]);
+        usNextLen = usTopicLen - usLevelLen - 1;
+    }
+
+    const SubTrieNode_t *pxChild = prvTrieFindChild(pxCtx, pxNode, pcTopic, usLevelLen);
+
+    if (pxChild != NULL)
+    {
+        bPublishHandled |= prvTrieMatch(pxCtx, pxChild, pcNext, usNextLen, pxPublishInfo);
+    }
+
+    if ((pxNode->pxPlus != NULL) && bWildcardsAllowed)
+    {
+        bPublishHandled |= prvTrieMatch(pxCtx, pxNode->pxPlus, pcNext, usNextLen, pxPublishInfo);
+    }
+
+    return bPublishHandled;
 }
 
 static bool prvAgentMessageSend(MQTTAgentMessageContext_t *pxMsgCtx,
@@ -515,9 +905,7 @@ static MQTTStatus_t prvHandleResubscribe(MQTTAgentContext_t *pxMqttAgentCtx,
     MMOSAL_ASSERT(pxCtx->xMutex);
     MMOSAL_ASSERT(MUTEX_IS_OWNED(pxCtx->xMutex));
 
-    prvCompressSubscriptionList(pxCtx->pxSubscriptions,
-                                pxCtx->pxCallbacks,
-                                &(pxCtx->uxSubscriptionCount));
+    prvCompressSubscriptionList(pxCtx);
 
     if ((xStatus == MQTTSuccess) && (pxCtx->uxSubscriptionCount > 0U))
     {
@@ -555,21 +943,6 @@ static MQTTStatus_t prvHandleResubscribe(MQTTAgentContext_t *pxMqttAgentCtx,
     return xStatus;
 }
 
-static inline bool prvMatchTopic(MQTTSubscribeInfo_t *pxSubscribeInfo,
-                                 const char *pcTopicName,
-                                 const uint16_t usTopicLen)
-{
-    MQTTStatus_t xStatus = MQTTSuccess;
-    bool isMatched = false;
-
-    xStatus = MQTT_MatchTopic(pcTopicName,
-                              usTopicLen,
-                              pxSubscribeInfo->pTopicFilter,
-                              pxSubscribeInfo->topicFilterLength,
-                              &isMatched);
-    return (xStatus == MQTTSuccess) && isMatched;
-}
-
 static inline bool prvMatchCbCtx(SubCallbackElement_t *pxCbCtx,
                                  MQTTSubscribeInfo_t *pxSubInfo,
                                  IncomingPubCallback_t pxCallback,
@@ -597,21 +970,14 @@ static void prvIncomingPublishCallback(MQTTAgentContext_t *pMqttAgentContext,
 
     if (bLockSubCtx(pxCtx))
     {
-        /* Iterate over pxCtx->pxCallbacks list */
-        for (uint32_t ulCbIdx = 0; ulCbIdx < MQTT_AGENT_MAX_CALLBACKS; ulCbIdx++)
+        /* Walk the subscription trie one topic level at a time */
+        if ((pxPublishInfo->pTopicName != NULL) && (pxPublishInfo->topicNameLength > 0))
         {
-            SubCallbackElement_t * const pxCallback = &(pxCtx->pxCallbacks[ ulCbIdx ]);
-            MQTTSubscribeInfo_t * const pxSubInfo = pxCallback->pxSubInfo;
-
-            if ((pxSubInfo != NULL) &&
-                prvMatchTopic(pxSubInfo,
-                              pxPublishInfo->pTopicName,
-                              pxPublishInfo->topicNameLength))
-            {
-                pxCallback->pxIncomingPublishCallback(pxCallback->pvIncomingPublishCallbackContext,
-                                                      pxPublishInfo);
-                bPublishHandled = true;
-            }
+            bPublishHandled = prvTrieMatch(pxCtx,
+                                           &(pxCtx->xTrieRoot),
+                                           pxPublishInfo->pTopicName,
+                                           pxPublishInfo->topicNameLength,
+                                           pxPublishInfo);
         }
 
         (void)bUnlockSubCtx(pxCtx);
@@ -632,6 +998,8 @@ static void prvSubscriptionManagerCtxFree(SubMgrCtx_t *pxSubMgrCtx)
         MMOSAL_ASSERT(MUTEX_IS_OWNED(pxSubMgrCtx->xMutex));
         mmosal_mutex_delete(pxSubMgrCtx->xMutex);
     }
+
+    prvTrieClear(pxSubMgrCtx);
 }
 
 static void prvSubscriptionManagerCtxReset(SubMgrCtx_t *pxSubMgrCtx)
@@ -642,11 +1010,15 @@ static void prvSubscriptionManagerCtxReset(SubMgrCtx_t *pxSubMgrCtx)
     pxSubMgrCtx->uxSubscriptionCount = 0;
     pxSubMgrCtx->uxCallbackCount = 0;
 
+    prvTrieClear(pxSubMgrCtx);
+
     for (size_t uxIdx = 0; uxIdx < MQTT_AGENT_MAX_SUBSCRIPTIONS; uxIdx++)
     {
         pxSubMgrCtx->pxSubAckStatus[ uxIdx ] = MQTTSubAckFailure;
         pxSubMgrCtx->pulSubCbCount[ uxIdx ] = 0;
+        pxSubMgrCtx->pxSubNodes[ uxIdx ] = NULL;
 
+        mmosal_free((void *)pxSubMgrCtx->pxSubscriptions[ uxIdx ].pTopicFilter);
         pxSubMgrCtx->pxSubscriptions[ uxIdx ].pTopicFilter = NULL;
         pxSubMgrCtx->pxSubscriptions[ uxIdx ].qos = (MQTTQoS_t)0;
         pxSubMgrCtx->pxSubscriptions[ uxIdx ].topicFilterLength = 0;
@@ -657,6 +1029,7 @@ static void prvSubscriptionManagerCtxReset(SubMgrCtx_t *pxSubMgrCtx)
         pxSubMgrCtx->pxCallbacks[ uxIdx ].pvIncomingPublishCallbackContext = NULL;
         pxSubMgrCtx->pxCallbacks[ uxIdx ].pxIncomingPublishCallback = NULL;
         pxSubMgrCtx->pxCallbacks[ uxIdx ].pxSubInfo = NULL;
+        pxSubMgrCtx->puxNextCb[ uxIdx ] = MQTT_AGENT_MAX_CALLBACKS;
     }
 
     pxSubMgrCtx->xInitialSubscribeArgs.numSubscriptions = 0;
@@ -730,6 +1103,7 @@ static MQTTStatus_t prvConfigureAgentTaskCtx(MQTTAgentTaskCtx_t *pxCtx,
         /* Setup transport interface */
         pxCtx->xTransport.pNetworkContext = pxNetworkContext;
         pxCtx->xTransport.send = transport_send;
+        pxCtx->xTransport.writev = transport_writev;
         pxCtx->xTransport.recv = transport_recv;
     }
 
@@ -1246,45 +1620,44 @@ MQTTStatus_t MqttAgent_SubscribeSync(MQTTAgentHandle_t xHandle,
     {
         size_t uxTargetSubIdx = MQTT_AGENT_MAX_SUBSCRIPTIONS;
         size_t uxTargetCbIdx = MQTT_AGENT_MAX_CALLBACKS;
+        SubTrieNode_t *pxNode = prvTrieLookup(pxCtx,
+                                              pcTopicFilter,
+                                              (uint16_t)xTopicFilterLen,
+                                              false);
 
         /* If no slot is found, return MQTTNoMemory */
         xStatus = MQTTNoMemory;
 
-        for (size_t uxSubIdx = 0U; uxSubIdx < MQTT_AGENT_MAX_SUBSCRIPTIONS; uxSubIdx++)
+        if ((pxNode != NULL) && (pxNode->pxSubInfo != NULL))
         {
-            MQTTSubscribeInfo_t * const pxSubInfo = &(pxCtx->pxSubscriptions[ uxSubIdx ]);
-
-            if ((pxCtx->pxSubscriptions[ uxSubIdx ].pTopicFilter == NULL) &&
-                (uxTargetSubIdx == MQTT_AGENT_MAX_SUBSCRIPTIONS))
-            {
-                /* Check that the current context is indeed empty */
-                MMOSAL_ASSERT(pxCtx->pxSubscriptions[ uxSubIdx ].topicFilterLength == 0);
+            MQTTSubscribeInfo_t * const pxSubInfo = pxNode->pxSubInfo;
 
-                uxTargetSubIdx = uxSubIdx;
-                xStatus = MQTTSuccess;
+            uxTargetSubIdx = pxSubInfo - pxCtx->pxSubscriptions;
+            xRequestedQoS = prvGetNewQoS(pxSubInfo->qos, xRequestedQoS);
+            xStatus = MQTTSuccess;
 
-                /* Reset SubAckStatus to trigger a subscribe op */
+            /* If QoS differs, trigger a subscribe op */
+            if (pxSubInfo->qos != xRequestedQoS)
+            {
                 pxCtx->pxSubAckStatus[ uxTargetSubIdx ] = MQTTSubAckFailure;
             }
-            else if (pxSubInfo->pTopicFilter != NULL && strncmp(pxSubInfo->pTopicFilter,
-                                                                pcTopicFilter,
-                                                                pxSubInfo->topicFilterLength) == 0)
+        }
+        else
+        {
+            for (size_t uxSubIdx = 0U; uxSubIdx < MQTT_AGENT_MAX_SUBSCRIPTIONS; uxSubIdx++)
             {
-                xRequestedQoS = prvGetNewQoS(pxSubInfo->qos, xRequestedQoS);
-                xStatus = MQTTSuccess;
-                uxTargetSubIdx = uxSubIdx;
-
-                /* If QoS differs, trigger a subscribe op */
-                if (pxSubInfo->qos != xRequestedQoS)
+                if (pxCtx->pxSubscriptions[ uxSubIdx ].pTopicFilter == NULL)
                 {
+                    /* Check that the current context is indeed empty */
+                    MMOSAL_ASSERT(pxCtx->pxSubscriptions[ uxSubIdx ].topicFilterLength == 0);
+
+                    uxTargetSubIdx = uxSubIdx;
+                    xStatus = MQTTSuccess;
+
+                    /* Reset SubAckStatus to trigger a subscribe op */
                     pxCtx->pxSubAckStatus[ uxTargetSubIdx ] = MQTTSubAckFailure;
+                    break;
                 }
-
-                break;
-            }
-            else
-            {
-                /* Empty */
             }
         }
 
@@ -1294,23 +1667,34 @@ MQTTStatus_t MqttAgent_SubscribeSync(MQTTAgentHandle_t xHandle,
             /* If no slot is found, return MQTTNoMemory */
             xStatus = MQTTNoMemory;
 
-            /* Find matching or empty callback context */
-            for (size_t uxCbIdx = 0U; uxCbIdx < MQTT_AGENT_MAX_CALLBACKS; uxCbIdx++)
+            /* Find matching callback context for this subscription */
+            if ((pxNode != NULL) && (pxNode->pxSubInfo != NULL))
             {
-                if ((uxTargetCbIdx == MQTT_AGENT_MAX_CALLBACKS) &&
-                    (pxCtx->pxCallbacks[ uxCbIdx ].pxSubInfo == NULL))
+                for (size_t uxCbIdx = pxNode->uxFirstCb;
+                     uxCbIdx < MQTT_AGENT_MAX_CALLBACKS;
+                     uxCbIdx = pxCtx->puxNextCb[ uxCbIdx ])
                 {
-                    uxTargetCbIdx = uxCbIdx;
-                    xStatus = MQTTSuccess;
+                    if (prvMatchCbCtx(&(pxCtx->pxCallbacks[ uxCbIdx ]),
+                                      pxNode->pxSubInfo,
+                                      pxCallback,
+                                      pvCallbackCtx))
+                    {
+                        uxTargetCbIdx = uxCbIdx;
+                        xStatus = MQTTSuccess;
+                        break;
+                    }
                 }
-                else if (prvMatchCbCtx(&(pxCtx->pxCallbacks[ uxCbIdx ]),
-                                       &(pxCtx->pxSubscriptions[ uxTargetSubIdx ]),
-                                       pxCallback,
-                                       pvCallbackCtx))
+            }
+
+            /* Otherwise find an empty callback context */
+            for (size_t uxCbIdx = 0U;
+                 (uxCbIdx < MQTT_AGENT_MAX_CALLBACKS) && (xStatus != MQTTSuccess);
+                 uxCbIdx++)
+            {
+                if (pxCtx->pxCallbacks[ uxCbIdx ].pxSubInfo == NULL)
                 {
                     uxTargetCbIdx = uxCbIdx;
                     xStatus = MQTTSuccess;
-                    break;
                 }
             }
         }
@@ -1325,8 +1709,12 @@ MQTTStatus_t MqttAgent_SubscribeSync(MQTTAgentHandle_t xHandle,
             {
                 char *pcDupTopicFilter = (char *)mmosal_malloc(xTopicFilterLen + 1);
 
-                if (pcDupTopicFilter == NULL)
+                pxNode = prvTrieLookup(pxCtx, pcTopicFilter, (uint16_t)xTopicFilterLen, true);
+
+                if ((pcDupTopicFilter == NULL) || (pxNode == NULL))
                 {
+                    mmosal_free(pcDupTopicFilter);
+                    prvTriePrune(pxCtx, pxNode);
                     xStatus = MQTTNoMemory;
                 }
                 else
@@ -1340,11 +1728,17 @@ MQTTStatus_t MqttAgent_SubscribeSync(MQTTAgentHandle_t xHandle,
                     pxCtx->pxSubscriptions[ uxTargetSubIdx ].topicFilterLength =
                         (uint16_t)xTopicFilterLen;
 
+                    pxNode->pxSubInfo = &(pxCtx->pxSubscriptions[ uxTargetSubIdx ]);
+                    pxCtx->pxSubNodes[ uxTargetSubIdx ] = pxNode;
+
                     pxCtx->uxSubscriptionCount++;
                 }
             }
 
-            pxCtx->pxSubscriptions[ uxTargetSubIdx ].qos = xRequestedQoS;
+            if (xStatus == MQTTSuccess)
+            {
+                pxCtx->pxSubscriptions[ uxTargetSubIdx ].qos = xRequestedQoS;
+            }
         }
 
         /*
@@ -1353,11 +1747,17 @@ MQTTStatus_t MqttAgent_SubscribeSync(MQTTAgentHandle_t xHandle,
         if ((xStatus == MQTTSuccess) &&
             (pxCtx->pxCallbacks[ uxTargetCbIdx ].pxSubInfo == NULL))
         {
+            SubTrieNode_t * const pxSubNode = pxCtx->pxSubNodes[ uxTargetSubIdx ];
+
             pxCtx->pxCallbacks[ uxTargetCbIdx ].pxSubInfo =
                 &(pxCtx->pxSubscriptions[ uxTargetSubIdx ]);
             pxCtx->pxCallbacks[ uxTargetCbIdx ].pxIncomingPublishCallback = pxCallback;
             pxCtx->pxCallbacks[ uxTargetCbIdx ].pvIncomingPublishCallbackContext = pvCallbackCtx;
 
+            /* Chain the callback onto its subscription for dispatch */
+            pxCtx->puxNextCb[ uxTargetCbIdx ] = pxSubNode->uxFirstCb;
+            pxSubNode->uxFirstCb = uxTargetCbIdx;
+
             /* Increment subscription reference count. */
             pxCtx->pulSubCbCount[ uxTargetSubIdx ]++;
 
@@ -1487,23 +1887,23 @@ MQTTStatus_t MqttAgent_UnSubscribeSync(MQTTAgentHandle_t xHandle,
         if (bLockSubCtx(pxCtx))
         {
             /* Find matching subscription context */
-            for (size_t uxIdx = 0U; uxIdx < MQTT_AGENT_MAX_SUBSCRIPTIONS; uxIdx++)
+            SubTrieNode_t *pxNode = prvTrieLookup(pxCtx,
+                                                  pcTopicFilter,
+                                                  (uint16_t)xTopicFilterLen,
+                                                  false);
+
+            if ((pxNode != NULL) && (pxNode->pxSubInfo != NULL))
             {
-                if ((xTopicFilterLen == pxCtx->pxSubscriptions[ uxIdx ].topicFilterLength) &&
-                    (strncmp(pxCtx->pxSubscriptions[ uxIdx ].pTopicFilter,
-                             pcTopicFilter,
-                             pxCtx->pxSubscriptions[ uxIdx ].topicFilterLength) == 0))
-                {
-                    ulCallbackCount = pxCtx->pulSubCbCount[ uxIdx ];
+                size_t uxIdx = pxNode->pxSubInfo - pxCtx->pxSubscriptions;
 
-                    if (ulCallbackCount > 0)
-                    {
-                        pxCtx->pulSubCbCount[ uxIdx ] = ulCallbackCount - 1;
-                    }
+                ulCallbackCount = pxCtx->pulSubCbCount[ uxIdx ];
 
-                    xStatus = MQTTSuccess;
-                    break;
+                if (ulCallbackCount > 0)
+                {
+                    pxCtx->pulSubCbCount[ uxIdx ] = ulCallbackCount - 1;
                 }
+
+                xStatus = MQTTSuccess;
             }
 
             (void)bUnlockSubCtx(pxCtx);
@@ -1541,29 +1941,28 @@ MQTTStatus_t MqttAgent_UnSubscribeSync(MQTTAgentHandle_t xHandle,
                 xStatus = MQTTBadParameter;
 
                 /* Find matching subscription context again */
-                for (size_t uxIdx = 0U; uxIdx < MQTT_AGENT_MAX_SUBSCRIPTIONS; uxIdx++)
+                SubTrieNode_t *pxNode = prvTrieLookup(pxCtx,
+                                                      pcTopicFilter,
+                                                      (uint16_t)xTopicFilterLen,
+                                                      false);
+
+                if ((pxNode != NULL) && (pxNode->pxSubInfo != NULL))
                 {
-                    if ((pxCtx->pulSubCbCount[ uxIdx ] == 0) &&
-                        (xTopicFilterLen == pxCtx->pxSubscriptions[ uxIdx ].topicFilterLength) &&
-                        (strncmp(pxCtx->pxSubscriptions[ uxIdx ].pTopicFilter,
-                                 pcTopicFilter,
-                                 pxCtx->pxSubscriptions[ uxIdx ].topicFilterLength) == 0))
-                    {
-                        uxSubInfoIdx = uxIdx;
-                        pxSubInfo = &(pxCtx->pxSubscriptions[ uxIdx ]);
-                        xStatus = MQTTSuccess;
-                        break;
-                    }
+                    pxSubInfo = pxNode->pxSubInfo;
+                    uxSubInfoIdx = pxSubInfo - pxCtx->pxSubscriptions;
+                    xStatus = MQTTSuccess;
                 }
 
                 if (xStatus == MQTTSuccess)
                 {
+                    size_t *puxLink = &(pxNode->uxFirstCb);
+
                     xStatus = MQTTNoDataAvailable;
 
-                    /* Find matching callback context, and remove it. */
-                    for (size_t uxIdx = 0U; uxIdx < MQTT_AGENT_MAX_CALLBACKS; uxIdx++)
+                    /* Find matching callback context, and unlink it from the subscription. */
+                    while (*puxLink < MQTT_AGENT_MAX_CALLBACKS)
                     {
-                        SubCallbackElement_t *pxCbCtx = &(pxCtx->pxCallbacks[ uxIdx ]);
+                        SubCallbackElement_t *pxCbCtx = &(pxCtx->pxCallbacks[ *puxLink ]);
 
                         if (prvMatchCbCtx(pxCbCtx, pxSubInfo, pxCallback, pvCallbackCtx))
                         {
@@ -1576,15 +1975,22 @@ MQTTStatus_t MqttAgent_UnSubscribeSync(MQTTAgentHandle_t xHandle,
 
                             pxCtx->uxCallbackCount--;
 
-                            prvCompressCallbackList(pxCtx->pxCallbacks, &(pxCtx->uxCallbackCount));
+                            *puxLink = pxCtx->puxNextCb[ *puxLink ];
                             break;
                         }
+
+                        puxLink = &(pxCtx->puxNextCb[ *puxLink ]);
                     }
 
                     if ((xStatus == MQTTSuccess) &&
                         (ulCallbackCount == 1) &&
                         (pxCtx->pulSubCbCount[ uxSubInfoIdx ] == 0))
                     {
+                        /* Remove the filter from the trie */
+                        pxNode->pxSubInfo = NULL;
+                        pxCtx->pxSubNodes[ uxSubInfoIdx ] = NULL;
+                        prvTriePrune(pxCtx, pxNode);
+
                         /* Free heap allocated topic filter */
                         mmosal_free((void *)pxSubInfo->pTopicFilter);
 
@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
+
 #include "slip.h"
 
 enum slip_special_chars
@@ -14,6 +16,45 @@ enum slip_special_chars
     SLIP_FRAME_ESC_ESC = 0xdd,
 };
 
+/** Replicate a byte into every byte lane of a 32 bit word. */
+#define SLIP_WORD_REPEAT(_c)   ((uint32_t)(_c) * 0x01010101ul)
+/** Evaluates to non-zero if and only if any byte lane of the given 32 bit word is zero. */
+#define SLIP_WORD_HAS_ZERO(_w) (((_w) - 0x01010101ul) & ~(_w) & 0x80808080ul)
+
+/**
+ * Find the first character that is special to SLIP (@c SLIP_FRAME_END or @c SLIP_FRAME_ESC) in
+ * the given data. The bulk of the data is scanned a word at a time.
+ *
+ * @param  data   The data to search.
+ * @param  length Length of @p data.
+ *
+ * @return        The offset of the first special character, or @p length if there is none.
+ */
+static size_t slip_find_special(const uint8_t *data, size_t length)
+{
+    size_t offset = 0;
+
+    while (offset + sizeof(uint32_t) <= length)
+    {
+        uint32_t word;
+
+        memcpy(&word, data + offset, sizeof(word));
+        if (SLIP_WORD_HAS_ZERO(word ^ SLIP_WORD_REPEAT(SLIP_FRAME_END)) ||
+            SLIP_WORD_HAS_ZERO(word ^ SLIP_WORD_REPEAT(SLIP_FRAME_ESC)))
+        {
+            break;
+        }
+        offset += sizeof(word);
+    }
+
+    while (offset < length && data[offset] != SLIP_FRAME_END && data[offset] != SLIP_FRAME_ESC)
+    {
+        offset++;
+    }
+
+    return offset;
+}
+
 static enum slip_rx_status slip_rx_append(struct slip_rx_state *state, uint8_t c)
 {
     if (state->length == state->buffer_length)
@@ -80,6 +121,51 @@ enum slip_rx_status slip_rx(struct slip_rx_state *state, uint8_t c)
     }
 }
 
+enum slip_rx_status slip_rx_buf(struct slip_rx_state *state,
+                                const uint8_t *data,
+                                size_t length,
+                                size_t *consumed)
+{
+    enum slip_rx_status status = SLIP_RX_IN_PROGRESS;
+    size_t offset = 0;
+
+    while (offset < length)
+    {
+        if (!state->escape)
+        {
+            size_t run = slip_find_special(data + offset, length - offset);
+
+            if (state->frame_started)
+            {
+                size_t space = state->buffer_length - state->length;
+                if (run > space)
+                {
+                    /* Fill the buffer; the next character will then hit the buffer limit. */
+                    run = space;
+                }
+                memcpy(state->buffer + state->length, data + offset, run);
+                state->length += run;
+            }
+            /* Else characters outside a frame are dropped on the floor. */
+
+            offset += run;
+            if (offset == length)
+            {
+                break;
+            }
+        }
+
+        status = slip_rx(state, data[offset++]);
+        if (status != SLIP_RX_IN_PROGRESS)
+        {
+            break;
+        }
+    }
+
+    *consumed = offset;
+    return status;
+}
+
 int slip_tx(slip_transport_tx_fn transport_tx_fn,
             void *transport_tx_arg,
             const uint8_t *packet,
@@ -122,3 +208,43 @@ int slip_tx(slip_transport_tx_fn transport_tx_fn,
 
     return ret;
 }
+
+int slip_tx_buf(slip_transport_tx_buf_fn transport_tx_fn,
+                void *transport_tx_arg,
+                const uint8_t *packet,
+                size_t packet_len)
+{
+    static const uint8_t frame_end = SLIP_FRAME_END;
+    static const uint8_t escaped_end[] = { SLIP_FRAME_ESC, SLIP_FRAME_ESC_END };
+    static const uint8_t escaped_esc[] = { SLIP_FRAME_ESC, SLIP_FRAME_ESC_ESC };
+    int ret;
+
+    ret = transport_tx_fn(&frame_end, sizeof(frame_end), transport_tx_arg);
+
+    while (ret == 0 && packet_len > 0)
+    {
+        size_t run = slip_find_special(packet, packet_len);
+        if (run > 0)
+        {
+            ret = transport_tx_fn(packet, run, transport_tx_arg);
+        }
+        else if (*packet == SLIP_FRAME_END)
+        {
+            run = 1;
+            ret = transport_tx_fn(escaped_end, sizeof(escaped_end), transport_tx_arg);
+        }
+        else
+        {
+            run = 1;
+            ret = transport_tx_fn(escaped_esc, sizeof(escaped_esc), transport_tx_arg);
+        }
+
+        packet += run;
+        packet_len -= run;
+    }
+
+    /* Always terminate the frame so that the receiver can resynchronise. */
+    transport_tx_fn(&frame_end, sizeof(frame_end), transport_tx_arg);
+
+    return ret;
+}
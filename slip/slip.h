@@ -100,6 +100,28 @@ enum slip_rx_status
  */
 enum slip_rx_status slip_rx(struct slip_rx_state *state, uint8_t c);
 
+/**
+ * Handle reception of a block of characters in a SLIP stream.
+ *
+ * This is equivalent to calling @ref slip_rx() for each character in turn, but runs of
+ * characters that do not require unescaping are copied into the receive buffer in bulk. Processing
+ * stops at the end of the first complete packet, so that the caller can consume the packet before
+ * calling again with the remaining data.
+ *
+ * @param  state    Current slip state. Will be updated by this function.
+ * @param  data     The received characters.
+ * @param  length   Number of characters in @p data.
+ * @param  consumed Will be set to the number of characters of @p data that were processed.
+ *
+ * @return          an appropriate value of @ref slip_rx_status. @c SLIP_RX_IN_PROGRESS is returned
+ *                  if all of @p data was consumed without completing a packet. Otherwise the
+ *                  status of the character at which processing stopped is returned.
+ */
+enum slip_rx_status slip_rx_buf(struct slip_rx_state *state,
+                                const uint8_t *data,
+                                size_t length,
+                                size_t *consumed);
+
 /**
  * Function to send a character on the SLIP transport.
  *
@@ -125,4 +147,33 @@ int slip_tx(slip_transport_tx_fn transport_tx_fn,
             const uint8_t *packet,
             size_t packet_len);
 
+/**
+ * Function to send a block of characters on the SLIP transport.
+ *
+ * @param  data   The characters to transmit.
+ * @param  length Number of characters in @p data.
+ * @param  arg    Opaque argument, as passed to @c slip_tx_buf().
+ *
+ * @return        0 on success, otherwise a negative error code.
+ */
+typedef int (*slip_transport_tx_buf_fn)(const uint8_t *data, size_t length, void *arg);
+
+/**
+ * Transmit a packet with SLIP framing, passing runs of characters to the transport in bulk.
+ *
+ * The output is identical to that of @ref slip_tx(), but the transport function is invoked once
+ * for each run of characters that do not require escaping rather than once per character.
+ *
+ * @param  transport_tx_fn  Function to invoke to send characters on the transport.
+ * @param  transport_tx_arg Argument to pass to @p transport_tx_fn.
+ * @param  packet           The packet to transmit.
+ * @param  packet_len       The length of the packet.
+ *
+ * @return                  0 on success, otherwise an error code as returned by @p transport_tx_fn.
+ */
+int slip_tx_buf(slip_transport_tx_buf_fn transport_tx_fn,
+                void *transport_tx_arg,
+                const uint8_t *packet,
+                size_t packet_len);
+
 /** @} */